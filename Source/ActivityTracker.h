@@ -0,0 +1,42 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * ActivityTracker — lets a stateful stage skip blocks once its input has gone silent and
+ * its own tail (reverb decay, limiter release, filter ring-out) has played out.
+ *
+ * Call run() once per block with whether the stage's input was silent, and process only
+ * when it returns true. The stage goes idle after tailSamples of continuous silent input
+ * and wakes on the first non-silent block. Trackers start idle.
+ */
+class ActivityTracker {
+public:
+    // Peak at or below this counts as silence (≈ −140 dBFS)
+    static constexpr float kSilence = 1.0e-7f;
+
+    void setTail(int tailSamples) noexcept { tail_ = juce::jmax(0, tailSamples); }
+    void reset() noexcept                  { quiet_ = tail_; }
+
+    bool run(bool inputSilent, int numSamples) noexcept
+    {
+        if (!inputSilent) {
+            quiet_ = 0;
+            return true;
+        }
+        if (quiet_ >= tail_)
+            return false;
+        quiet_ += numSamples;
+        return true;   // still ringing out
+    }
+
+    bool isIdle() const noexcept { return quiet_ >= tail_; }
+
+    static bool isSilent(const juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+    {
+        return buffer.getMagnitude(0, numSamples) <= kSilence;
+    }
+
+private:
+    int tail_  = 0;
+    int quiet_ = 0;
+};
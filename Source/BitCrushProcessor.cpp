@@ -1,24 +1,165 @@
 #include "BitCrushProcessor.h"
 #include <cmath>
 
+namespace {
+// Adding then subtracting 1.5·2^23 leaves x rounded to the nearest integer (ties to even)
+// for |x| < 2^22: the sum has no fractional bits left. Relies on strict IEEE evaluation
+// (no -ffast-math), which the build does not enable.
+constexpr float  kRoundMagic  = 12582912.f;
+constexpr double kRoundMagicD = 6755399441055744.0;   // 1.5·2^52, same trick in double
+
+// Level count for a bipolar signal in [-1, 1]: 2^floor(bits) - 1. Fractional bit depths
+// settle on the whole-bit staircase below them; only the glide between them is continuous.
+float levelsForBits(float bits)
+{
+    return std::exp2(std::floor(bits)) - 1.f;
+}
+
+inline float roundMagic(float x) noexcept
+{
+    return (x + kRoundMagic) - kRoundMagic;
+}
+} // namespace
+
+void BitCrushProcessor::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate_ = spec.sampleRate;
+    levels_.reset(spec.sampleRate, kRampMs / 1000.0);
+    levels_.setCurrentAndTargetValue(levelsForBits(bits_));
+    snapNext_ = true;
+    reset();
+}
+
+void BitCrushProcessor::reset()
+{
+    holdPhase_ = 1.f;   // first sample after a reset is always taken
+    for (int c = 0; c < kMaxChannels; ++c) {
+        held_[c]     = 0.f;
+        adaaPrev_[c] = 0.f;
+    }
+}
+
 void BitCrushProcessor::setBits(float bits)
 {
     bits_ = juce::jlimit(2.f, 16.f, bits);
+    if (snapNext_)
+        levels_.setCurrentAndTargetValue(levelsForBits(bits_));
+    else
+        levels_.setTargetValue(levelsForBits(bits_));
+}
+
+void BitCrushProcessor::setRate(float rate)
+{
+    rate = juce::jlimit(0.f, 1.f, rate);
+    if (rate <= 0.f) {
+        holdIncrement_ = 1.f;
+        return;
+    }
+    const double holdHz = kMaxHoldHz * std::pow(kMinHoldHz / kMaxHoldHz, static_cast<double>(rate));
+    holdIncrement_ = static_cast<float>(juce::jmin(1.0, holdHz / sampleRate_));
+}
+
+void BitCrushProcessor::setAntialiasing(bool enabled)
+{
+    if (enabled && !adaa_)
+        for (auto& p : adaaPrev_) p = 0.f;
+    adaa_ = enabled;
 }
 
 void BitCrushProcessor::process(juce::dsp::AudioBlock<float>& block)
 {
-    if (bits_ >= 15.99f) return;  // bypass at/near 16 bits
+    snapNext_ = false;
 
     const int N     = static_cast<int>(block.getNumSamples());
-    const int numCh = static_cast<int>(block.getNumChannels());
-    // Number of quantisation levels = 2^bits - 1 (for bipolar signal in [-1,1])
-    const float levels = std::pow(2.f, std::floor(bits_)) - 1.f;
-    const float inv    = 1.f / levels;
-
-    for (int c = 0; c < numCh; ++c) {
-        float* data = block.getChannelPointer(c);
-        for (int i = 0; i < N; ++i)
-            data[i] = std::round(data[i] * levels) * inv;
+    const int numCh = juce::jmin(kMaxChannels, static_cast<int>(block.getNumChannels()));
+    float* channels[kMaxChannels] {};
+    for (int c = 0; c < numCh; ++c)
+        channels[c] = block.getChannelPointer(static_cast<size_t>(c));
+
+    if (holdIncrement_ < 1.f)
+        processHold(channels, numCh, N);
+
+    // Bypass at/near 16 bits once any glide there has finished
+    if (bits_ >= 15.99f && !levels_.isSmoothing()) return;
+
+    for (int pos = 0; pos < N;) {
+        const bool ramping = levels_.isSmoothing();
+        const int  len     = ramping ? juce::jmin(kRampSubBlock, N - pos) : N - pos;
+        const float levels = ramping ? levels_.skip(len) : levels_.getTargetValue();
+
+        for (int c = 0; c < numCh; ++c) {
+            if (adaa_) processAdaa(channels[c] + pos, len, levels, c);
+            else       quantise(channels[c] + pos, len, levels);
+        }
+        pos += len;
     }
 }
+
+void BitCrushProcessor::processHold(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    float phase = holdPhase_;
+    for (int c = 0; c < numChannels; ++c) {
+        float* d    = channels[c];
+        float  held = held_[c];
+        phase = holdPhase_;
+        for (int i = 0; i < numSamples; ++i) {
+            if (phase >= 1.f) {
+                phase -= 1.f;
+                held = d[i];
+            }
+            phase += holdIncrement_;
+            d[i] = held;
+        }
+        held_[c] = held;
+    }
+    holdPhase_ = phase;
+}
+
+// First-order ADAA of Q(x) = round(x·L)/L. Its antiderivative is F(x) = Q(x)·x - Q(x)²/2,
+// and the output is the average of Q over the segment between consecutive inputs:
+// (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]), falling back to Q at the midpoint when the two
+// inputs are too close for the division to be well conditioned.
+void BitCrushProcessor::processAdaa(float* data, int numSamples, float levels, int channel) noexcept
+{
+    // Double precision: the difference quotient cancels badly in float at high bit depths
+    const double L = levels, inv = 1.0 / L;
+    auto q  = [&](double x) { return ((x * L + kRoundMagicD) - kRoundMagicD) * inv; };
+    auto ad = [&](double x) { const double y = q(x); return y * x - 0.5 * y * y; };
+
+    double x1 = adaaPrev_[channel];
+    double f1 = ad(x1);
+    for (int i = 0; i < numSamples; ++i) {
+        const double x0 = data[i];
+        const double dx = x0 - x1;
+        const double f0 = ad(x0);
+        data[i] = static_cast<float>(std::abs(dx) > 1.0e-9 ? (f0 - f1) / dx : q(0.5 * (x0 + x1)));
+        x1 = x0;
+        f1 = f0;
+    }
+    adaaPrev_[channel] = static_cast<float>(x1);
+}
+
+void BitCrushProcessor::quantise(float* data, int numSamples, float levels) noexcept
+{
+    const float inv = 1.f / levels;
+    int i = 0;
+
+#if JUCE_USE_SIMD
+    using Reg = juce::dsp::SIMDRegister<float>;
+    constexpr int W = static_cast<int>(Reg::SIMDNumElements);
+
+    // Scalar head up to the first aligned sample, then whole registers
+    for (; i < numSamples && !Reg::isSIMDAligned(data + i); ++i)
+        data[i] = roundMagic(data[i] * levels) * inv;
+
+    const Reg vLevels = Reg::expand(levels), vInv = Reg::expand(inv), vMagic = Reg::expand(kRoundMagic);
+    for (; i + W <= numSamples; i += W) {
+        Reg x = Reg::fromRawArray(data + i);
+        x = ((x * vLevels + vMagic) - vMagic) * vInv;
+        x.copyToRawArray(data + i);
+    }
+#endif
+
+    for (; i < numSamples; ++i)
+        data[i] = roundMagic(data[i] * levels) * inv;
+}
@@ -1,12 +1,53 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
 
+/**
+ * BitCrushProcessor — sample-and-hold rate reduction followed by a bit-depth quantiser.
+ *
+ * The quantiser rounds with the float "magic number" trick (adding and subtracting
+ * 1.5·2^23), so the body of the loop is plain SIMD add/mul with no per-sample calls.
+ * Bit-depth changes glide geometrically in the level count (linear in bits) and are
+ * applied per kRampSubBlock chunk while ramping. Optional first-order ADAA
+ * (antiderivative antialiasing) replaces the hard staircase with its band-limited
+ * average, which takes the worst of the aliasing off high bit reductions.
+ */
 class BitCrushProcessor {
 public:
-    // bits: 2.0 .. 16.0; at 16 the processor bypasses completely
+    static constexpr int    kMaxChannels  = 2;
+    static constexpr int    kRampSubBlock = 16;
+    static constexpr double kRampMs       = 20.0;
+    // Hold rate range for setRate(): rate → kMaxHoldHz · (kMinHoldHz / kMaxHoldHz)^rate
+    static constexpr double kMaxHoldHz    = 24000.0;
+    static constexpr double kMinHoldHz    = 1000.0;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    // bits: 2.0 .. 16.0, quantised to floor(bits) once any glide settles; at 16 the
+    // quantiser bypasses completely
     void setBits(float bits);
+    // rate in [0, 1]: 0 = no rate reduction, 1 = held at kMinHoldHz
+    void setRate(float rate);
+    void setAntialiasing(bool enabled);
     void process(juce::dsp::AudioBlock<float>& block);
 
+    // Rounds data[i]·levels to the nearest integer and scales back by 1/levels in place
+    // (round half to even; |data[i]·levels| must stay below 2^22). Exposed for tests.
+    static void quantise(float* data, int numSamples, float levels) noexcept;
+
 private:
-    float bits_ = 16.f;
+    void processHold(float* const* channels, int numChannels, int numSamples) noexcept;
+    void processAdaa(float* data, int numSamples, float levels, int channel) noexcept;
+
+    double sampleRate_ = 44100.0;
+    float  bits_       = 16.f;
+    bool   snapNext_   = true;   // bits set before the first process() apply without a ramp
+    bool   adaa_       = false;
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> levels_;
+
+    float holdIncrement_ = 1.f;   // hold-clock advance per sample; ≥ 1 disables the hold
+    float holdPhase_     = 1.f;
+    float held_[kMaxChannels]    {};
+    float adaaPrev_[kMaxChannels] {};   // previous input to the ADAA quantiser
 };
@@ -3,12 +3,13 @@
 #include <algorithm>
 #include <limits>
 
-void ConcatenativeMatcher::prepare(int frameSize)
+void ConcatenativeMatcher::prepare(int frameSize, int maxFrames)
 {
     frameSize_ = frameSize;
     outputBufL_.assign(frameSize, 0.f);
     outputBufR_.assign(frameSize, 0.f);
-    candidates_.reserve(512);  // enough for ~5s corpus at 44.1kHz; avoids alloc on audio thread
+    candidates_.clear();
+    candidates_.reserve(static_cast<size_t>(std::max(1, maxFrames)));  // every frame can be a candidate
 }
 
 void ConcatenativeMatcher::setWeights(float zcr, float rms, float sc, float st)
@@ -48,18 +49,25 @@ bool ConcatenativeMatcher::match(const Features& controlFeatures,
     }
 
     // If rand > 0, collect candidates within (1 + rand) * minDist and pick one randomly
-    int matchIdx = bestIdx;
+    int   matchIdx   = bestIdx;
+    float matchDist  = minDist;
+    int   candidates = 1;
     if (rand_ > 0.f && corpus.size() > 1) {
         float threshold = (1.f + rand_) * minDist + 1e-6f;
         candidates_.clear();
         for (int i = 0; i < corpus.size(); ++i)
             if (distance(controlFeatures, corpus.getFrame(i).features) <= threshold)
                 candidates_.push_back(i);
-        if (!candidates_.empty())
-            matchIdx = candidates_[random_.nextInt(static_cast<int>(candidates_.size()))];
+        if (!candidates_.empty()) {
+            matchIdx   = candidates_[random_.nextInt(static_cast<int>(candidates_.size()))];
+            matchDist  = distance(controlFeatures, corpus.getFrame(matchIdx).features);
+            candidates = static_cast<int>(candidates_.size());
+        }
     }
 
-    lastMatchedIndex_ = matchIdx;
+    lastMatchedIndex_   = matchIdx;
+    lastDistance_       = matchDist;
+    lastCandidateCount_ = candidates;
     const auto& frame = corpus.getFrame(matchIdx);
     std::copy(frame.audioL.begin(), frame.audioL.end(), outputBufL_.begin());
     std::copy(frame.audioR.begin(), frame.audioR.end(), outputBufR_.begin());
@@ -6,10 +6,14 @@
 
 class ConcatenativeMatcher {
 public:
-    void prepare(int frameSize);
+    // maxFrames bounds the corpus size, so the candidate list never grows on the audio thread.
+    void prepare(int frameSize, int maxFrames = 512);
     void setWeights(float zcr, float rms, float sc, float st);
     // rand in [0,1]: 0 = best match, higher = more random selection among near-matches
     void setRand(float rand);
+    // Reseeds the random pick among near-matches, so a given seed and input always choose
+    // the same frames. Unseeded matchers start from a time-based seed.
+    void setSeed(juce::int64 seed) noexcept { random_.setSeed(seed); }
 
     // Fills outL and outR with the matched frame's stereo audio (frameSize samples each).
     // Returns false if corpus is empty; outL and outR are unchanged.
@@ -19,7 +23,11 @@ public:
     // Exposed for testing
     float distance(const Features& a, const Features& b) const;
 
-    int getLastMatchedIndex() const noexcept { return lastMatchedIndex_; }
+    int   getLastMatchedIndex()    const noexcept { return lastMatchedIndex_; }
+    // Distance from the control frame to the chosen frame, and how many frames were
+    // eligible for the random pick (1 when rand = 0). Valid after a successful match().
+    float getLastDistance()        const noexcept { return lastDistance_; }
+    int   getLastCandidateCount()  const noexcept { return lastCandidateCount_; }
 
 private:
     int frameSize_ = 1024;
@@ -31,5 +39,7 @@ private:
     std::vector<int>   candidates_;   // pre-allocated, reused each block to avoid audio-thread heap alloc
 
     juce::Random random_;
-    int lastMatchedIndex_ = -1;
+    int   lastMatchedIndex_   = -1;
+    float lastDistance_       = 0.f;
+    int   lastCandidateCount_ = 0;
 };
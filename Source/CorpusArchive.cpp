@@ -0,0 +1,222 @@
+#include "CorpusArchive.h"
+#include <cstring>
+
+namespace {
+constexpr char     kMagic[4]     = { 'S', 'T', 'C', 'A' };
+constexpr int      kMaxFrameSize = 1 << 16;
+constexpr uint64_t kMaxRawBytes  = 1u << 30;
+
+// Byte-plane shuffle: n floats -> 4 planes of n bytes, and back
+void shuffle(const float* src, size_t n, uint8_t* dst)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(src);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t b = 0; b < 4; ++b)
+            dst[b * n + i] = bytes[i * 4 + b];
+}
+
+void unshuffle(const uint8_t* src, size_t n, float* dst)
+{
+    auto* bytes = reinterpret_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t b = 0; b < 4; ++b)
+            bytes[i * 4 + b] = src[b * n + i];
+}
+} // namespace
+
+CorpusArchive::CorpusArchive(CaptureFn capture, RestoredFn restored)
+    : juce::Thread("Stitcher corpus archive"),
+      capture_(std::move(capture)), restored_(std::move(restored))
+{
+    startThread(juce::Thread::Priority::background);
+}
+
+CorpusArchive::~CorpusArchive()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(4000);   // a capture may be waiting for the audio thread to apply freeze
+}
+
+void CorpusArchive::requestEncode()
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        if (!encodeRequested_) {
+            encodeRequested_ = true;
+            ++busy_;
+        }
+    }
+    notify();
+}
+
+void CorpusArchive::requestDecode(juce::MemoryBlock chunk)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        decodeChunk_ = std::move(chunk);
+        if (!decodeRequested_) {
+            decodeRequested_ = true;
+            ++busy_;
+        }
+    }
+    notify();
+}
+
+void CorpusArchive::clearEncoded()
+{
+    const juce::ScopedLock sl(lock_);
+    encoded_.reset();
+    hasEncoded_ = false;
+    ++generation_;
+}
+
+juce::MemoryBlock CorpusArchive::getEncoded(uint64_t key)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        if (hasEncoded_) {
+            if (encodedKey_ != key)
+                requestEncode();   // stale; the next save gets the fresh chunk
+            return encoded_;
+        }
+    }
+    if (!encodeNow(false))
+        return {};
+    // Whatever was captured just now is the newest corpus, even if it moved past `key`
+    const juce::ScopedLock sl(lock_);
+    return encoded_;
+}
+
+bool CorpusArchive::waitUntilIdle(int timeoutMs) const
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+    while (busy_.load() > 0) {
+        if (juce::Time::getMillisecondCounter() >= deadline)
+            return false;
+        juce::Thread::sleep(1);
+    }
+    return true;
+}
+
+bool CorpusArchive::encodeNow(bool mayWait)
+{
+    uint64_t generation;
+    {
+        const juce::ScopedLock sl(lock_);
+        generation = generation_;
+    }
+
+    CorpusImage image;
+    uint64_t    key = 0;
+    if (!capture_(image, key, mayWait))
+        return false;
+    auto chunk = encode(image);
+
+    const juce::ScopedLock sl(lock_);
+    if (generation != generation_)
+        return false;
+    encoded_    = std::move(chunk);
+    encodedKey_ = key;
+    hasEncoded_ = true;
+    return true;
+}
+
+void CorpusArchive::run()
+{
+    while (!threadShouldExit()) {
+        wait(-1);
+
+        juce::MemoryBlock chunk;
+        bool decodeDue = false, encodeDue = false;
+        {
+            const juce::ScopedLock sl(lock_);
+            std::swap(decodeDue, decodeRequested_);
+            std::swap(encodeDue, encodeRequested_);
+            if (decodeDue)
+                chunk = std::move(decodeChunk_);
+        }
+
+        if (decodeDue) {
+            if (auto image = decode(chunk.getData(), chunk.getSize()))
+                restored_(std::move(image));
+            --busy_;
+        }
+        if (encodeDue) {
+            encodeNow(true);
+            --busy_;
+        }
+    }
+}
+
+juce::MemoryBlock CorpusArchive::encode(const CorpusImage& image)
+{
+    const size_t numFrames  = static_cast<size_t>(image.size());
+    const size_t numSamples = numFrames * static_cast<size_t>(image.frameSize);
+    const size_t numFloats  = 4 * numFrames + 2 * numSamples;
+
+    std::vector<float> floats;
+    floats.reserve(numFloats);
+    for (auto member : { &Features::zcr, &Features::rms, &Features::sc, &Features::st })
+        for (const auto& f : image.features)
+            floats.push_back(f.*member);
+    floats.insert(floats.end(), image.audioL.begin(), image.audioL.begin() + static_cast<std::ptrdiff_t>(numSamples));
+    floats.insert(floats.end(), image.audioR.begin(), image.audioR.begin() + static_cast<std::ptrdiff_t>(numSamples));
+
+    std::vector<uint8_t> planes(numFloats * 4);
+    shuffle(floats.data(), numFloats, planes.data());
+
+    juce::MemoryBlock chunk;
+    {
+        juce::MemoryOutputStream out(chunk, false);
+        out.write(kMagic, sizeof(kMagic));
+        out.writeInt(kVersion);
+        out.writeInt(image.frameSize);
+        out.writeInt(static_cast<int>(numFrames));
+        out.writeInt(static_cast<int>(planes.size()));
+        juce::GZIPCompressorOutputStream zip(out, 6);
+        zip.write(planes.data(), planes.size());
+    }
+    return chunk;
+}
+
+std::unique_ptr<CorpusImage> CorpusArchive::decode(const void* data, size_t size)
+{
+    juce::MemoryInputStream in(data, size, false);
+    char magic[4] {};
+    if (in.read(magic, 4) != 4 || std::memcmp(magic, kMagic, 4) != 0)
+        return nullptr;
+
+    const int version   = in.readInt();
+    const int frameSize = in.readInt();
+    const int numFrames = in.readInt();
+    const auto rawBytes = static_cast<uint64_t>(static_cast<juce::uint32>(in.readInt()));
+    if (version < 1 || version > kVersion || frameSize <= 0 || frameSize > kMaxFrameSize || numFrames < 0)
+        return nullptr;
+
+    const auto numSamples = static_cast<uint64_t>(numFrames) * static_cast<uint64_t>(frameSize);
+    const auto numFloats  = 4 * static_cast<uint64_t>(numFrames) + 2 * numSamples;
+    if (rawBytes != numFloats * 4 || rawBytes > kMaxRawBytes)
+        return nullptr;
+
+    std::vector<uint8_t> planes(static_cast<size_t>(rawBytes));
+    juce::GZIPDecompressorInputStream zip(&in, false, juce::GZIPDecompressorInputStream::zlibFormat,
+                                          static_cast<juce::int64>(rawBytes));
+    if (zip.read(planes.data(), static_cast<int>(rawBytes)) != static_cast<int>(rawBytes))
+        return nullptr;
+
+    std::vector<float> floats(static_cast<size_t>(numFloats));
+    unshuffle(planes.data(), floats.size(), floats.data());
+
+    auto image = std::make_unique<CorpusImage>();
+    image->frameSize = frameSize;
+    image->features.resize(static_cast<size_t>(numFrames));
+    const float* src = floats.data();
+    for (auto member : { &Features::zcr, &Features::rms, &Features::sc, &Features::st })
+        for (auto& f : image->features)
+            f.*member = *src++;
+    image->audioL.assign(src, src + numSamples);
+    src += numSamples;
+    image->audioR.assign(src, src + numSamples);
+    return image;
+}
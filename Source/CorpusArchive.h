@@ -0,0 +1,74 @@
+#pragma once
+#include "CorpusStore.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * CorpusArchive — lossless binary form of a corpus for the plugin state, and the
+ * background thread that encodes and decodes it so neither happens on the host's
+ * save or load call.
+ *
+ * Chunk layout (little-endian):
+ *   "STCA" | uint32 version (1) | int32 frameSize | int32 numFrames | uint32 rawBytes
+ *   | zlib( zcr[] rms[] sc[] st[] audioL[] audioR[] )
+ * The float arrays are byte-shuffled (all first bytes, then all second bytes, ...)
+ * before deflate, so the slowly varying sign/exponent bytes sit next to each other
+ * instead of between mantissa noise.
+ *
+ * Thread model: the callbacks run on the archive's own thread (CaptureFn also, with
+ * mayWait false, on a getEncoded() caller that finds no chunk at all); every public
+ * method may be called from any thread except the audio thread.
+ */
+class CorpusArchive : private juce::Thread {
+public:
+    static constexpr int kVersion = 1;
+
+    // Fills `out` with the corpus and returns a key identifying its contents; false if
+    // the corpus cannot be read right now (not frozen, or being written). Only when
+    // mayWait is set may it block to let the audio thread catch up.
+    using CaptureFn  = std::function<bool(CorpusImage& out, uint64_t& key, bool mayWait)>;
+    // Receives a decoded chunk (never null).
+    using RestoredFn = std::function<void(std::unique_ptr<CorpusImage>)>;
+
+    CorpusArchive(CaptureFn capture, RestoredFn restored);
+    ~CorpusArchive() override;
+
+    // Captures and encodes the corpus in the background, replacing the cached chunk.
+    void requestEncode();
+    // The cached chunk, without waiting; if it was not made from the corpus `key`
+    // identifies, a fresh encode is queued for the next call. Only when nothing has been
+    // encoded yet does it capture and encode on the calling thread, without blocking on
+    // the archive thread or the audio thread. Empty if the corpus cannot be captured.
+    juce::MemoryBlock getEncoded(uint64_t key);
+    void clearEncoded();
+
+    // Decodes `chunk` in the background and hands the result to the RestoredFn. Invalid
+    // chunks are dropped.
+    void requestDecode(juce::MemoryBlock chunk);
+
+    // True once no request is queued or running (tests, offline tools).
+    bool waitUntilIdle(int timeoutMs) const;
+
+    static juce::MemoryBlock            encode(const CorpusImage& image);
+    static std::unique_ptr<CorpusImage> decode(const void* data, size_t size);
+
+private:
+    void run() override;
+    bool encodeNow(bool mayWait);
+
+    CaptureFn  capture_;
+    RestoredFn restored_;
+
+    juce::CriticalSection lock_;   // guards everything below
+    juce::MemoryBlock     encoded_;
+    uint64_t              encodedKey_ = 0;
+    bool                  hasEncoded_ = false;
+    bool                  encodeRequested_ = false;
+    juce::MemoryBlock     decodeChunk_;
+    bool                  decodeRequested_ = false;
+    uint64_t              generation_ = 0;   // bumped by clearEncoded(); stale encodes are dropped
+
+    std::atomic<int> busy_ { 0 };   // requests queued or running
+};
@@ -0,0 +1,85 @@
+#include "CorpusSnapshot.h"
+#include <algorithm>
+#include <thread>
+
+CorpusFeatureTable::CorpusFeatureTable(int maxFrames)
+    : maxFrames_(std::max(1, maxFrames)),
+      slots_(std::make_unique<Slot[]>(static_cast<size_t>(maxFrames_)))
+{
+}
+
+void CorpusFeatureTable::publish(int slot, const Features& features,
+                                 int writeIndex, int count) noexcept
+{
+    const uint64_t s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& dst = slots_[static_cast<size_t>(slot)];
+    dst.zcr.store(features.zcr, std::memory_order_relaxed);
+    dst.rms.store(features.rms, std::memory_order_relaxed);
+    dst.sc .store(features.sc,  std::memory_order_relaxed);
+    dst.st .store(features.st,  std::memory_order_relaxed);
+    writeIndex_.store(writeIndex, std::memory_order_relaxed);
+    count_     .store(count,      std::memory_order_relaxed);
+
+    seq_.store(s + 2, std::memory_order_release);
+}
+
+bool CorpusFeatureTable::readCursor(CorpusCursor& out, int maxRetries) const noexcept
+{
+    for (int attempt = 0; attempt < maxRetries; ++attempt) {
+        const uint64_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int wi = writeIndex_.load(std::memory_order_relaxed);
+        const int n  = count_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != s0)
+            continue;
+
+        out.count      = n;
+        out.maxFrames  = maxFrames_;
+        out.writeIndex = wi;
+        out.version    = s0 / 2;
+        return true;
+    }
+    return false;
+}
+
+bool CorpusFeatureTable::read(CorpusSnapshot& out, int maxRetries) const
+{
+    for (int attempt = 0; attempt < maxRetries; ++attempt) {
+        const uint64_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int wi = writeIndex_.load(std::memory_order_relaxed);
+        const int n  = count_.load(std::memory_order_relaxed);
+
+        out.features.resize(static_cast<size_t>(n));
+        const int oldest = (wi - n + maxFrames_) % maxFrames_;
+        for (int i = 0; i < n; ++i) {
+            const auto& src = slots_[static_cast<size_t>((oldest + i) % maxFrames_)];
+            auto& f = out.features[static_cast<size_t>(i)];
+            f.zcr = src.zcr.load(std::memory_order_relaxed);
+            f.rms = src.rms.load(std::memory_order_relaxed);
+            f.sc  = src.sc .load(std::memory_order_relaxed);
+            f.st  = src.st .load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != s0)
+            continue;
+
+        out.cursor.count      = n;
+        out.cursor.maxFrames  = maxFrames_;
+        out.cursor.writeIndex = wi;
+        out.cursor.version    = s0 / 2;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "FeatureExtractor.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Write cursor of the corpus ring. Cheap to read on every UI tick.
+struct CorpusCursor {
+    int      count      = 0;  // valid frames (0 .. maxFrames)
+    int      maxFrames  = 0;  // ring capacity
+    int      writeIndex = 0;  // physical slot the next push will write
+    uint64_t version    = 0;  // completed pushes since prepare(); unchanged = nothing new
+};
+
+// Plain copy of the corpus feature table, safe to hold on any thread.
+struct CorpusSnapshot {
+    CorpusCursor          cursor;
+    std::vector<Features> features;  // logical order: [0] = oldest, [count-1] = newest
+};
+
+/**
+ * CorpusFeatureTable — seqlock-published mirror of the corpus features and write cursor.
+ *
+ * Thread model:
+ *   publish()              — audio thread only (single writer); wait-free, no allocation
+ *   readCursor(), read()   — any thread; never blocks the writer, retries on a torn read
+ *
+ * Each publish() touches one slot, so a reader copying the whole table only retries when
+ * a frame boundary lands inside its copy.
+ */
+class CorpusFeatureTable {
+public:
+    explicit CorpusFeatureTable(int maxFrames);
+
+    // Audio thread: record the features written to physical slot `slot` and the new cursor.
+    void publish(int slot, const Features& features, int writeIndex, int count) noexcept;
+
+    // Any thread: consistent cursor. Returns false only if the writer kept it busy for
+    // every retry (practically never — a publish is a handful of stores).
+    bool readCursor(CorpusCursor& out, int maxRetries = 64) const noexcept;
+
+    // Any thread: consistent cursor + features in logical order. Allocates into `out`.
+    bool read(CorpusSnapshot& out, int maxRetries = 64) const;
+
+    int capacity() const noexcept { return maxFrames_; }
+
+private:
+    struct Slot {
+        std::atomic<float> zcr { 0.f };
+        std::atomic<float> rms { 0.f };
+        std::atomic<float> sc  { 0.f };
+        std::atomic<float> st  { 0.f };
+    };
+
+    const int                maxFrames_;
+    std::unique_ptr<Slot[]>  slots_;
+    std::atomic<uint64_t>    seq_        { 0 };  // odd while a publish is in flight
+    std::atomic<int>         writeIndex_ { 0 };
+    std::atomic<int>         count_      { 0 };
+};
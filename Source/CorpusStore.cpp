@@ -14,20 +14,44 @@ void CorpusStore::prepare(int frameSize, int maxFrames)
     writeIndex_ = 0;
     count_      = 0;
     frozen_     = false;
+    pushCount_  = 0;
+    writeSeq_.store(writeSeq_.load(std::memory_order_relaxed) + 2, std::memory_order_release);
+
+    auto table = std::make_shared<CorpusFeatureTable>(maxFrames);
+    tableRaw_  = table.get();
+    std::atomic_store(&table_, std::move(table));
 }
 
 void CorpusStore::push(const float* audioL, const float* audioR, const Features& features)
 {
-    if (frozen_) return;
+    if (frozen_.load(std::memory_order_relaxed)) return;
+    write(audioL, audioR, features);
+}
+
+void CorpusStore::restore(const float* audioL, const float* audioR, const Features& features)
+{
+    write(audioL, audioR, features);
+}
+
+void CorpusStore::write(const float* audioL, const float* audioR, const Features& features)
+{
+    const uint64_t seq = writeSeq_.load(std::memory_order_relaxed);
+    writeSeq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
     auto& slot = frames_[writeIndex_];
     std::copy(audioL, audioL + frameSize_, slot.audioL.begin());
     std::copy(audioR, audioR + frameSize_, slot.audioR.begin());
     slot.features = features;
+    slot.serial   = pushCount_++;
 
+    const int written = writeIndex_;
     writeIndex_ = (writeIndex_ + 1) % maxFrames_;
     if (count_ < maxFrames_)
         ++count_;
+
+    writeSeq_.store(seq + 2, std::memory_order_release);
+    tableRaw_->publish(written, features, writeIndex_, count_);
 }
 
 int CorpusStore::size() const { return count_; }
@@ -46,4 +70,45 @@ const CorpusFrame& CorpusStore::getFrame(int index) const
     return frames_[slot];
 }
 
-void CorpusStore::setFrozen(bool frozen) { frozen_ = frozen; }
+void CorpusStore::setFrozen(bool frozen) { frozen_.store(frozen, std::memory_order_release); }
+
+bool CorpusStore::copyFrozen(CorpusImage& out, uint64_t& version) const
+{
+    const uint64_t seq = writeSeq_.load(std::memory_order_acquire);
+    if ((seq & 1) != 0 || !isFrozen())
+        return false;
+
+    // count_ and writeIndex_ only change inside write(), so the seqlock covers them too
+    const int count  = count_;
+    const int oldest = (writeIndex_ - count + maxFrames_) % juce::jmax(1, maxFrames_);
+    const auto n     = static_cast<size_t>(count) * static_cast<size_t>(frameSize_);
+    out.frameSize = frameSize_;
+    out.audioL.resize(n);
+    out.audioR.resize(n);
+    out.features.resize(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const auto& f = frames_[static_cast<size_t>((oldest + i) % maxFrames_)];
+        const auto  o = static_cast<size_t>(i) * static_cast<size_t>(frameSize_);
+        std::copy(f.audioL.begin(), f.audioL.end(), out.audioL.begin() + static_cast<std::ptrdiff_t>(o));
+        std::copy(f.audioR.begin(), f.audioR.end(), out.audioR.begin() + static_cast<std::ptrdiff_t>(o));
+        out.features[static_cast<size_t>(i)] = f.features;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (writeSeq_.load(std::memory_order_relaxed) != seq)
+        return false;
+    version = seq;
+    return true;
+}
+
+bool CorpusStore::readCursor(CorpusCursor& out) const
+{
+    const auto table = std::atomic_load(&table_);
+    return table != nullptr && table->readCursor(out);
+}
+
+bool CorpusStore::readSnapshot(CorpusSnapshot& out) const
+{
+    const auto table = std::atomic_load(&table_);
+    return table != nullptr && table->read(out);
+}
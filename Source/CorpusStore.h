@@ -1,11 +1,26 @@
 #pragma once
 #include "FeatureExtractor.h"
+#include "CorpusSnapshot.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 struct CorpusFrame {
     std::vector<float> audioL;
     std::vector<float> audioR;
     Features features;
+    uint64_t serial = 0;   // push count since prepare(); identifies this slot's contents
+};
+
+// Flat copy of a corpus, oldest frame first. Audio is frame-major: frame i occupies
+// [i * frameSize, (i + 1) * frameSize) of audioL / audioR.
+struct CorpusImage {
+    int frameSize = 0;
+    std::vector<float>    audioL, audioR;
+    std::vector<Features> features;
+
+    int size() const { return static_cast<int>(features.size()); }
 };
 
 class CorpusStore {
@@ -16,6 +31,9 @@ public:
     // Adds a frame (no-op if frozen)
     void push(const float* audioL, const float* audioR, const Features& features);
 
+    // Adds a frame even while frozen: streams a saved corpus back in (audio thread).
+    void restore(const float* audioL, const float* audioR, const Features& features);
+
     // Number of valid frames currently stored (0 to maxFrames)
     int size() const;
 
@@ -27,6 +45,21 @@ public:
     const CorpusFrame& getFrame(int index) const;
 
     void setFrozen(bool frozen);
+    bool isFrozen() const { return frozen_.load(std::memory_order_acquire); }
+
+    int getFrameSize() const { return frameSize_; }
+    int getCapacity() const  { return maxFrames_; }
+
+    // Any non-audio thread, serialised against prepare() by the caller. Copies the corpus
+    // if it is frozen and no frame is written during the copy; `version` then identifies
+    // the contents (it changes with every write and every prepare()).
+    bool copyFrozen(CorpusImage& out, uint64_t& version) const;
+    uint64_t getContentVersion() const { return writeSeq_.load(std::memory_order_acquire); }
+
+    // Any thread: lock-free views of the feature table for UI / background consumers.
+    // Both return false before the first prepare().
+    bool readCursor(CorpusCursor& out) const;
+    bool readSnapshot(CorpusSnapshot& out) const;
 
 private:
     std::vector<CorpusFrame> frames_;
@@ -34,5 +67,17 @@ private:
     int count_      = 0;  // valid frames
     int maxFrames_  = 0;
     int frameSize_  = 0;
-    bool frozen_    = false;
+    std::atomic<bool> frozen_ { false };
+    uint64_t pushCount_ = 0;
+
+    // Seqlock over the frame audio for copyFrozen(): odd while a frame is being written.
+    // Never reset, so a version from before a prepare() cannot match one after it.
+    std::atomic<uint64_t> writeSeq_ { 0 };
+
+    void write(const float* audioL, const float* audioR, const Features& features);
+
+    // Replaced (never resized) in prepare(); readers hold their own reference so a
+    // concurrent prepare() cannot pull the table out from under them.
+    std::shared_ptr<CorpusFeatureTable> table_;
+    CorpusFeatureTable*                 tableRaw_ = nullptr;  // audio-thread alias of table_
 };
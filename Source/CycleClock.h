@@ -0,0 +1,33 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+#endif
+
+/**
+ * CycleClock — raw timestamp counter, cheap enough to read around every processing
+ * stage (StageProfiler) and every call in the benchmarks.
+ *
+ * x86: the TSC (constant-rate on anything recent, so "cycles" at the nominal clock).
+ * AArch64: the virtual counter, which ticks at a fixed lower frequency (CNTFRQ) — compare
+ * numbers within one machine only. Elsewhere: steady_clock nanoseconds.
+ */
+struct CycleClock {
+    static inline uint64_t now() noexcept
+    {
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+};
@@ -1,38 +1,243 @@
 #include "EQProcessor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double kLowFreq  = 200.0;
+constexpr double kMidFreq  = 1000.0;
+constexpr double kHighFreq = 6000.0;
+constexpr double kQ        = 0.707;
+
+BiquadCoeffs normalise(double b0, double b1, double b2, double a0, double a1, double a2) noexcept
+{
+    const double inv = 1.0 / a0;
+    return { static_cast<float>(b0 * inv), static_cast<float>(b1 * inv), static_cast<float>(b2 * inv),
+             static_cast<float>(a1 * inv), static_cast<float>(a2 * inv) };
+}
+} // namespace
+
+// ── Closed-form designs (RBJ Audio EQ Cookbook, A = 10^(dB/40)) ────────────
+
+BiquadCoeffs EQProcessor::makeLowShelf(double sampleRate, double freq, double q, float gainDb) noexcept
+{
+    const double A     = std::pow(10.0, static_cast<double>(gainDb) / 40.0);
+    const double w0    = juce::MathConstants<double>::twoPi * freq / sampleRate;
+    const double cosw  = std::cos(w0);
+    const double beta  = std::sin(w0) * std::sqrt(A) / q;   // 2·√A·alpha
+    return normalise(      A * ((A + 1.0) - (A - 1.0) * cosw + beta),
+                     2.0 * A * ((A - 1.0) - (A + 1.0) * cosw),
+                           A * ((A + 1.0) - (A - 1.0) * cosw - beta),
+                                (A + 1.0) + (A - 1.0) * cosw + beta,
+                        -2.0 * ((A - 1.0) + (A + 1.0) * cosw),
+                                (A + 1.0) + (A - 1.0) * cosw - beta);
+}
+
+BiquadCoeffs EQProcessor::makePeak(double sampleRate, double freq, double q, float gainDb) noexcept
+{
+    const double A     = std::pow(10.0, static_cast<double>(gainDb) / 40.0);
+    const double w0    = juce::MathConstants<double>::twoPi * freq / sampleRate;
+    const double cosw  = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    return normalise(1.0 + alpha * A, -2.0 * cosw, 1.0 - alpha * A,
+                     1.0 + alpha / A, -2.0 * cosw, 1.0 - alpha / A);
+}
+
+BiquadCoeffs EQProcessor::makeHighShelf(double sampleRate, double freq, double q, float gainDb) noexcept
+{
+    const double A     = std::pow(10.0, static_cast<double>(gainDb) / 40.0);
+    const double w0    = juce::MathConstants<double>::twoPi * freq / sampleRate;
+    const double cosw  = std::cos(w0);
+    const double beta  = std::sin(w0) * std::sqrt(A) / q;
+    return normalise(       A * ((A + 1.0) + (A - 1.0) * cosw + beta),
+                     -2.0 * A * ((A - 1.0) + (A + 1.0) * cosw),
+                            A * ((A + 1.0) + (A - 1.0) * cosw - beta),
+                                 (A + 1.0) - (A - 1.0) * cosw + beta,
+                          2.0 * ((A - 1.0) - (A + 1.0) * cosw),
+                                 (A + 1.0) - (A - 1.0) * cosw - beta);
+}
+
+// ── Parameters ─────────────────────────────────────────────────────────────
 
 void EQProcessor::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate_ = spec.sampleRate;
-    lowFilter_.prepare(spec);
-    midFilter_.prepare(spec);
-    highFilter_.prepare(spec);
-    updateCoefficients(0.f, 0.f, 0.f);
+    for (auto& g : gainDb_)
+        g.reset(sampleRate_, kRampMs / 1000.0);
+    snapNext_ = true;
+    designedDb_.fill(std::numeric_limits<float>::quiet_NaN());   // sample rate may have changed
+    applyTargets();
+    reset();
+}
+
+void EQProcessor::reset()
+{
+    for (auto& band : state_)
+        for (auto& s : band)
+            s = {};
 }
 
 void EQProcessor::setGains(float lowDb, float midDb, float highDb)
 {
-    updateCoefficients(lowDb, midDb, highDb);
+    bandDb_[Low]  = lowDb;
+    bandDb_[Mid]  = midDb;
+    bandDb_[High] = highDb;
+    applyTargets();
 }
 
 void EQProcessor::setTilt(float tilt)
 {
-    setGains(-tilt * 12.f, 0.f, tilt * 12.f);
+    tilt_ = juce::jlimit(-1.f, 1.f, tilt);
+    applyTargets();
+}
+
+void EQProcessor::applyTargets()
+{
+    const float target[NumBands] = {
+        juce::jlimit(-24.f, 24.f, bandDb_[Low] - tilt_ * 12.f),
+        juce::jlimit(-24.f, 24.f, bandDb_[Mid]),
+        juce::jlimit(-24.f, 24.f, bandDb_[High] + tilt_ * 12.f),
+    };
+    for (int b = 0; b < NumBands; ++b) {
+        if (snapNext_) gainDb_[static_cast<size_t>(b)].setCurrentAndTargetValue(target[b]);
+        else           gainDb_[static_cast<size_t>(b)].setTargetValue(target[b]);
+    }
+    if (snapNext_)
+        updateCoefficients();
 }
 
+void EQProcessor::updateCoefficients()
+{
+    const float low  = gainDb_[Low].getCurrentValue();
+    const float mid  = gainDb_[Mid].getCurrentValue();
+    const float high = gainDb_[High].getCurrentValue();
+
+    // Each design is a pow/sin/cos handful; skip bands whose gain did not move.
+    if (low  != designedDb_[Low])  coeffs_[Low]  = makeLowShelf (sampleRate_, kLowFreq,  kQ, low);
+    if (mid  != designedDb_[Mid])  coeffs_[Mid]  = makePeak     (sampleRate_, kMidFreq,  kQ, mid);
+    if (high != designedDb_[High]) coeffs_[High] = makeHighShelf(sampleRate_, kHighFreq, kQ, high);
+    designedDb_ = { low, mid, high };
+}
+
+// ── Processing ─────────────────────────────────────────────────────────────
+
 void EQProcessor::process(juce::dsp::AudioBlock<float>& block)
 {
-    juce::dsp::ProcessContextReplacing<float> ctx(block);
-    lowFilter_.process(ctx);
-    midFilter_.process(ctx);
-    highFilter_.process(ctx);
+    const int numSamples  = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(kMaxChannels, static_cast<int>(block.getNumChannels()));
+    float* channels[kMaxChannels] {};
+    for (int c = 0; c < numChannels; ++c)
+        channels[c] = block.getChannelPointer(static_cast<size_t>(c));
+
+    snapNext_ = false;
+    int pos = 0;
+    while (pos < numSamples) {
+        const bool ramping = gainDb_[Low].isSmoothing() || gainDb_[Mid].isSmoothing()
+                          || gainDb_[High].isSmoothing();
+        const int len = ramping ? juce::jmin(kRampSubBlock, numSamples - pos) : numSamples - pos;
+        if (ramping) {
+            for (auto& g : gainDb_) g.skip(len);
+            updateCoefficients();
+        }
+        processChunk(channels, numChannels, pos, len);
+        pos += len;
+    }
+}
+
+void EQProcessor::processChunk(float* const* channels, int numChannels, int start, int len) noexcept
+{
+#if JUCE_USE_SIMD
+    if (numChannels == 2) {
+        processStereo(channels[0] + start, channels[1] + start, len);
+        return;
+    }
+#endif
+    for (int c = 0; c < numChannels; ++c) {
+        Section<float> lo, md, hi;
+        loadSection(lo, Low, c);
+        loadSection(md, Mid, c);
+        loadSection(hi, High, c);
+
+        float* x = channels[c] + start;
+        for (int i = 0; i < len; ++i)
+            x[i] = hi.process(md.process(lo.process(x[i])));
+
+        storeSection(lo, Low, c);
+        storeSection(md, Mid, c);
+        storeSection(hi, High, c);
+    }
+}
+
+#if JUCE_USE_SIMD
+// L and R ride in lanes 0 and 1 of one register, so both channels share each
+// multiply/add and the whole cascade is a single pass. Samples are interleaved into the
+// aligned scratch a chunk at a time and read back after the chunk: packing them one
+// sample at a time through a stack array stalls on store forwarding every sample.
+void EQProcessor::processStereo(float* left, float* right, int len) noexcept
+{
+    using Reg = juce::dsp::SIMDRegister<float>;
+    constexpr int kLanes = static_cast<int>(Reg::SIMDNumElements);
+    float* const scratch = interleaved_.data();
+
+    auto load = [&](Section<Reg>& sec, Band b) {
+        const auto& k = coeffs_[static_cast<size_t>(b)];
+        sec.b0 = Reg::expand(k.b0);
+        sec.b1 = Reg::expand(k.b1);
+        sec.b2 = Reg::expand(k.b2);
+        sec.a1 = Reg::expand(k.a1);
+        sec.a2 = Reg::expand(k.a2);
+        scratch[0] = state_[b][0].s1;  scratch[1] = state_[b][1].s1;
+        sec.s1 = Reg::fromRawArray(scratch);
+        scratch[0] = state_[b][0].s2;  scratch[1] = state_[b][1].s2;
+        sec.s2 = Reg::fromRawArray(scratch);
+    };
+    auto store = [&](const Section<Reg>& sec, Band b) {
+        sec.s1.copyToRawArray(scratch);
+        state_[b][0].s1 = scratch[0];
+        state_[b][1].s1 = scratch[1];
+        sec.s2.copyToRawArray(scratch);
+        state_[b][0].s2 = scratch[0];
+        state_[b][1].s2 = scratch[1];
+    };
+
+    Section<Reg> lo, md, hi;
+    load(lo, Low);
+    load(md, Mid);
+    load(hi, High);
+    // Unused lanes stay zero, so they never carry denormals or NaNs through the cascade
+    std::fill(interleaved_.begin(), interleaved_.end(), 0.f);
+
+    for (int start = 0; start < len; start += kInterleaveChunk) {
+        const int n = juce::jmin(kInterleaveChunk, len - start);
+        for (int i = 0; i < n; ++i) {
+            scratch[i * kLanes]     = left[start + i];
+            scratch[i * kLanes + 1] = right[start + i];
+        }
+        for (int i = 0; i < n; ++i) {
+            float* frame = scratch + i * kLanes;
+            hi.process(md.process(lo.process(Reg::fromRawArray(frame)))).copyToRawArray(frame);
+        }
+        for (int i = 0; i < n; ++i) {
+            left[start + i]  = scratch[i * kLanes];
+            right[start + i] = scratch[i * kLanes + 1];
+        }
+    }
+
+    store(lo, Low);
+    store(md, Mid);
+    store(hi, High);
+}
+#endif
+
+void EQProcessor::loadSection(Section<float>& sec, Band b, int channel) const noexcept
+{
+    const auto& k = coeffs_[static_cast<size_t>(b)];
+    sec.b0 = k.b0; sec.b1 = k.b1; sec.b2 = k.b2; sec.a1 = k.a1; sec.a2 = k.a2;
+    sec.s1 = state_[b][channel].s1;
+    sec.s2 = state_[b][channel].s2;
 }
 
-void EQProcessor::updateCoefficients(float lowDb, float midDb, float highDb)
+void EQProcessor::storeSection(const Section<float>& sec, Band b, int channel) noexcept
 {
-    *lowFilter_.coefficients = *Coeffs::makeLowShelf(
-        sampleRate_, 200.0, 0.707, juce::Decibels::decibelsToGain(lowDb));
-    *midFilter_.coefficients = *Coeffs::makePeakFilter(
-        sampleRate_, 1000.0, 0.707, juce::Decibels::decibelsToGain(midDb));
-    *highFilter_.coefficients = *Coeffs::makeHighShelf(
-        sampleRate_, 6000.0, 0.707, juce::Decibels::decibelsToGain(highDb));
+    state_[b][channel] = { sec.s1, sec.s2 };
 }
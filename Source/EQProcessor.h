@@ -1,21 +1,84 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include <array>
 
+// Normalised biquad coefficients (a0 = 1).
+struct BiquadCoeffs {
+    float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+};
+
+/**
+ * EQProcessor — three-band grain EQ (low shelf 200 Hz, mid peak 1 kHz, high shelf 6 kHz).
+ *
+ * Coefficients are computed in closed form (RBJ cookbook) straight into member storage,
+ * so gain changes never allocate. Band gains glide over kRampMs: while a ramp is running
+ * the block is processed in kRampSubBlock-sample chunks with coefficients recomputed from
+ * the smoothed dB values at each chunk, which removes zipper noise under automation.
+ * The three sections run as one transposed direct form II cascade per sample; stereo
+ * blocks carry L and R in two SIMD lanes so both channels go through in a single pass,
+ * interleaved kInterleaveChunk samples at a time into member scratch.
+ */
 class EQProcessor {
 public:
+    static constexpr int    kMaxChannels  = 2;
+    static constexpr int    kRampSubBlock = 16;
+    static constexpr double kRampMs       = 20.0;
+    static constexpr int    kInterleaveChunk = 64;
+
     void prepare(const juce::dsp::ProcessSpec& spec);
     // gains in dB: lowDb = low shelf (200 Hz), midDb = mid peak (1 kHz), highDb = high shelf (6 kHz)
     void setGains(float lowDb, float midDb, float highDb);
-    // tilt in [-1, +1]: negative = dark (low boost / high cut), positive = bright (high boost / low cut)
+    // tilt in [-1, +1]: negative = dark (low boost / high cut), positive = bright (high boost / low cut).
+    // Adds ±12 dB to the shelves on top of the band gains.
     void setTilt(float tilt);
     void process(juce::dsp::AudioBlock<float>& block);
+    void reset();
+
+    // Closed-form designs (also used by tests). q is the RBJ shelf/peak Q.
+    static BiquadCoeffs makeLowShelf (double sampleRate, double freq, double q, float gainDb) noexcept;
+    static BiquadCoeffs makePeak     (double sampleRate, double freq, double q, float gainDb) noexcept;
+    static BiquadCoeffs makeHighShelf(double sampleRate, double freq, double q, float gainDb) noexcept;
 
 private:
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using Coeffs = juce::dsp::IIR::Coefficients<float>;
+    enum Band { Low, Mid, High, NumBands };
+
+    struct SectionState { float s1 = 0.f, s2 = 0.f; };
+
+    // One TDF-II biquad with its coefficients and state held in locals (float or SIMD lanes).
+    template <typename T>
+    struct Section {
+        T b0, b1, b2, a1, a2, s1, s2;
+
+        T process(T x) noexcept
+        {
+            const T y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    void applyTargets();
+    void updateCoefficients();
+    void processChunk(float* const* channels, int numChannels, int start, int len) noexcept;
+#if JUCE_USE_SIMD
+    void processStereo(float* left, float* right, int len) noexcept;
+#endif
+    void loadSection(Section<float>& sec, Band b, int channel) const noexcept;
+    void storeSection(const Section<float>& sec, Band b, int channel) noexcept;
 
-    Filter lowFilter_, midFilter_, highFilter_;
     double sampleRate_ = 44100.0;
+    float  bandDb_[NumBands] { 0.f, 0.f, 0.f };
+    float  tilt_       = 0.f;
+    bool   snapNext_   = true;   // gains set before the first process() apply without a ramp
 
-    void updateCoefficients(float lowDb, float midDb, float highDb);
+    std::array<juce::SmoothedValue<float>, NumBands>  gainDb_;
+    std::array<float, NumBands>                        designedDb_ {};   // dB the coeffs reflect
+    std::array<BiquadCoeffs, NumBands>                 coeffs_;
+    SectionState state_[NumBands][kMaxChannels];
+#if JUCE_USE_SIMD
+    using Reg = juce::dsp::SIMDRegister<float>;
+    alignas(Reg::SIMDRegisterSize)
+    std::array<float, kInterleaveChunk * Reg::SIMDNumElements> interleaved_ {};   // L, R, 0, 0 per sample
+#endif
 };
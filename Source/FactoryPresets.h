@@ -3,6 +3,7 @@
 #include "PresetManager.h"
 #include <vector>
 
+// The factory preset list as stored in BinaryData (XML only; state not parsed yet).
 inline std::vector<PresetManager::FactoryPreset> makeFactoryPresets()
 {
     return {
@@ -67,3 +68,17 @@ inline std::vector<PresetManager::FactoryPreset> makeFactoryPresets()
         { "Noise Bloom",    "FX",      juce::String::fromUTF8(BinaryData::FX_NoiseBloom_xml,         BinaryData::FX_NoiseBloom_xmlSize) },
     };
 }
+
+// The factory presets, parsed once per process on first use. Every PresetManager (one
+// per open editor, one per offline render job) copies this list; the copies share the
+// same immutable state trees, so opening an editor never re-parses the XML.
+inline const std::vector<PresetManager::FactoryPreset>& getFactoryPresets()
+{
+    static const std::vector<PresetManager::FactoryPreset> presets = [] {
+        auto list = makeFactoryPresets();
+        for (auto& fp : list)
+            fp.state = PresetManager::parseState(fp.xml);
+        return list;
+    }();
+    return presets;
+}
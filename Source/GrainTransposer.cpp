@@ -0,0 +1,93 @@
+#include "GrainTransposer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kLoopFade = 64;   // crossfade at the loop point for transposed-up grains
+
+float hermite(float xm1, float x0, float x1, float x2, float t) noexcept
+{
+    const float c1 = 0.5f * (x1 - xm1);
+    const float c2 = xm1 - 2.5f * x0 + 2.f * x1 - 0.5f * x2;
+    const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    return ((c3 * t + c2) * t + c1) * t + x0;
+}
+} // namespace
+
+void GrainTransposer::prepare(int frameSize, int maxFrames)
+{
+    frameSize_ = frameSize;
+    cache_.resize(static_cast<size_t>(std::max(1, maxFrames)));
+    for (auto& e : cache_) {
+        e.audioL.assign(static_cast<size_t>(frameSize), 0.f);
+        e.audioR.assign(static_cast<size_t>(frameSize), 0.f);
+        e.valid = false;
+    }
+    loopScratch_.assign(static_cast<size_t>(frameSize), 0.f);
+    hits_ = misses_ = 0;
+}
+
+void GrainTransposer::setSemitones(float semitones) noexcept
+{
+    semitones_ = semitones;
+}
+
+void GrainTransposer::transpose(const CorpusFrame& frame, const float*& outL, const float*& outR) noexcept
+{
+    if (!isActive() || cache_.empty()) {
+        outL = frame.audioL.data();
+        outR = frame.audioR.data();
+        return;
+    }
+
+    // Serials count pushes from prepare(), so serial % capacity is the frame's slot
+    auto& e = cache_[static_cast<size_t>(frame.serial % cache_.size())];
+    if (e.valid && e.serial == frame.serial && e.semitones == semitones_) {
+        ++hits_;
+    } else {
+        ++misses_;
+        const double ratio = std::pow(2.0, static_cast<double>(semitones_) / 12.0);
+        resample(frame.audioL.data(), e.audioL.data(), frameSize_, ratio, loopScratch_.data());
+        resample(frame.audioR.data(), e.audioR.data(), frameSize_, ratio, loopScratch_.data());
+        e.serial    = frame.serial;
+        e.semitones = semitones_;
+        e.valid     = true;
+    }
+    outL = e.audioL.data();
+    outR = e.audioR.data();
+}
+
+void GrainTransposer::resample(const float* src, float* dst, int n, double ratio, float* loopScratch) noexcept
+{
+    if (n < 4) {
+        std::copy(src, src + n, dst);
+        return;
+    }
+
+    // Past the end of the frame (ratio > 1) reading continues through loop[0 .. L), where
+    // L = n − fade and loop[j] fades from src[L + j] into src[j] over the first `fade`
+    // samples. src[L − 1] → loop[0] = src[L] and loop[L − 1] → loop[0] are both seamless.
+    const int fade = std::min(kLoopFade, n / 4);
+    const int loopLen = n - fade;
+    if (ratio > 1.0) {
+        std::copy(src, src + loopLen, loopScratch);
+        for (int j = 0; j < fade; ++j) {
+            const float t = static_cast<float>(j) / static_cast<float>(fade);
+            loopScratch[j] = t * src[j] + (1.f - t) * src[loopLen + j];
+        }
+    }
+
+    auto at = [&](int k) noexcept {
+        if (k < 0)       return src[0];
+        if (k < loopLen) return src[k];
+        if (ratio <= 1.0) return src[std::min(k, n - 1)];
+        return loopScratch[(k - loopLen) % loopLen];
+    };
+
+    for (int i = 0; i < n; ++i) {
+        const double pos = static_cast<double>(i) * ratio;
+        const int    k   = static_cast<int>(pos);
+        const float  t   = static_cast<float>(pos - static_cast<double>(k));
+        dst[i] = hermite(at(k - 1), at(k), at(k + 1), at(k + 2), t);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "CorpusStore.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * GrainTransposer — per-grain pitch shifting by resampling, done once when a grain is
+ * handed to a voice instead of streaming the summed output through an STFT.
+ *
+ * Grains are read at 2^(semitones/12) with 4-point Hermite interpolation and keep their
+ * frame length: a transposed-down grain plays its first part slower, a transposed-up grain
+ * runs past its end and continues through a crossfaded loop of itself. Results are cached
+ * per corpus slot and semitone value, so repeated matches of the same frame are a copy.
+ * No latency; all storage is allocated in prepare().
+ */
+class GrainTransposer {
+public:
+    void prepare(int frameSize, int maxFrames);
+    // Audio thread. Changing the value lazily invalidates the whole cache.
+    void setSemitones(float semitones) noexcept;
+    bool isActive() const noexcept { return semitones_ != 0.f; }
+
+    // Points outL/outR at the transposed frame (cached), or at the frame itself when inactive.
+    void transpose(const CorpusFrame& frame, const float*& outL, const float*& outR) noexcept;
+
+    // Resamples one channel of n samples by ratio into dst; loopScratch must hold n floats.
+    static void resample(const float* src, float* dst, int n, double ratio, float* loopScratch) noexcept;
+
+    int getCacheHits()   const noexcept { return hits_; }
+    int getCacheMisses() const noexcept { return misses_; }
+
+private:
+    struct Entry {
+        std::vector<float> audioL, audioR;
+        uint64_t serial    = 0;
+        float    semitones = 0.f;
+        bool     valid     = false;
+    };
+
+    std::vector<Entry> cache_;      // one entry per corpus slot
+    std::vector<float> loopScratch_;
+    int   frameSize_ = 0;
+    float semitones_ = 0.f;
+    int   hits_ = 0, misses_ = 0;
+};
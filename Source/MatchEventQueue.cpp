@@ -0,0 +1,33 @@
+#include "MatchEventQueue.h"
+#include <algorithm>
+
+// AbstractFifo keeps one slot empty to tell full from empty.
+MatchEventQueue::MatchEventQueue(int capacity)
+    : fifo_(std::max(1, capacity) + 1),
+      storage_(static_cast<size_t>(std::max(1, capacity) + 1))
+{
+}
+
+bool MatchEventQueue::push(const MatchEvent& e) noexcept
+{
+    const auto scope = fifo_.write(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    storage_[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = e;
+    return true;
+}
+
+int MatchEventQueue::pop(MatchEvent* dest, int maxEvents) noexcept
+{
+    const auto scope = fifo_.read(std::min(maxEvents, fifo_.getNumReady()));
+    std::copy_n(storage_.begin() + scope.startIndex1, scope.blockSize1, dest);
+    std::copy_n(storage_.begin() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+void MatchEventQueue::drain() noexcept
+{
+    fifo_.finishedRead(fifo_.getNumReady());
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "FeatureExtractor.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// One grain hand-off, as seen by the matcher.
+struct MatchEvent {
+    int64_t  sampleTime   = 0;   // processed samples since prepare() at the frame boundary
+    Features ctrl;               // control-frame features the match was made against
+    int32_t  matchedIndex = -1;  // logical corpus index (0 = oldest)
+    float    distance     = 0.f; // weighted feature distance to the chosen frame
+    int32_t  candidates   = 0;   // frames within the rand threshold (1 when rand = 0)
+};
+
+/**
+ * MatchEventQueue — wait-free single-producer / single-consumer ring of MatchEvents.
+ *
+ * Thread model:
+ *   push()          — audio thread only; never blocks or allocates. When the consumer
+ *                     falls behind the event is dropped and counted, never overwritten.
+ *   pop(), drain()  — one consumer thread (editor timer or log writer)
+ *
+ * Capacity is fixed at construction; the storage is allocated once.
+ */
+class MatchEventQueue {
+public:
+    explicit MatchEventQueue(int capacity);
+
+    bool push(const MatchEvent& e) noexcept;
+
+    // Copies up to maxEvents oldest events into dest; returns the number copied.
+    int pop(MatchEvent* dest, int maxEvents) noexcept;
+
+    // Discards everything currently queued (consumer side).
+    void drain() noexcept;
+
+    int      getNumReady() const noexcept { return fifo_.getNumReady(); }
+    int      capacity()    const noexcept { return fifo_.getTotalSize() - 1; }
+    uint32_t getDropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    juce::AbstractFifo      fifo_;
+    std::vector<MatchEvent> storage_;
+    std::atomic<uint32_t>   dropped_ { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(MatchEventQueue)
+};
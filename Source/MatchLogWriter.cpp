@@ -0,0 +1,110 @@
+#include "MatchLogWriter.h"
+#include <cstring>
+
+namespace {
+constexpr int kDrainIntervalMs = 20;
+constexpr int kBatch           = 256;
+const char    kMagic[4]        = { 'S', 'T', 'M', 'L' };
+} // namespace
+
+MatchLogWriter::MatchLogWriter(int capacity)
+    : juce::Thread("Stitcher match log"), queue_(capacity)
+{
+}
+
+MatchLogWriter::~MatchLogWriter()
+{
+    stop();
+}
+
+bool MatchLogWriter::start(const juce::File& file, double sampleRate, int frameSize)
+{
+    stop();
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return false;
+
+    stream->write(kMagic, sizeof(kMagic));
+    stream->writeInt(kVersion);
+    stream->writeDouble(sampleRate);
+    stream->writeInt(frameSize);
+
+    stream_ = std::move(stream);
+    queue_.drain();  // discard anything left over from a previous session
+    active_.store(true, std::memory_order_release);
+    startThread(juce::Thread::Priority::background);
+    return true;
+}
+
+void MatchLogWriter::stop()
+{
+    if (stream_ == nullptr)
+        return;
+
+    active_.store(false, std::memory_order_release);
+    stopThread(1000);
+    writePending();
+    stream_->flush();
+    stream_.reset();
+}
+
+void MatchLogWriter::run()
+{
+    while (!threadShouldExit()) {
+        writePending();
+        wait(kDrainIntervalMs);
+    }
+}
+
+void MatchLogWriter::writePending()
+{
+    MatchEvent batch[kBatch];
+    int n = 0;
+    while ((n = queue_.pop(batch, kBatch)) > 0) {
+        for (int i = 0; i < n; ++i) {
+            const auto& e = batch[i];
+            stream_->writeInt64(e.sampleTime);
+            stream_->writeFloat(e.ctrl.zcr);
+            stream_->writeFloat(e.ctrl.rms);
+            stream_->writeFloat(e.ctrl.sc);
+            stream_->writeFloat(e.ctrl.st);
+            stream_->writeInt(e.matchedIndex);
+            stream_->writeFloat(e.distance);
+            stream_->writeInt(e.candidates);
+        }
+    }
+}
+
+bool MatchLogWriter::read(const juce::File& file, double& sampleRate, int& frameSize,
+                          std::vector<MatchEvent>& events)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
+
+    char magic[4] {};
+    if (in.read(magic, sizeof(magic)) != sizeof(magic)
+        || std::memcmp(magic, kMagic, sizeof(magic)) != 0
+        || in.readInt() != kVersion)
+        return false;
+
+    sampleRate = in.readDouble();
+    frameSize  = in.readInt();
+
+    events.clear();
+    while (in.getNumBytesRemaining() >= kRecordSize) {
+        MatchEvent e;
+        e.sampleTime   = in.readInt64();
+        e.ctrl.zcr     = in.readFloat();
+        e.ctrl.rms     = in.readFloat();
+        e.ctrl.sc      = in.readFloat();
+        e.ctrl.st      = in.readFloat();
+        e.matchedIndex = in.readInt();
+        e.distance     = in.readFloat();
+        e.candidates   = in.readInt();
+        events.push_back(e);
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "MatchEventQueue.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+
+/**
+ * MatchLogWriter — streams MatchEvents to a binary file from a background thread.
+ *
+ * The audio thread calls push() for every match; it is a single atomic load while
+ * logging is off and a wait-free FIFO write while on. The writer thread drains the
+ * FIFO every ~20 ms, so the file is never touched from the audio thread.
+ *
+ * File layout (little-endian):
+ *   header  "STML" | uint32 version (1) | float64 sampleRate | int32 frameSize
+ *   record  int64 sampleTime | float32 zcr, rms, sc, st | int32 matchedIndex
+ *           | float32 distance | int32 candidates                        (36 bytes)
+ */
+class MatchLogWriter : private juce::Thread {
+public:
+    static constexpr int kVersion    = 1;
+    static constexpr int kRecordSize = 36;
+
+    explicit MatchLogWriter(int capacity = 16384);
+    ~MatchLogWriter() override;
+
+    // Message thread. Replaces any existing file; returns false if it cannot be opened.
+    bool start(const juce::File& file, double sampleRate, int frameSize);
+    // Message thread. Flushes everything queued so far and closes the file.
+    void stop();
+
+    bool isActive() const noexcept { return active_.load(std::memory_order_acquire); }
+
+    // Audio thread.
+    void push(const MatchEvent& e) noexcept
+    {
+        if (active_.load(std::memory_order_acquire))
+            queue_.push(e);
+    }
+
+    uint32_t getDropped() const noexcept { return queue_.getDropped(); }
+
+    // Reads a log written by this class back into memory (tests / offline tools).
+    static bool read(const juce::File& file, double& sampleRate, int& frameSize,
+                     std::vector<MatchEvent>& events);
+
+private:
+    void run() override;
+    void writePending();
+
+    MatchEventQueue                          queue_;
+    std::unique_ptr<juce::FileOutputStream>  stream_;   // owned by the writer thread while active
+    std::atomic<bool>                        active_ { false };
+};
@@ -26,6 +26,11 @@ void MidiLearn::removeBindingsForCC(int cc)
 
 // ─── public API ──────────────────────────────────────────────────────────────
 
+MidiLearn::~MidiLearn()
+{
+    stopTimer();
+}
+
 void MidiLearn::registerParam(juce::RangedAudioParameter* /*param*/)
 {
     // No-op in the current design; kept for API symmetry and possible future use.
@@ -46,10 +51,50 @@ void MidiLearn::handleCC(int cc, int value)
         return; // do not dispatch during learn
     }
 
-    // Normal dispatch.
-    auto* param = ccToParam_[static_cast<std::size_t>(cc)].load(std::memory_order_relaxed);
-    if (param != nullptr)
-        param->setValueNotifyingHost(static_cast<float>(value) / 127.f);
+    // Normal dispatch: internal targets now, the host later.
+    const auto slot = static_cast<std::size_t>(cc);
+    auto* param = ccToParam_[slot].load(std::memory_order_acquire);
+    if (param == nullptr)
+        return;
+
+    const float normalised = static_cast<float>(value) / 127.f;
+    if (audioSink_)
+        audioSink_(*param, normalised);
+
+    pendingValue_[slot].store(normalised, std::memory_order_relaxed);
+    if (!pending_[slot].exchange(true, std::memory_order_acq_rel)) {
+        const auto scope = pendingFifo_.write(1);
+        if (scope.blockSize1 > 0)
+            pendingCCs_[static_cast<std::size_t>(scope.startIndex1)] = cc;
+    }
+}
+
+int MidiLearn::dispatchPending()
+{
+    int notified = 0;
+    for (;;) {
+        int cc = -1;
+        {
+            const auto scope = pendingFifo_.read(1);
+            if (scope.blockSize1 == 0)
+                break;
+            cc = pendingCCs_[static_cast<std::size_t>(scope.startIndex1)];
+        }
+        const auto slot = static_cast<std::size_t>(cc);
+        // Clear before reading: a value arriving after the read queues the CC again. The
+        // exchange is a read-modify-write, so the value load cannot move ahead of it.
+        pending_[slot].exchange(false, std::memory_order_acq_rel);
+        const float normalised = pendingValue_[slot].load(std::memory_order_acquire);
+
+        auto* param = ccToParam_[slot].load(std::memory_order_acquire);
+        if (param == nullptr)
+            continue;   // unbound while queued
+        dispatching_.store(true, std::memory_order_relaxed);
+        param->setValueNotifyingHost(normalised);
+        dispatching_.store(false, std::memory_order_relaxed);
+        ++notified;
+    }
+    return notified;
 }
 
 bool MidiLearn::processCapture()
@@ -64,6 +109,9 @@ bool MidiLearn::processCapture()
         return false;
     }
 
+    // 0. Queued values still belong to the old bindings.
+    dispatchPending();
+
     // 1. Remove any existing binding for this param (old CC → null).
     removeBindingsForParam(param);
 
@@ -107,41 +155,56 @@ void MidiLearn::unbind(int cc)
 {
     if (cc < 0 || cc > 127)
         return;
+    dispatchPending();
     ccToParam_[static_cast<std::size_t>(cc)].store(nullptr, std::memory_order_relaxed);
     removeBindingsForCC(cc);
 }
 
-juce::XmlElement* MidiLearn::createBindingsXml() const
+juce::ValueTree MidiLearn::createBindingsTree() const
 {
-    auto* xml = new juce::XmlElement("MIDI_LEARN");
+    juce::ValueTree tree("MIDI_LEARN");
     for (const auto& [cc, param] : bindings_)
-        if (param != nullptr) {
-            auto* child = xml->createNewChildElement("BINDING");
-            child->setAttribute("cc",      cc);
-            child->setAttribute("paramID", param->getParameterID());
-        }
-    return xml;
+        if (param != nullptr)
+            tree.appendChild(juce::ValueTree("BINDING", { { "cc",      cc },
+                                                          { "paramID", param->getParameterID() } }),
+                             nullptr);
+    return tree;
+}
+
+juce::XmlElement* MidiLearn::createBindingsXml() const
+{
+    return createBindingsTree().createXml().release();
 }
 
 void MidiLearn::restoreBindingsXml(
     const juce::XmlElement* xml,
     const juce::Array<juce::AudioProcessorParameter*>& params)
 {
-    if (xml == nullptr || xml->getTagName() != "MIDI_LEARN")
+    if (xml != nullptr)
+        restoreBindingsTree(juce::ValueTree::fromXml(*xml), params);
+}
+
+void MidiLearn::restoreBindingsTree(
+    const juce::ValueTree& tree,
+    const juce::Array<juce::AudioProcessorParameter*>& params)
+{
+    if (!tree.hasType("MIDI_LEARN"))
         return;
 
     // Clear existing state first.
+    dispatchPending();
     for (auto& a : ccToParam_)
         a.store(nullptr, std::memory_order_relaxed);
     bindings_.clear();
 
-    for (auto* child : xml->getChildIterator()) {
-        if (!child->hasTagName("BINDING"))
+    for (const auto& child : tree) {
+        if (!child.hasType("BINDING"))
             continue;
-        const int cc = child->getIntAttribute("cc", -1);
+        // Properties read back from XML are strings; var converts either form.
+        const int cc = static_cast<int>(child.getProperty("cc", -1));
         if (cc < 0 || cc > 127)
             continue;
-        const juce::String pid = child->getStringAttribute("paramID");
+        const juce::String pid = child.getProperty("paramID").toString();
         for (auto* ap : params) {
             auto* rp = dynamic_cast<juce::RangedAudioParameter*>(ap);
             if (rp && rp->getParameterID() == pid) {
@@ -2,19 +2,37 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <array>
 #include <atomic>
+#include <functional>
 #include <vector>
 
 /**
  * MidiLearn — maps incoming MIDI CC numbers to APVTS parameters.
  *
+ * A bound CC never calls the host from the audio thread. handleCC() hands the value to the
+ * AudioSink, which writes it straight into the processor's internal targets, and records it
+ * as the newest value for that CC. Each CC sits in the pending queue at most once, so a
+ * dense controller stream costs O(1) per message on the audio thread and at most 128 host
+ * notifications per drain. dispatchPending() sends each pending CC's newest value to its
+ * parameter with setValueNotifyingHost(); startHostUpdates() runs it on a timer.
+ *
  * Thread model:
  *   handleCC()       — called from audio thread (processBlock)
  *   processCapture() — called from message thread (~30 Hz timer)
+ *   isDispatching()  — any thread
  *   All other public methods — message thread only
  */
-class MidiLearn {
+class MidiLearn : private juce::Timer {
 public:
+    static constexpr int kHostUpdateHz = 30;
+
+    // Audio thread: receives every bound CC value (normalised 0..1) as it arrives.
+    using AudioSink = std::function<void(juce::RangedAudioParameter& param, float normalised)>;
+
     MidiLearn() = default;
+    ~MidiLearn() override;
+
+    // Message thread, before audio starts.
+    void setAudioSink(AudioSink sink) { audioSink_ = std::move(sink); }
 
     // Register a parameter so it is available for serialization lookup.
     // Call once per param after construction (message thread).
@@ -22,9 +40,21 @@ public:
 
     // Audio thread: handle one CC event.
     //   If learning: capture this CC (first one wins; CAS).
-    //   If not learning and a param is bound: dispatch value to param.
+    //   If not learning and a param is bound: pass the value to the AudioSink and queue
+    //   it for the host.
     void handleCC(int cc, int value);
 
+    // Message thread: notifies the host of the newest value of every pending CC.
+    // Returns the number of parameters notified.
+    int dispatchPending();
+
+    // Message thread: calls dispatchPending() kHostUpdateHz times a second.
+    void startHostUpdates() { startTimerHz(kHostUpdateHz); }
+
+    // True while dispatchPending() is inside setValueNotifyingHost(), so a parameter
+    // listener can tell the echo of a CC from a change made elsewhere.
+    bool isDispatching() const noexcept { return dispatching_.load(std::memory_order_relaxed); }
+
     // Message thread: drain any pending capture from the audio thread.
     // Returns true if a new binding was just committed.
     bool processCapture();
@@ -50,10 +80,15 @@ public:
     // Unbind a specific CC number.
     void unbind(int cc);
 
-    // Serialization — returns a heap-allocated XmlElement (caller owns it).
-    juce::XmlElement* createBindingsXml() const;
+    // Serialization — a MIDI_LEARN tree with one BINDING child (cc, paramID) per binding.
+    juce::ValueTree createBindingsTree() const;
 
     // Deserialization — restores bindings; uses params to look up by paramID.
+    void restoreBindingsTree(const juce::ValueTree& tree,
+                             const juce::Array<juce::AudioProcessorParameter*>& params);
+
+    // XML form of the above — returns a heap-allocated XmlElement (caller owns it).
+    juce::XmlElement* createBindingsXml() const;
     void restoreBindingsXml(const juce::XmlElement* xml,
                             const juce::Array<juce::AudioProcessorParameter*>& params);
 
@@ -70,6 +105,19 @@ private:
     // Staging area written by audio thread, drained by processCapture().
     std::atomic<int> capturedCC_ { -1 };
 
+    AudioSink audioSink_;
+
+    // Host notification queue: newest normalised value per CC, and the CCs waiting for
+    // dispatchPending() in arrival order. pending_ keeps a CC from being queued twice, so
+    // the FIFO can never fill.
+    std::array<std::atomic<float>, 128> pendingValue_ {};
+    std::array<std::atomic<bool>, 128>  pending_ {};
+    juce::AbstractFifo                  pendingFifo_ { 129 };
+    std::array<int, 129>                pendingCCs_ {};
+    std::atomic<bool>                   dispatching_ { false };
+
+    void timerCallback() override { dispatchPending(); }
+
     // Helper: remove all binding entries for a given param (message thread).
     void removeBindingsForParam(juce::RangedAudioParameter* param);
 
@@ -0,0 +1,170 @@
+#include "OfflineRenderer.h"
+#include "PluginProcessor.h"
+#include "PresetManager.h"
+#include "FactoryPresets.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+// A preset argument ending in .xml that names an existing file is loaded from that file;
+// anything else is looked up by name among the factory and user presets.
+bool loadPreset(StitcherProcessor& proc, const juce::String& preset)
+{
+    if (preset.isEmpty())
+        return true;
+
+    if (preset.endsWithIgnoreCase(".xml")) {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(preset);
+        if (file.existsAsFile()) {
+            PresetManager pm(proc.getAPVTS(), file.getParentDirectory());
+            return pm.loadPreset(file.getFileNameWithoutExtension());
+        }
+    }
+
+    PresetManager pm(proc.getAPVTS(), PresetManager::getUserPresetsDir(), getFactoryPresets());
+    return pm.loadPreset(preset);
+}
+
+std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formats,
+                                                    const juce::File& file)
+{
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
+
+// Reads numSamples into dest channels [first, first + 1]; past the end of the file the
+// reader zero-fills, and a mono file is copied to both channels.
+void readStereo(juce::AudioFormatReader& reader, juce::AudioBuffer<float>& dest,
+                int firstChannel, juce::int64 pos, int numSamples)
+{
+    float* const chans[2] = { dest.getWritePointer(firstChannel),
+                              dest.getWritePointer(firstChannel + 1) };
+    reader.read(chans, 2, pos, numSamples);
+    if (reader.numChannels == 1)
+        dest.copyFrom(firstChannel + 1, 0, dest, firstChannel, 0, numSamples);
+}
+} // namespace
+
+RenderResult OfflineRenderer::render(const RenderJob& job, const RenderOptions& options)
+{
+    RenderResult out;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    auto fail = [&out](const juce::String& message) {
+        out.result = juce::Result::fail(message);
+        return out;
+    };
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    auto mainReader = openReader(formats, job.mainInput);
+    if (mainReader == nullptr)
+        return fail("cannot read main input " + job.mainInput.getFullPathName());
+
+    const double sampleRate = mainReader->sampleRate;
+    std::unique_ptr<juce::AudioFormatReader> scReader;
+    if (job.sidechainInput != juce::File()) {
+        scReader = openReader(formats, job.sidechainInput);
+        if (scReader == nullptr)
+            return fail("cannot read sidechain input " + job.sidechainInput.getFullPathName());
+        if (scReader->sampleRate != sampleRate)
+            return fail("sidechain sample rate " + juce::String(scReader->sampleRate)
+                        + " Hz does not match the main input (" + juce::String(sampleRate) + " Hz)");
+    }
+
+    const int blockSize = juce::jlimit(1, 8192, options.blockSize);
+    StitcherProcessor proc;
+    if (!loadPreset(proc, job.preset))
+        return fail("unknown preset \"" + job.preset + "\"");
+
+    // Presets are loaded first so that load-time parameters (match length, seek, limiter
+    // lookahead) are in effect when the processor is prepared.
+    if (options.seed)
+        proc.setRandomSeed(*options.seed);
+    proc.setNonRealtime(true);
+    proc.setPlayConfigDetails(4, 2, sampleRate, blockSize);   // main + sidechain in, stereo out
+    proc.prepareToPlay(sampleRate, blockSize);
+
+    job.output.deleteFile();
+    auto stream = job.output.createOutputStream();
+    if (stream == nullptr)
+        return fail("cannot create " + job.output.getFullPathName());
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), sampleRate, 2, options.bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        return fail("cannot write a " + juce::String(options.bitsPerSample) + "-bit WAV");
+    stream.release();   // owned by the writer now
+
+    const juce::int64 latency      = options.compensateLatency ? proc.getLatencySamples() : 0;
+    const juce::int64 inputLength  = juce::jmax(mainReader->lengthInSamples,
+                                                scReader != nullptr ? scReader->lengthInSamples : 0);
+    const juce::int64 outputLength = inputLength + static_cast<juce::int64>(options.tailSeconds * sampleRate);
+    const juce::int64 total        = outputLength + latency;
+
+    juce::AudioBuffer<float> buffer(4, blockSize);
+    juce::MidiBuffer midi;
+
+    for (juce::int64 pos = 0; pos < total;) {
+        const int n = static_cast<int>(juce::jmin<juce::int64>(blockSize, total - pos));
+        buffer.setSize(4, n, false, false, true);
+
+        readStereo(*mainReader, buffer, 0, pos, n);
+        if (scReader != nullptr)
+            readStereo(*scReader, buffer, 2, pos, n);
+        else {
+            buffer.clear(2, 0, n);
+            buffer.clear(3, 0, n);
+        }
+
+        proc.processBlock(buffer, midi);
+
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, n, latency - pos));
+        if (skip < n && !writer->writeFromAudioSampleBuffer(buffer, skip, n - skip))
+            return fail("write error on " + job.output.getFullPathName());
+        pos += n;
+    }
+
+    writer.reset();   // flushes and closes the file
+    proc.releaseResources();
+
+    out.audioSeconds = static_cast<double>(outputLength) / sampleRate;
+    out.wallSeconds  = juce::Time::highResolutionTicksToSeconds(
+                           juce::Time::getHighResolutionTicks() - startTicks);
+    return out;
+}
+
+std::vector<RenderResult> OfflineRenderer::renderAll(const std::vector<RenderJob>& jobs,
+                                                     const RenderOptions& options,
+                                                     int numThreads,
+                                                     JobCallback onJobDone)
+{
+    std::vector<RenderResult> results(jobs.size());
+    if (jobs.empty())
+        return results;
+
+    if (numThreads <= 0)
+        numThreads = juce::SystemStats::getNumCpus();
+    numThreads = juce::jmin(numThreads, static_cast<int>(jobs.size()));
+
+    // Workers pull the next job index until the list is exhausted, so long and short
+    // files balance across cores without any up-front partitioning.
+    std::atomic<size_t> next { 0 };
+    auto worker = [&] {
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            results[i] = render(jobs[i], options);
+            if (onJobDone)
+                onJobDone(static_cast<int>(i), results[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<size_t>(numThreads - 1));
+    for (int t = 1; t < numThreads; ++t)
+        threads.emplace_back(worker);
+    worker();   // the calling thread takes a share too
+    for (auto& t : threads)
+        t.join();
+
+    return results;
+}
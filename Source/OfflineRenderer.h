@@ -0,0 +1,50 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <functional>
+#include <optional>
+#include <vector>
+
+/**
+ * OfflineRenderer — streams audio files through a private StitcherProcessor as fast as
+ * the CPU allows (no audio device, no editor, no message loop required).
+ *
+ * Every render() builds, prepares and destroys its own processor, so independent jobs
+ * share nothing and renderAll() can run one per core. Input is read and output written
+ * one block at a time; memory use does not grow with file length.
+ */
+struct RenderJob {
+    juce::File   mainInput;        // source audio (corpus); mono inputs are duplicated to stereo
+    juce::File   sidechainInput;   // control audio; left as File() for a silent sidechain
+    juce::File   output;           // stereo WAV at the main input's sample rate
+    juce::String preset;           // factory/user preset name or a preset .xml path; empty = defaults
+};
+
+struct RenderOptions {
+    int    blockSize         = 512;
+    double tailSeconds       = 2.0;    // rendered past the end of the longer input
+    bool   compensateLatency = true;   // drop the reported latency from the head of the output
+    int    bitsPerSample     = 24;     // 16, 24 or 32 (float)
+    std::optional<juce::int64> seed;   // set: seeded matcher, bit-reproducible output
+};
+
+struct RenderResult {
+    juce::Result result      = juce::Result::ok();
+    double       audioSeconds = 0.0;   // length of the written file
+    double       wallSeconds  = 0.0;   // time spent rendering it
+};
+
+class OfflineRenderer {
+public:
+    // Renders one job on the calling thread.
+    static RenderResult render(const RenderJob& job, const RenderOptions& options = {});
+
+    // Renders every job on numThreads worker threads (<= 0: one per CPU core) and returns
+    // the results in job order. onJobDone, if set, is called from the worker that finished
+    // the job, so it must be thread-safe.
+    using JobCallback = std::function<void(int jobIndex, const RenderResult&)>;
+    static std::vector<RenderResult> renderAll(const std::vector<RenderJob>& jobs,
+                                               const RenderOptions& options = {},
+                                               int numThreads = 0,
+                                               JobCallback onJobDone = {});
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+
+/**
+ * ParamRamp — block-rate smoothing for a continuous parameter.
+ *
+ * Call setTarget() and then advance() once at the top of each block. While the value is
+ * settled the ramp is flagged constant and the helpers run a scalar vector op; during a
+ * glide advance() renders one value per sample into a pre-allocated buffer and the
+ * helpers consume it with FloatVectorOperations. Either way the per-sample loops never
+ * touch an atomic and automation changes are click-free.
+ */
+class ParamRamp {
+public:
+    static constexpr double kDefaultRampSeconds = 0.02;
+
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = kDefaultRampSeconds)
+    {
+        value_.reset(sampleRate, rampSeconds);
+        ramp_.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize)), value_.getTargetValue());
+        constant_ = true;
+    }
+
+    void setTarget(float target) noexcept { value_.setTargetValue(target); }
+    void snap(float value) noexcept       { value_.setCurrentAndTargetValue(value); constant_ = true; }
+
+    // Renders the next numSamples (≤ the prepared block size) of the ramp.
+    void advance(int numSamples) noexcept
+    {
+        constant_ = !value_.isSmoothing();
+        if (constant_) return;
+        numSamples = juce::jmin(numSamples, static_cast<int>(ramp_.size()));
+        for (int i = 0; i < numSamples; ++i)
+            ramp_[static_cast<size_t>(i)] = value_.getNextValue();
+    }
+
+    bool isConstant() const noexcept        { return constant_; }
+    // The settled value; only meaningful while isConstant()
+    float getConstant() const noexcept      { return value_.getTargetValue(); }
+    // Per-sample values for the current block; only meaningful while !isConstant()
+    const float* getRamp() const noexcept   { return ramp_.data(); }
+
+    // data[i] *= value[i]
+    void applyGain(float* data, int numSamples) const noexcept
+    {
+        if (!constant_)
+            juce::FloatVectorOperations::multiply(data, ramp_.data(), numSamples);
+        else if (getConstant() != 1.f)
+            juce::FloatVectorOperations::multiply(data, getConstant(), numSamples);
+    }
+
+    // dest[i] = a[i] + value[i] · (b[i] − a[i]); dest must not alias a
+    void crossfade(float* dest, const float* a, const float* b, int numSamples) const noexcept
+    {
+        if (constant_ && (getConstant() == 0.f || getConstant() == 1.f)) {
+            juce::FloatVectorOperations::copy(dest, getConstant() == 0.f ? a : b, numSamples);
+            return;
+        }
+        juce::FloatVectorOperations::subtract(dest, b, a, numSamples);
+        if (constant_) juce::FloatVectorOperations::multiply(dest, getConstant(), numSamples);
+        else           juce::FloatVectorOperations::multiply(dest, ramp_.data(), numSamples);
+        juce::FloatVectorOperations::add(dest, a, numSamples);
+    }
+
+private:
+    juce::SmoothedValue<float> value_;
+    std::vector<float>         ramp_;
+    bool                       constant_ = true;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include "Parameters.h"
+#include <array>
+
+/**
+ * ParamSnapshot — plain values of every continuous parameter the audio thread applies,
+ * passed to it as one unit (see SnapshotHandoff) so a whole preset-morph step lands in a
+ * single block. Switches (modes, freeze) and load-time parameters are not part of it.
+ */
+struct ParamSnapshot {
+    enum Index {
+        ZcrWeight, RmsWeight, ScWeight, StWeight, Rand,
+        GainCtrl, GainSrc,
+        EqLow, EqMid, EqHigh, EqTilt,
+        ReverbSpace, ReverbWet,
+        PitchShift, Crush, CrushRate,
+        GainOut, Mix, Xfade,
+        kNumParams
+    };
+
+    static constexpr const char* kIds[kNumParams] = {
+        ParamIDs::zcrWeight, ParamIDs::rmsWeight, ParamIDs::scWeight, ParamIDs::stWeight, ParamIDs::rand_,
+        ParamIDs::gainCtrl, ParamIDs::gainSrc,
+        ParamIDs::eqLow, ParamIDs::eqMid, ParamIDs::eqHigh, ParamIDs::eqTilt,
+        ParamIDs::reverbSpace, ParamIDs::reverbWet,
+        ParamIDs::pitchShift, ParamIDs::crush, ParamIDs::crushRate,
+        ParamIDs::gainOut, ParamIDs::mix, ParamIDs::xfade,
+    };
+
+    // Position of a parameter ID in kIds, or -1 if the snapshot does not carry it
+    static int indexOf(const juce::String& id) noexcept
+    {
+        for (int i = 0; i < kNumParams; ++i)
+            if (id == kIds[i])
+                return i;
+        return -1;
+    }
+
+    std::array<float, kNumParams> values {};
+    bool settled = false;   // a morph's last step: the host parameters hold these values
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BitCrushProcessor.h"
 
 namespace ParamIDs {
     // Concatenative
@@ -26,14 +27,19 @@ namespace ParamIDs {
     inline constexpr auto reverbDamp  { "reverb_damp" };
     inline constexpr auto reverbWet   { "reverb_wet" };
     inline constexpr auto reverbSpace { "reverb_space" };
+    inline constexpr auto reverbMode  { "reverb_mode" };
     // Output
     inline constexpr auto gainOut    { "gain_out" };
     inline constexpr auto mix        { "mix" };
+    inline constexpr auto limiterLookahead { "limiter_lookahead" };
     // Crossfade
     inline constexpr auto xfade      { "xfade" };
     // Effects
     inline constexpr auto pitchShift { "pitch_shift" };
+    inline constexpr auto pitchMode  { "pitch_mode" };
     inline constexpr auto crush      { "crush" };
+    inline constexpr auto crushRate  { "crush_rate" };
+    inline constexpr auto crushAa    { "crush_aa" };
 }
 
 static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
@@ -169,6 +175,10 @@ static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout
         String(), AudioProcessorParameter::genericParameter,
         [](float v, int) { return String(v, 2); }, nullptr));
 
+    layout.add(std::make_unique<AudioParameterChoice>(
+        ParameterID{ParamIDs::reverbMode, 1}, "Reverb Mode",
+        juce::StringArray{"Algorithmic", "Convolution"}, 0));
+
     // Output
     layout.add(std::make_unique<AudioParameterFloat>(
         ParameterID{ParamIDs::gainOut, 1}, "Output",
@@ -182,6 +192,12 @@ static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout
         String(), AudioProcessorParameter::genericParameter,
         pctFormat, nullptr));
 
+    layout.add(std::make_unique<AudioParameterFloat>(
+        ParameterID{ParamIDs::limiterLookahead, 1}, "Limiter Lookahead",
+        NormalisableRange<float>(0.5f, 5.f, 0.1f), 1.5f,
+        String(), AudioProcessorParameter::genericParameter,
+        [](float v, int) { return String(v, 1) + " ms"; }, nullptr));
+
     layout.add(std::make_unique<AudioParameterFloat>(
         ParameterID{ParamIDs::xfade, 1}, "Xfade",
         NormalisableRange<float>(0.f, 1.f, 0.01f), 1.f,
@@ -197,6 +213,10 @@ static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout
             return (v >= 0 ? "+" : "") + String(v, 1) + " st";
         }, nullptr));
 
+    layout.add(std::make_unique<AudioParameterChoice>(
+        ParameterID{ParamIDs::pitchMode, 1}, "Pitch Mode",
+        juce::StringArray{"Stream", "Per Grain"}, 0));
+
     layout.add(std::make_unique<AudioParameterFloat>(
         ParameterID{ParamIDs::crush, 1}, "Crush",
         NormalisableRange<float>(0.f, 1.f, 0.01f), 0.f,
@@ -206,5 +226,19 @@ static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout
             return String(bits) + " bit";
         }, nullptr));
 
+    layout.add(std::make_unique<AudioParameterFloat>(
+        ParameterID{ParamIDs::crushRate, 1}, "Crush Rate",
+        NormalisableRange<float>(0.f, 1.f, 0.01f), 0.f,
+        String(), AudioProcessorParameter::genericParameter,
+        [](float v, int) {
+            if (v <= 0.f) return String("Off");
+            const double hz = BitCrushProcessor::kMaxHoldHz
+                * std::pow(BitCrushProcessor::kMinHoldHz / BitCrushProcessor::kMaxHoldHz, static_cast<double>(v));
+            return String(hz / 1000.0, 1) + " kHz";
+        }, nullptr));
+
+    layout.add(std::make_unique<AudioParameterBool>(
+        ParameterID{ParamIDs::crushAa, 1}, "Crush Antialiasing", false));
+
     return layout;
 }
@@ -4,11 +4,19 @@
 #include <signalsmith-stretch/signalsmith-stretch.h>
 #include "PitchShiftProcessor.h"
 
+namespace {
+constexpr int kMaxChannels = 8;
+} // namespace
+
 struct PitchShiftProcessor::Impl {
     signalsmith::stretch::SignalsmithStretch<float> stretch;
     juce::AudioBuffer<float> scratch;
+    // Stands in for the stretcher at 0 st so the path latency does not depend on the pitch
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> bypassDelay;
     int   numChannels = 2;
+    int   latency     = 0;
     float semitones   = 0.f;
+    bool  active      = true;
 };
 
 PitchShiftProcessor::PitchShiftProcessor() : impl_(std::make_unique<Impl>()) {}
@@ -16,13 +24,18 @@ PitchShiftProcessor::~PitchShiftProcessor() = default;
 
 void PitchShiftProcessor::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    impl_->numChannels = static_cast<int>(spec.numChannels);
+    jassert(spec.numChannels <= static_cast<juce::uint32>(kMaxChannels));
+    impl_->numChannels = juce::jmin(kMaxChannels, static_cast<int>(spec.numChannels));
     impl_->stretch.presetCheaper(impl_->numChannels, static_cast<float>(spec.sampleRate));
     impl_->stretch.setTransposeSemitones(impl_->semitones);
     impl_->scratch.setSize(impl_->numChannels, static_cast<int>(spec.maximumBlockSize));
 
     // Prime with silence to fill analysis lookahead, avoiding startup silence.
     const int latency = impl_->stretch.inputLatency() + impl_->stretch.outputLatency();
+    impl_->latency = latency;
+    impl_->bypassDelay.prepare(spec);
+    impl_->bypassDelay.setMaximumDelayInSamples(juce::jmax(1, latency));
+    impl_->bypassDelay.setDelay(static_cast<float>(latency));
     if (latency > 0) {
         juce::AudioBuffer<float> silence(impl_->numChannels, latency);
         silence.clear();
@@ -42,21 +55,43 @@ void PitchShiftProcessor::setSemitones(float semitones)
     impl_->stretch.setTransposeSemitones(static_cast<double>(semitones));
 }
 
+void PitchShiftProcessor::setActive(bool active)
+{
+    impl_->active = active;
+}
+
+int PitchShiftProcessor::getLatencySamples() const
+{
+    return impl_->latency;
+}
+
 void PitchShiftProcessor::process(juce::dsp::AudioBlock<float>& block)
 {
-    if (impl_->semitones == 0.f) return;
+    if (!impl_->active) return;
 
     const int numSamples = static_cast<int>(block.getNumSamples());
-    const int numCh      = impl_->numChannels;
+    const int numCh      = juce::jmin(impl_->numChannels, static_cast<int>(block.getNumChannels()));
+
+    if (impl_->semitones == 0.f) {
+        for (int c = 0; c < numCh; ++c) {
+            float* d = block.getChannelPointer(static_cast<size_t>(c));
+            for (int i = 0; i < numSamples; ++i) {
+                impl_->bypassDelay.pushSample(c, d[i]);
+                d[i] = impl_->bypassDelay.popSample(c);
+            }
+        }
+        return;
+    }
 
-    std::vector<float*> inPtrs(static_cast<size_t>(numCh));
-    std::vector<float*> outPtrs(static_cast<size_t>(numCh));
+    // Fixed-size pointer tables: process() runs on the audio thread and must not allocate
+    float* inPtrs[kMaxChannels];
+    float* outPtrs[kMaxChannels];
     for (int c = 0; c < numCh; ++c) {
-        inPtrs[static_cast<size_t>(c)]  = block.getChannelPointer(static_cast<size_t>(c));
-        outPtrs[static_cast<size_t>(c)] = impl_->scratch.getWritePointer(c);
+        inPtrs[c]  = block.getChannelPointer(static_cast<size_t>(c));
+        outPtrs[c] = impl_->scratch.getWritePointer(c);
     }
 
-    impl_->stretch.process(inPtrs.data(), numSamples, outPtrs.data(), numSamples);
+    impl_->stretch.process(inPtrs, numSamples, outPtrs, numSamples);
 
     for (int c = 0; c < numCh; ++c)
         juce::FloatVectorOperations::copy(
@@ -12,9 +12,14 @@ public:
     PitchShiftProcessor& operator=(const PitchShiftProcessor&) = delete;
 
     void prepare(const juce::dsp::ProcessSpec& spec);
-    // semitones in [-24, 24]; 0 = bypass
+    // semitones in [-24, 24]; at 0 the stretcher is skipped but the signal is still delayed
+    // by its latency, so the reported latency does not change with the pitch.
     void setSemitones(float semitones);
+    // Inactive = untouched pass-through with no latency (per-grain pitch mode).
+    void setActive(bool active);
     void process(juce::dsp::AudioBlock<float>& block);
+    // Input + output latency of the stretcher while active, in samples. Fixed by prepare().
+    int  getLatencySamples() const;
 
 private:
     struct Impl;
@@ -21,19 +21,30 @@ void initRotary(juce::Slider& s, juce::Label& l, const juce::String& name,
 StitcherEditor::StitcherEditor(StitcherProcessor& p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
-      presetManager_(p.getAPVTS(), PresetManager::getUserPresetsDir(), makeFactoryPresets()),
-      presetBar_(presetManager_)
+      presetManager_(p.getAPVTS(), PresetManager::getUserPresetsDir(), getFactoryPresets()),
+      presetBar_(presetManager_),
+      scatter_([this](CorpusSnapshot& snap) { return audioProcessor.readCorpusSnapshot(snap); }),
+      diagnostics_(p.getProfiler())
 {
     setLookAndFeel(&lnf_);
 
     // Preset bar
     addAndMakeVisible(presetBar_);
+    presetManager_.setMorpher(&p.getMorpher());
+    presetManager_.getCatalogue();   // list the user presets now, before the first browse
     presetBar_.onCaptureSlot = [this](int slot) {
         abSlots_[slot] = audioProcessor.getAPVTS().copyState();
     };
     presetBar_.onLoadSlot = [this](int slot) {
-        if (abSlots_[slot].isValid())
+        if (!abSlots_[slot].isValid())
+            return;
+        auto& morpher = audioProcessor.getMorpher();
+        if (presetManager_.getMorphTime() > 0.0) {
+            morpher.morphTo(abSlots_[slot], presetManager_.getMorphTime());
+        } else {
+            morpher.stop();
             audioProcessor.getAPVTS().replaceState(abSlots_[slot].createCopy());
+        }
     };
 
     setSize(560, 620);
@@ -59,6 +70,7 @@ StitcherEditor::StitcherEditor(StitcherProcessor& p)
         dynamic_cast<juce::RangedAudioParameter*>(apvts.getParameter(ParamIDs::scWeight)),
         dynamic_cast<juce::RangedAudioParameter*>(apvts.getParameter(ParamIDs::stWeight)));
     addAndMakeVisible(morphPad_);
+    addChildComponent(scatter_);
     addAndMakeVisible(matchViz_);
 
     // Left column
@@ -67,6 +79,15 @@ StitcherEditor::StitcherEditor(StitcherProcessor& p)
     initRotary(pitchSlider_,  pitchLabel_,  "Pitch", *this);
     freezeButton_.setButtonText("Freeze");
     addAndMakeVisible(freezeButton_);
+    mapButton_.setButtonText("Map");
+    mapButton_.setTooltip("Show the corpus in feature space (click the map to switch axes, "
+                          "right-click for corpus options)");
+    mapButton_.onClick = [this] {
+        const bool showMap = mapButton_.getToggleState();
+        scatter_.setVisible(showMap);
+        morphPad_.setVisible(!showMap);
+    };
+    addAndMakeVisible(mapButton_);
 
     // Right column
     initRotary(tiltSlider_,      tiltLabel_,      "Tilt",   *this);
@@ -77,6 +98,7 @@ StitcherEditor::StitcherEditor(StitcherProcessor& p)
     initRotary(gainOutSlider_,   gainOutLabel_,   "Output", *this);
 
     addAndMakeVisible(levelMeter_);
+    addChildComponent(diagnostics_);
 
     // Attachments
     randAttach_       = std::make_unique<SA>(apvts, ParamIDs::rand_,      randSlider_);
@@ -108,8 +130,12 @@ StitcherEditor::StitcherEditor(StitcherProcessor& p)
     };
     for (auto& [slider, param] : sliderToParam_)
         slider->addMouseListener(this, false);
+    matchViz_.addMouseListener(this, false);
+    levelMeter_.addMouseListener(this, false);
+    scatter_.addMouseListener(this, false);
 
-    startTimerHz(30);
+    audioProcessor.discardMatchEvents();  // events queued while no editor was open
+    startTimerHz(RefreshGovernor::kActiveHz);
 }
 
 StitcherEditor::~StitcherEditor()
@@ -122,24 +148,84 @@ void StitcherEditor::timerCallback()
 {
     audioProcessor.getMidiLearn().processCapture();
 
+    // Each component reports the region its rendering changed in; only that region is
+    // invalidated, so a quiet editor costs no paint work at all.
     auto& proc = audioProcessor;
-    morphPad_.setLiveLevels(proc.getLastCtrlZcr(), proc.getLastCtrlRms(),
-                            proc.getLastCtrlSc(),  proc.getLastCtrlSt());
-    morphPad_.repaint();
-
-    matchViz_.tick(proc.getLastCtrlRms(),
-                   proc.getLastMatchedIndex(),
-                   proc.getLastCorpusFill(),
-                   proc.getMatchEpoch());
-    matchViz_.repaint();
-
-    levelMeter_.setLevels(proc.getLastOutPeakL(), proc.getLastOutPeakR());
-    levelMeter_.repaint();
+    const bool showing = isShowing();
+    bool changed = false;
+
+    const double nowMs   = juce::Time::getMillisecondCounterHiRes();
+    const double elapsed = lastTickMs_ > 0.0 ? juce::jmin(1.0, (nowMs - lastTickMs_) / 1000.0)
+                                             : 1.0 / refresh_.rateHz();
+    lastTickMs_ = nowMs;
+
+    if (showing) {
+        const auto padDirty = morphPad_.setLiveLevels(proc.getLastCtrlZcr(), proc.getLastCtrlRms(),
+                                                      proc.getLastCtrlSc(),  proc.getLastCtrlSt());
+        if (!padDirty.isEmpty() && morphPad_.isVisible()) {
+            morphPad_.repaint(padDirty);
+            changed = true;
+        }
+
+        int n = 0;
+        while ((n = proc.popMatchEvents(matchEvents_.data(), static_cast<int>(matchEvents_.size()))) > 0)
+            matchViz_.addMatchEvents(matchEvents_.data(), n);
+
+        if (scatter_.isVisible()) {
+            const auto scatterDirty = scatter_.setLive({ proc.getLastCtrlZcr(), proc.getLastCtrlRms(),
+                                                         proc.getLastCtrlSc(),  proc.getLastCtrlSt() },
+                                                       proc.getLastMatchedIndex());
+            if (!scatterDirty.isEmpty()) {
+                scatter_.repaint(scatterDirty);
+                changed = true;
+            }
+        }
+
+        CorpusCursor cursor;
+        proc.readCorpusCursor(cursor);
+        const auto vizDirty = matchViz_.tick(proc.getLastCtrlRms(),
+                                             proc.getLastMatchedIndex(),
+                                             cursor, elapsed);
+        if (!vizDirty.isEmpty()) {
+            matchViz_.repaint(vizDirty);
+            changed = true;
+        }
+
+        const auto meterDirty = levelMeter_.setLevels(proc.getLastOutPeakL(), proc.getLastOutPeakR());
+        if (!meterDirty.isEmpty()) {
+            levelMeter_.repaint(meterDirty);
+            changed = true;
+        }
+
+        if (diagnostics_.isVisible())
+            diagnostics_.tick();   // repaints itself a few times per second; not "activity"
+
+        // Match events alone are not activity: matching runs on every frame while the
+        // transport plays, even in silence. Only visible changes keep the rate up.
+    } else {
+        proc.discardMatchEvents();  // nobody is watching; don't replay a backlog later
+    }
+
+    const int prevHz = refresh_.rateHz();
+    if (const int hz = refresh_.update(showing, changed); hz != prevHz)
+        startTimerHz(hz);
 }
 
 void StitcherEditor::mouseDown(const juce::MouseEvent& e)
 {
     if (!e.mods.isRightButtonDown()) return;
+    if (e.eventComponent == &matchViz_) {
+        showMatchLogMenu();
+        return;
+    }
+    if (e.eventComponent == &levelMeter_) {
+        showMeterMenu();
+        return;
+    }
+    if (e.eventComponent == &scatter_) {
+        showCorpusMenu();
+        return;
+    }
     auto* slider = dynamic_cast<juce::Slider*>(e.eventComponent);
     if (slider == nullptr) return;
     auto it = sliderToParam_.find(slider);
@@ -158,11 +244,100 @@ void StitcherEditor::showMidiLearnMenu(juce::Slider* slider)
     if (curCC >= 0)
         menu.addItem(2, "Unbind CC " + juce::String(curCC));
 
+    // The Space knob also carries the reverb engine choice and the convolution IR
+    if (slider == &spaceSlider_) {
+        auto* mode = audioProcessor.getAPVTS().getParameter(ParamIDs::reverbMode);
+        const bool convolution = mode->getValue() > 0.5f;
+        const auto ir = audioProcessor.getImpulseResponseFile();
+        menu.addSeparator();
+        menu.addItem(10, "Algorithmic reverb", true, !convolution);
+        menu.addItem(11, "Convolution reverb", true, convolution);
+        menu.addItem(12, ir == juce::File() ? "Load impulse response..."
+                                            : "Impulse response: " + ir.getFileName() + "...");
+        if (ir != juce::File())
+            menu.addItem(13, "Clear impulse response");
+    }
+
     menu.showMenuAsync(juce::PopupMenu::Options{},
         [this, param](int result) {
             auto& midiLearn = audioProcessor.getMidiLearn();
-            if (result == 1)      midiLearn.startLearning(param);
-            else if (result == 2) midiLearn.unbind(midiLearn.getCCForParam(param));
+            auto* mode      = audioProcessor.getAPVTS().getParameter(ParamIDs::reverbMode);
+            if (result == 1)       midiLearn.startLearning(param);
+            else if (result == 2)  midiLearn.unbind(midiLearn.getCCForParam(param));
+            else if (result == 10) mode->setValueNotifyingHost(0.f);
+            else if (result == 11) mode->setValueNotifyingHost(1.f);
+            else if (result == 12) chooseImpulseResponse();
+            else if (result == 13) audioProcessor.clearImpulseResponse();
+        });
+}
+
+void StitcherEditor::chooseImpulseResponse()
+{
+    irChooser_ = std::make_unique<juce::FileChooser>(
+        "Load impulse response",
+        audioProcessor.getImpulseResponseFile().getParentDirectory(),
+        "*.wav;*.aif;*.aiff;*.flac");
+    irChooser_->launchAsync(
+        juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+        [this](const juce::FileChooser& fc) {
+            const auto file = fc.getResult();
+            if (file == juce::File() || !audioProcessor.loadImpulseResponse(file))
+                return;
+            audioProcessor.getAPVTS().getParameter(ParamIDs::reverbMode)->setValueNotifyingHost(1.f);
+        });
+}
+
+void StitcherEditor::showMatchLogMenu()
+{
+    juce::PopupMenu menu;
+    if (audioProcessor.isMatchLogging())
+        menu.addItem(1, "Stop match log");
+    else
+        menu.addItem(1, "Log matches to file...");
+
+    menu.showMenuAsync(juce::PopupMenu::Options{},
+        [this](int result) {
+            if (result != 1) return;
+            if (audioProcessor.isMatchLogging()) {
+                audioProcessor.stopMatchLog();
+                return;
+            }
+            logChooser_ = std::make_unique<juce::FileChooser>(
+                "Save match log",
+                juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                    .getChildFile("stitcher-matches.stml"),
+                "*.stml");
+            logChooser_->launchAsync(
+                juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+                [this](const juce::FileChooser& fc) {
+                    const auto file = fc.getResult();
+                    if (file != juce::File())
+                        audioProcessor.startMatchLog(file.withFileExtension("stml"));
+                });
+        });
+}
+
+void StitcherEditor::showCorpusMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Save frozen corpus with session", true, audioProcessor.getEmbedCorpus());
+    menu.showMenuAsync(juce::PopupMenu::Options{},
+        [this](int result) {
+            if (result == 1)
+                audioProcessor.setEmbedCorpus(!audioProcessor.getEmbedCorpus());
+        });
+}
+
+void StitcherEditor::showMeterMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Show DSP load", true, diagnostics_.isVisible());
+    menu.showMenuAsync(juce::PopupMenu::Options{},
+        [this](int result) {
+            if (result != 1) return;
+            diagnostics_.setVisible(!diagnostics_.isVisible());
+            if (diagnostics_.isVisible())
+                diagnostics_.tick();
         });
 }
 
@@ -245,9 +420,11 @@ void StitcherEditor::resized()
 
     const int padTop = center.getY();
     morphPad_.setBounds(center.getX() + centerOffsetX, padTop, padSz, padSz);
+    scatter_.setBounds(morphPad_.getBounds());
     matchViz_.setBounds(center.getX(), padTop + padSz + gap, center.getWidth(), vizH);
+    diagnostics_.setBounds(center.getX(), padTop, center.getWidth(), padSz + gap + vizH);
 
-    // Left column: Rand, Xfade, Pitch, Freeze — tighter spacing over pad height
+    // Left column: Rand, Xfade, Pitch, Freeze + Map — tighter spacing over pad height
     {
         const int slotH = padSz / 4;
         int y = padTop;
@@ -264,8 +441,10 @@ void StitcherEditor::resized()
         pitchSlider_.setBounds(leftCol.getX(), y + labelH, sideW, knobSz);
         y += slotH;
 
-        const int freezeH = 28;
-        freezeButton_.setBounds(leftCol.getX(), y + (slotH - freezeH) / 2, sideW, freezeH);
+        const int toggleH = 28;
+        const int toggleY = y + (slotH - 2 * toggleH - gap) / 2;
+        freezeButton_.setBounds(leftCol.getX(), toggleY, sideW, toggleH);
+        mapButton_.setBounds(leftCol.getX(), toggleY + toggleH + gap, sideW, toggleH);
     }
 
     // Right column: Tilt, Crush, Space, Wet, Mix, Output — over full body height
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <map>
 #include "PluginProcessor.h"
 #include "LookAndFeel/StitcherLookAndFeel.h"
@@ -8,6 +9,9 @@
 #include "UI/LevelMeter.h"
 #include "UI/MorphPad.h"
 #include "UI/MatchVisualizer.h"
+#include "UI/CorpusScatter.h"
+#include "UI/DiagnosticsPanel.h"
+#include "UI/RefreshGovernor.h"
 
 class StitcherEditor : public juce::AudioProcessorEditor,
                        private juce::Timer {
@@ -35,14 +39,16 @@ private:
     juce::Slider seekSlider_, matchLenSlider_, ctrlGainSlider_, srcGainSlider_;
     juce::Label  seekLabel_,  matchLenLabel_,  ctrlGainLabel_,  srcGainLabel_;
 
-    // Center hero
+    // Center hero — MorphPad and CorpusScatter share the hero slot (Map toggle)
     MorphPad        morphPad_;
+    CorpusScatter   scatter_;
     MatchVisualizer matchViz_;
 
     // Left column
     juce::Slider       randSlider_, xfadeSlider_, pitchSlider_;
     juce::Label        randLabel_,  xfadeLabel_,  pitchLabel_;
     juce::ToggleButton freezeButton_;
+    juce::ToggleButton mapButton_;
 
     // Right column
     juce::Slider tiltSlider_, crushSlider_, spaceSlider_, reverbWetSlider_, mixSlider_, gainOutSlider_;
@@ -51,6 +57,26 @@ private:
     // Output meter
     LevelMeter levelMeter_;
 
+    // DSP load readout over the hero area (right-click on the level meter)
+    DiagnosticsPanel diagnostics_;
+    void showMeterMenu();
+    void showCorpusMenu();   // right-click on the corpus map
+
+    // Adaptive timer rate + last observed processor state for change detection
+    RefreshGovernor refresh_;
+    double          lastTickMs_ = 0.0;   // previous timer tick, for time-based animation
+
+    // Scratch for draining match events on the timer (sized for ~one tick at 64-sample frames)
+    std::array<MatchEvent, 256> matchEvents_;
+
+    // Match log (right-click on the match visualizer)
+    std::unique_ptr<juce::FileChooser> logChooser_;
+    void showMatchLogMenu();
+
+    // Convolution IR (right-click on the Space knob)
+    std::unique_ptr<juce::FileChooser> irChooser_;
+    void chooseImpulseResponse();
+
     using SA = juce::AudioProcessorValueTreeState::SliderAttachment;
     using BA = juce::AudioProcessorValueTreeState::ButtonAttachment;
 
@@ -1,5 +1,7 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#if ! STITCHER_HEADLESS
+ #include "PluginEditor.h"
+#endif
 #include "ProtectYourEars.h"
 
 namespace {
@@ -14,6 +16,33 @@ int nearestPow2(double x)
     // p = largest power of 2 <= raw; p*2 = smallest power of 2 > raw
     return ((raw - p) <= (p * 2 - raw)) ? p : p * 2;
 }
+
+// True if the frame is exactly zero (a silent or missing input)
+bool isAllZero(const float* data, int numSamples)
+{
+    const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+    return range.getStart() == 0.f && range.getEnd() == 0.f;
+}
+
+// Ring-out allowance for the grain effects on top of the pitch shifter's latency (EQ
+// decay), and the limiter's release to settle — both in seconds.
+constexpr double kFxTailSeconds      = 0.25;
+constexpr double kLimiterTailSeconds = 0.5;
+
+// Session settings that are not parameters live in a SESSION child of the saved state,
+// outside the APVTS tree, so preset loads (replaceState) leave them alone. Older sessions
+// kept them as properties of the root.
+const juce::Identifier kSessionType         { "SESSION" };
+const juce::Identifier kIrPathProperty      { "irPath" };
+const juce::Identifier kEmbedCorpusProperty { "embedCorpus" };
+
+// Session state: magic, format version, the state tree in ValueTree's binary form, then
+// optionally a CorpusArchive chunk. Readers ignore what follows the tree, so appending
+// optional sections keeps the version; bump it whenever the existing layout changes.
+// Newer blobs are rejected rather than misread. Anything without the magic is tried as
+// the older copyXmlToBinary() format.
+constexpr int kStateMagic   = 0x42435453;   // "STCB"
+constexpr int kStateVersion = 1;
 } // namespace
 
 StitcherProcessor::StitcherProcessor()
@@ -22,6 +51,12 @@ StitcherProcessor::StitcherProcessor()
           .withInput ("Sidechain", juce::AudioChannelSet::stereo(), true)
           .withOutput("Output",    juce::AudioChannelSet::stereo(), true))
     , apvts_(*this, &undoManager_, "PARAMETERS", createParameterLayout())
+    , morpher_(apvts_, [this](const ParamSnapshot& snapshot, bool settled) {
+          morphHandoff_.push(snapshot);
+          morphActive_ = !settled;
+      })
+    , corpusArchive_([this](CorpusImage& image, uint64_t& key, bool mayWait) { return captureCorpus(image, key, mayWait); },
+                     [this](std::unique_ptr<CorpusImage> image) { installRestoredCorpus(std::move(image)); })
 {
     using namespace ParamIDs;
     for (auto* id : { zcrWeight, rmsWeight, scWeight, stWeight,
@@ -29,20 +64,38 @@ StitcherProcessor::StitcherProcessor()
                       matchLenSync, matchLenDiv,
                       gainCtrl, gainSrc,
                       eqLow, eqMid, eqHigh, eqTilt,
-                      reverbRoom, reverbDamp, reverbWet, reverbSpace,
+                      reverbRoom, reverbDamp, reverbWet, reverbSpace, reverbMode,
                       gainOut, mix, xfade,
-                      pitchShift, crush })
+                      pitchShift, pitchMode, crush, crushRate, crushAa })
         apvts_.addParameterListener(id, this);
 
     apvts_.addParameterListener(freeze, this);
 
-    // Register all APVTS parameters with MidiLearn.
-    for (auto* p : getParameters())
-        if (auto* rp = dynamic_cast<juce::RangedAudioParameter*>(p))
+    for (int k = 0; k < ParamSnapshot::kNumParams; ++k)
+        raw_.continuous[static_cast<size_t>(k)] = apvts_.getRawParameterValue(ParamSnapshot::kIds[k]);
+    raw_.pitchMode   = apvts_.getRawParameterValue(pitchMode);
+    raw_.crushAa     = apvts_.getRawParameterValue(crushAa);
+    raw_.reverbMode  = apvts_.getRawParameterValue(reverbMode);
+
+    // Register all APVTS parameters with MidiLearn; bound CCs reach the audio side through
+    // applyMidiValue() and the host on MidiLearn's timer.
+    for (auto* p : getParameters()) {
+        auto* rp = dynamic_cast<juce::RangedAudioParameter*>(p);
+        if (rp != nullptr)
             midiLearn_.registerParam(rp);
+        paramSlot_.push_back(rp != nullptr ? ParamSnapshot::indexOf(rp->getParameterID()) : -1);
+    }
+    midiLearn_.setAudioSink([this](juce::RangedAudioParameter& param, float normalised) {
+        applyMidiValue(param, normalised);
+    });
+    midiLearn_.startHostUpdates();
+    startTimerHz(kHousekeepingHz);
 }
 
-StitcherProcessor::~StitcherProcessor() {}
+StitcherProcessor::~StitcherProcessor()
+{
+    stopTimer();
+}
 
 const juce::String StitcherProcessor::getName() const { return JucePlugin_Name; }
 bool StitcherProcessor::acceptsMidi() const { return false; }
@@ -85,18 +138,36 @@ void StitcherProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 
     float seekTime = apvts_.getRawParameterValue(ParamIDs::seekTime)->load();
     int maxFrames  = static_cast<int>(seekTime * sampleRate / frameSize_) + 1;
-    corpus_.prepare(frameSize_, maxFrames);
-    corpusMaxFrames_ = std::max(1, maxFrames);
+    {
+        const juce::ScopedLock sl(corpusLock_);
+        corpus_.prepare(frameSize_, maxFrames);
+    }
+    {
+        const juce::ScopedLock sl(getCallbackLock());
+        restorePos_ = 0;   // prepare() emptied the corpus: stream a restored one in again
+    }
 
-    matcher_.prepare(frameSize_);
+    matcher_.prepare(frameSize_, maxFrames);
+    profiler_.prepare(sampleRate);
+    if (randomSeed_)
+        matcher_.setSeed(*randomSeed_);
     eq_.prepare(spec);
     reverb_.prepare(spec);
     pitchShift_.prepare(spec);
-    bitCrush_.setBits(16.f - apvts_.getRawParameterValue(ParamIDs::crush)->load() * 14.f);
-    pitchShift_.setSemitones(apvts_.getRawParameterValue(ParamIDs::pitchShift)->load());
+    bitCrush_.prepare(spec);
+    updateCrushFromParams();
+    transposer_.prepare(frameSize_, maxFrames);
+    // Size the dry delay for the longer (streaming) path before updatePitchFromParams() sets it
+    dryDelay_.prepare(spec);
+    dryDelay_.setMaximumDelayInSamples(grainLatencySamples(false));
+    updatePitchFromParams();
+
+    limiter_.setLookaheadMs(apvts_.getRawParameterValue(ParamIDs::limiterLookahead)->load());
     limiter_.prepare(spec);
-    limiter_.setThreshold(-1.0f);  // -1 dBFS ceiling
-    limiter_.setRelease(50.0f);    // 50 ms release
+    limiter_.setCeilingDb(-1.0f);  // -1 dBTP ceiling
+    limiter_.setReleaseMs(50.0f);  // 50 ms release
+
+    setLatencySamples(computeLatencySamples(raw_.pitchMode->load() > 0.5f));
 
     ctrlAccum_.assign(frameSize_, 0.f);
     srcAccum_.assign(frameSize_, 0.f);
@@ -114,13 +185,24 @@ void StitcherProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     grainMixBuf_.setSize(2, samplesPerBlock, false, true, false);
     accumPos_   = 0;
     grainReady_ = false;
+    samplePos_  = 0;
+
+    silentFeatures_ = featureExtractor_.extract(ctrlAccum_.data(), frameSize_);
+    fxTailSamples_  = static_cast<int>(kFxTailSeconds * sampleRate);
+    limiterActivity_.setTail(static_cast<int>(kLimiterTailSeconds * sampleRate) + limiter_.getLatencySamples());
+    grainFxActivity_.reset();
+    reverbActivity_.reset();
+    limiterActivity_.reset();
+    idle_ = true;
 
+    using S = ParamSnapshot;
     updateMatcherFromParams();
 
-    eq_.setTilt(apvts_.getRawParameterValue(ParamIDs::eqTilt)->load());
-    reverb_.setSpace(
-        apvts_.getRawParameterValue(ParamIDs::reverbSpace)->load(),
-        apvts_.getRawParameterValue(ParamIDs::reverbWet)->load());
+    eq_.setGains(liveValue(S::EqLow), liveValue(S::EqMid), liveValue(S::EqHigh));
+    eq_.setTilt(liveValue(S::EqTilt));
+    reverb_.setSpace(liveValue(S::ReverbSpace), liveValue(S::ReverbWet));
+    reverb_.setMode(raw_.reverbMode->load() > 0.5f ? ReverbProcessor::Mode::Convolution
+                                                   : ReverbProcessor::Mode::Algorithmic);
 
     gainCtrl_ = juce::Decibels::decibelsToGain(
         apvts_.getRawParameterValue(ParamIDs::gainCtrl)->load());
@@ -131,9 +213,16 @@ void StitcherProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     mix_    = apvts_.getRawParameterValue(ParamIDs::mix)->load() / 100.f;
     freeze_ = apvts_.getRawParameterValue(ParamIDs::freeze)->load() > 0.5f;
 
+    ctrlGainRamp_.prepare(sampleRate, samplesPerBlock);
+    mixRamp_.prepare(sampleRate, samplesPerBlock);
+    outGainRamp_.prepare(sampleRate, samplesPerBlock);
+    ctrlGainRamp_.snap(gainCtrl_.load());
+    mixRamp_.snap(mix_.load());
+    outGainRamp_.snap(gainOut_.load());
+    dryBuf_.setSize(2, samplesPerBlock, false, true, false);
+
     lastCtrlZcr_.store(0.f);  lastCtrlRms_.store(0.f);
     lastCtrlSc_.store(0.f);   lastCtrlSt_.store(0.f);
-    lastCorpusFill_.store(0.f);
     lastOutPeakL_.store(0.f); lastOutPeakR_.store(0.f);
 }
 
@@ -155,8 +244,12 @@ void StitcherProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                       juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const RealtimeGuard rtGuard;  // no-op unless built with STITCHER_RT_GUARD
+    const uint64_t blockStart = profiler_.beginBlock();
 
     // Dispatch MIDI CC messages to MidiLearn (handles both learn capture and dispatch).
+    // Bound values land in the internal targets and dirty flags below; the host hears of
+    // them later, from the message thread.
     for (const auto meta : midiMessages) {
         const auto& msg = meta.getMessage();
         if (msg.isController())
@@ -168,161 +261,159 @@ void StitcherProcessor::processBlock(juce::AudioBuffer<float>& buffer,
             if (pos->getBpm().hasValue())
                 lastKnownBpm_.store(*pos->getBpm(), std::memory_order_relaxed);
 
+    // A morph step first: the dirty flags below then only carry changes made outside it
+    if (morphHandoff_.pull(morphSnapshot_))
+        applyParamSnapshot();
+
     if (matcherDirty_.exchange(false))
         updateMatcherFromParams();
 
-    if (eqDirty_.exchange(false))
-        eq_.setTilt(apvts_.getRawParameterValue(ParamIDs::eqTilt)->load());
+    using S = ParamSnapshot;
+    if (eqDirty_.exchange(false)) {
+        eq_.setGains(liveValue(S::EqLow), liveValue(S::EqMid), liveValue(S::EqHigh));
+        eq_.setTilt(liveValue(S::EqTilt));
+    }
 
     if (pitchDirty_.exchange(false))
-        pitchShift_.setSemitones(apvts_.getRawParameterValue(ParamIDs::pitchShift)->load());
+        updatePitchFromParams();
 
     if (crushDirty_.exchange(false))
-        bitCrush_.setBits(16.f - apvts_.getRawParameterValue(ParamIDs::crush)->load() * 14.f);
+        updateCrushFromParams();
 
-    if (reverbDirty_.exchange(false))
-        reverb_.setSpace(
-            apvts_.getRawParameterValue(ParamIDs::reverbSpace)->load(),
-            apvts_.getRawParameterValue(ParamIDs::reverbWet)->load());
+    if (reverbDirty_.exchange(false)) {
+        reverb_.setSpace(liveValue(S::ReverbSpace), liveValue(S::ReverbWet));
+        reverb_.setMode(raw_.reverbMode->load() > 0.5f ? ReverbProcessor::Mode::Convolution
+                                                       : ReverbProcessor::Mode::Algorithmic);
+    }
 
+    const uint64_t inputStart = profiler_.begin();
     auto mainInput = getBusBuffer(buffer, true, 0);
     auto sidechain = getBusBuffer(buffer, true, 1);
     auto output    = getBusBuffer(buffer, false, 0);
 
     const int numSamples = buffer.getNumSamples();
 
+    // One atomic read per continuous parameter per block; the ramps carry any glide
+    ctrlGainRamp_.setTarget(gainCtrl_.load());
+    mixRamp_.setTarget(mix_.load());
+    outGainRamp_.setTarget(gainOut_.load());
+    ctrlGainRamp_.advance(numSamples);
+    mixRamp_.advance(numSamples);
+    outGainRamp_.advance(numSamples);
+
     corpus_.setFrozen(freeze_.load());
+    if (restoredCorpus_ != nullptr)
+        streamRestoredCorpus();
+
+    const float* inL = mainInput.getReadPointer(0);
+    const float* inR = mainInput.getReadPointer(1);
 
     // Mix stereo buses to mono for DSP processing
     // Guard against unconnected sidechain (VST3 DAWs may not connect it by default)
     const bool hasSidechain = (sidechain.getNumChannels() >= 2);
-    for (int i = 0; i < numSamples; ++i) {
-        ctrlMono_[i] = hasSidechain
-            ? (sidechain.getReadPointer(0)[i] + sidechain.getReadPointer(1)[i]) * 0.5f
-            : 0.f;
-        srcMono_[i]  = (mainInput.getReadPointer(0)[i] + mainInput.getReadPointer(1)[i]) * 0.5f;
+    if (hasSidechain) {
+        juce::FloatVectorOperations::add(ctrlMono_.data(), sidechain.getReadPointer(0),
+                                         sidechain.getReadPointer(1), numSamples);
+        juce::FloatVectorOperations::multiply(ctrlMono_.data(), 0.5f, numSamples);
+        ctrlGainRamp_.applyGain(ctrlMono_.data(), numSamples);
+    } else {
+        juce::FloatVectorOperations::clear(ctrlMono_.data(), numSamples);
     }
+    juce::FloatVectorOperations::add(srcMono_.data(), inL, inR, numSamples);
+    juce::FloatVectorOperations::multiply(srcMono_.data(), 0.5f, numSamples);
+    profiler_.end(StageProfiler::Input, inputStart);
 
     // Grain staging buffer (grain-only EQ applied after this loop)
     float* grainL = grainMixBuf_.getWritePointer(0);
     float* grainR = grainMixBuf_.getWritePointer(1);
+    juce::FloatVectorOperations::clear(grainL, numSamples);
+    juce::FloatVectorOperations::clear(grainR, numSamples);
+
+    // The block is cut at frame boundaries into contiguous segments, each accumulated
+    // with vector copies. A grain handed off at a boundary starts sounding on the sample
+    // that completed the frame, so rendering runs up to (not including) that sample first.
+    int rendered = 0;
+    for (int pos = 0; pos < numSamples;) {
+        const int len = juce::jmin(numSamples - pos, frameSize_ - accumPos_);
+        juce::FloatVectorOperations::copy(ctrlAccum_.data() + accumPos_, ctrlMono_.data() + pos, len);
+        juce::FloatVectorOperations::copy(srcAccum_.data()  + accumPos_, srcMono_.data()  + pos, len);
+        juce::FloatVectorOperations::copy(srcAccumL_.data() + accumPos_, inL + pos, len);
+        juce::FloatVectorOperations::copy(srcAccumR_.data() + accumPos_, inR + pos, len);
+        accumPos_ += len;
+        pos       += len;
 
-    // Single merged loop: accumulate, match at frame boundary, render grain
-    for (int i = 0; i < numSamples; ++i) {
-        // Accumulate this sample
-        ctrlAccum_[accumPos_] = ctrlMono_[i] * gainCtrl_.load();
-        srcAccum_[accumPos_]  = srcMono_[i];
-        srcAccumL_[accumPos_] = mainInput.getReadPointer(0)[i];
-        srcAccumR_[accumPos_] = mainInput.getReadPointer(1)[i];
-        ++accumPos_;
-
-        // When a full frame is ready: extract features, push corpus, match, hand off grain
         if (accumPos_ == frameSize_) {
-            Features srcFeatures  = featureExtractor_.extract(srcAccum_.data(),  frameSize_);
-            Features ctrlFeatures = featureExtractor_.extract(ctrlAccum_.data(), frameSize_);
-
-            lastCtrlZcr_.store(ctrlFeatures.zcr);
-            lastCtrlRms_.store(ctrlFeatures.rms);
-            lastCtrlSc_.store(ctrlFeatures.sc);
-            lastCtrlSt_.store(ctrlFeatures.st);
-
-            // Apply gainSrc_ after feature extraction so RMS matching is unaffected
-            const float gs = gainSrc_.load();
-            if (gs != 1.f) {
-                for (int j = 0; j < frameSize_; ++j) {
-                    srcAccumL_[j] *= gs;
-                    srcAccumR_[j] *= gs;
-                }
-            }
-
-            corpus_.push(srcAccumL_.data(), srcAccumR_.data(), srcFeatures);
-            lastCorpusFill_.store(
-                static_cast<float>(corpus_.size()) / static_cast<float>(corpusMaxFrames_));
-
-            const float* matchedL = nullptr, *matchedR = nullptr;
-            if (matcher_.match(ctrlFeatures, corpus_, matchedL, matchedR)) {
-                lastMatchedIndex_.store(matcher_.getLastMatchedIndex());
-                matchEpoch_.fetch_add(1, std::memory_order_relaxed);
-                const int xfadeLen = xfadeLenSamples_.load();
-                const int newSlot  = grainReady_ ? 1 - activeSlot_ : 0;
-                auto& nv = voices_[newSlot];
-
-                std::copy(matchedL, matchedL + frameSize_, nv.bufL.begin());
-                std::copy(matchedR, matchedR + frameSize_, nv.bufR.begin());
-
-                // Bake a trapezoidal fade-in/fade-out window into the grain buffer.
-                // Ensures both endpoints are zero-amplitude so the hard cut at
-                // voice boundaries is inaudible regardless of grain content.
-                if (xfadeLen > 0) {
-                    const int ramp = std::min(xfadeLen, frameSize_ / 2);
-                    if (ramp >= 2) {
-                        const float rampF = static_cast<float>(ramp - 1);
-                        for (int j = 0; j < ramp; ++j) {
-                            const float t = static_cast<float>(j) / rampF;
-                            nv.bufL[j]                  *= t;
-                            nv.bufR[j]                  *= t;
-                            nv.bufL[frameSize_ - 1 - j] *= t;
-                            nv.bufR[frameSize_ - 1 - j] *= t;
-                        }
-                    }
-                } else {
-                    // xfade=0: hard cut — deactivate old voice immediately (intentional click)
-                    if (grainReady_) voices_[activeSlot_].active = false;
-                }
-
-                nv.pos    = 0;
-                nv.active = true;
-                activeSlot_ = newSlot;
-                grainReady_ = true;
-            }
+            renderVoices(grainL, grainR, rendered, pos - 1);
+            rendered = pos - 1;
+            handOffFrame(samplePos_ + pos);
             accumPos_ = 0;
         }
+    }
+    renderVoices(grainL, grainR, rendered, numSamples);
+    samplePos_ += numSamples;
+
+    // Apply effects chain to grain signal: pitch → crush → EQ (skipped on silent grains)
+    auto grainBlock = juce::dsp::AudioBlock<float>(grainMixBuf_).getSubBlock(0, static_cast<size_t>(numSamples));
+    grainFxActivity_.setTail(pitchShift_.getLatencySamples() + fxTailSamples_);
+    if (grainFxActivity_.run(ActivityTracker::isSilent(grainMixBuf_, numSamples), numSamples)) {
+        auto t = profiler_.begin();
+        pitchShift_.process(grainBlock);
+        profiler_.end(StageProfiler::Pitch, t);
+        t = profiler_.begin();
+        bitCrush_.process(grainBlock);
+        profiler_.end(StageProfiler::Crush, t);
+        t = profiler_.begin();
+        eq_.process(grainBlock);
+        profiler_.end(StageProfiler::Eq, t);
+    }
 
-        // Render: sum all active voices (at most 2 overlap during fade region)
-        float gL = 0.f, gR = 0.f;
-        for (auto& v : voices_) {
-            if (!v.active) continue;
-            gL += v.bufL[v.pos];
-            gR += v.bufR[v.pos];
-            if (++v.pos >= frameSize_) v.active = false;
+    // Blend EQ'd grain with the latency-aligned dry main input into output
+    {
+        const StageProfiler::Scope s(profiler_, StageProfiler::Blend);
+        float* dryL = dryBuf_.getWritePointer(0);
+        float* dryR = dryBuf_.getWritePointer(1);
+        for (int i = 0; i < numSamples; ++i) {
+            dryDelay_.pushSample(0, inL[i]);
+            dryDelay_.pushSample(1, inR[i]);
+            dryL[i] = dryDelay_.popSample(0);
+            dryR[i] = dryDelay_.popSample(1);
         }
-        grainL[i] = gL;
-        grainR[i] = gR;
+        mixRamp_.crossfade(output.getWritePointer(0), dryL, grainL, numSamples);
+        mixRamp_.crossfade(output.getWritePointer(1), dryR, grainR, numSamples);
     }
 
-    // Apply effects chain to grain signal: pitch → crush → EQ
-    juce::dsp::AudioBlock<float> grainBlock(grainMixBuf_);
-    pitchShift_.process(grainBlock);
-    bitCrush_.process(grainBlock);
-    eq_.process(grainBlock);
-
-    // Blend EQ'd grain with dry main input into output
-    const float wet = mix_.load();
-    const float dry = 1.f - wet;
-    float* outL = output.getWritePointer(0);
-    float* outR = output.getWritePointer(1);
-    const float* inL = mainInput.getReadPointer(0);
-    const float* inR = mainInput.getReadPointer(1);
-
-    for (int i = 0; i < numSamples; ++i) {
-        outL[i] = dry * inL[i] + wet * grainL[i];
-        outR[i] = dry * inR[i] + wet * grainR[i];
+    // Reverb → output gain → limiter (processes the final blended output). Each stage
+    // keeps running on silence until its tail is done; the limiter then restarts from a
+    // fully released state so skipping it is indistinguishable from running it.
+    juce::dsp::AudioBlock<float> outputBlock(output);
+    reverbActivity_.setTail(reverb_.getTailSamples());
+    if (reverbActivity_.run(ActivityTracker::isSilent(output, numSamples), numSamples)) {
+        const StageProfiler::Scope s(profiler_, StageProfiler::Reverb);
+        reverb_.process(outputBlock);
     }
 
-    // Reverb → output gain → limiter (processes the final blended output)
-    juce::dsp::AudioBlock<float> outputBlock(output);
-    reverb_.process(outputBlock);
-    output.applyGain(0, numSamples, gainOut_.load());
-    limiter_.process(juce::dsp::ProcessContextReplacing<float>(outputBlock));
+    const bool limiterRan = limiterActivity_.run(ActivityTracker::isSilent(output, numSamples), numSamples);
+    if (limiterRan) {
+        const StageProfiler::Scope s(profiler_, StageProfiler::Limiter);
+        outGainRamp_.applyGain(output.getWritePointer(0), numSamples);
+        outGainRamp_.applyGain(output.getWritePointer(1), numSamples);
+        limiter_.process(outputBlock);
+        if (limiterActivity_.isIdle())
+            limiter_.reset();
+    }
+    idle_.store(grainFxActivity_.isIdle() && reverbActivity_.isIdle() && limiterActivity_.isIdle(),
+                std::memory_order_relaxed);
 
     // Update output peak atomics for the level meter
     {
         const float* pl = output.getReadPointer(0);
         const float* pr = output.getReadPointer(1);
         float pkL = 0.f, pkR = 0.f;
-        for (int i = 0; i < numSamples; ++i) {
-            pkL = std::max(pkL, std::abs(pl[i]));
-            pkR = std::max(pkR, std::abs(pr[i]));
+        if (limiterRan) {   // otherwise the block is silent
+            for (int i = 0; i < numSamples; ++i) {
+                pkL = std::max(pkL, std::abs(pl[i]));
+                pkR = std::max(pkR, std::abs(pr[i]));
+            }
         }
         // Decay: ~100ms time constant, independent of block size
         const float blockDecay = std::exp(
@@ -330,47 +421,269 @@ void StitcherProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         lastOutPeakL_.store(std::max(pkL, lastOutPeakL_.load(std::memory_order_relaxed) * blockDecay));
         lastOutPeakR_.store(std::max(pkR, lastOutPeakR_.load(std::memory_order_relaxed) * blockDecay));
     }
+    profiler_.endBlock(blockStart, numSamples);
 
 #if JUCE_DEBUG
     protectYourEars(buffer);
 #endif
 }
 
+// STITCHER_HEADLESS builds (the offline renderer) compile without the editor sources.
+#if STITCHER_HEADLESS
+bool StitcherProcessor::hasEditor() const { return false; }
+
+juce::AudioProcessorEditor* StitcherProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
 bool StitcherProcessor::hasEditor() const { return true; }
 
 juce::AudioProcessorEditor* StitcherProcessor::createEditor()
 {
     return new StitcherEditor(*this);
 }
+#endif
 
 void StitcherProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto rootXml = apvts_.copyState().createXml();
-    rootXml->addChildElement(midiLearn_.createBindingsXml()); // owned by rootXml
-    copyXmlToBinary(*rootXml, destData);
+    auto state = apvts_.copyState();
+    state.appendChild(midiLearn_.createBindingsTree(), nullptr);
+
+    juce::ValueTree session(kSessionType);
+    const auto ir = getImpulseResponseFile();
+    if (ir != juce::File())
+        session.setProperty(kIrPathProperty, ir.getFullPathName(), nullptr);
+    if (getEmbedCorpus())
+        session.setProperty(kEmbedCorpusProperty, true, nullptr);
+    state.appendChild(session, nullptr);
+
+    destData.reset();
+    juce::MemoryOutputStream out(destData, false);
+    out.writeInt(kStateMagic);
+    out.writeInt(kStateVersion);
+    state.writeToStream(out);
+
+    if (getEmbedCorpus() && freeze_.load()) {
+        juce::MemoryBlock chunk;
+        {
+            const juce::ScopedLock sl(corpusLock_);
+            chunk = restoredChunk_;
+        }
+        if (chunk.isEmpty())
+            chunk = corpusArchive_.getEncoded(corpus_.getContentVersion());
+        out.write(chunk.getData(), chunk.getSize());
+    }
 }
 
 void StitcherProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    if (!xml)
+    if (sizeInBytes >= 8 && juce::ByteOrder::littleEndianInt(data) == static_cast<juce::uint32>(kStateMagic)) {
+        const int version = static_cast<int>(juce::ByteOrder::littleEndianInt(static_cast<const char*>(data) + 4));
+        if (version > kStateVersion)
+            return;
+        juce::MemoryInputStream in(static_cast<const char*>(data) + 8, static_cast<size_t>(sizeInBytes - 8), false);
+        restoreState(juce::ValueTree::readFromStream(in));
+
+        juce::MemoryBlock chunk;
+        if (!in.isExhausted())
+            in.readIntoMemoryBlock(chunk);
+        restoreCorpusChunk(std::move(chunk));
         return;
+    }
+
+    // Sessions saved before the binary format, and hand-edited XML.
+    if (std::unique_ptr<juce::XmlElement> xml { getXmlFromBinary(data, sizeInBytes) }) {
+        restoreState(juce::ValueTree::fromXml(*xml));
+        restoreCorpusChunk({});
+    }
+}
+
+void StitcherProcessor::restoreState(juce::ValueTree state)
+{
+    // The root is the APVTS state tree with the MIDI bindings as a child. Take the
+    // bindings out so the next save doesn't carry a stale copy alongside the live one.
+    if (!state.hasType(apvts_.state.getType()))
+        return;
+
+    const auto bindings = state.getChildWithName("MIDI_LEARN");
+    if (bindings.isValid()) {
+        midiLearn_.restoreBindingsTree(bindings, getParameters());
+        state.removeChild(bindings, nullptr);
+    }
+
+    auto session = state.getChildWithName(kSessionType);
+    if (session.isValid())
+        state.removeChild(session, nullptr);
+    else
+        session = state.createCopy();
+    state.removeProperty(kIrPathProperty, nullptr);
+    state.removeProperty(kEmbedCorpusProperty, nullptr);
+
+    apvts_.replaceState(state);
+    embedCorpus_ = static_cast<bool>(session.getProperty(kEmbedCorpusProperty, false));
+
+    // A missing IR keeps its path, so the session still names it when saved again
+    const auto path = session.getProperty(kIrPathProperty).toString();
+    const auto ir   = juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File();
+    if (ir != juce::File())
+        reverb_.loadImpulseResponse(ir);
+    else
+        reverb_.clearImpulseResponse();
+    const juce::ScopedLock sl(sessionLock_);
+    irFile_ = ir;
+}
+
+bool StitcherProcessor::loadImpulseResponse(const juce::File& file)
+{
+    if (!reverb_.loadImpulseResponse(file))
+        return false;
+    const juce::ScopedLock sl(sessionLock_);
+    irFile_ = file;
+    return true;
+}
 
-    // Restore APVTS state (the root element is the APVTS state tree).
-    if (xml->hasTagName(apvts_.state.getType())) {
-        // Extract and remove MIDI_LEARN child before handing to APVTS
-        // (APVTS ignores unknown children, but let's be explicit).
-        auto* mlXml = xml->getChildByName("MIDI_LEARN");
-        if (mlXml != nullptr)
-            midiLearn_.restoreBindingsXml(mlXml, getParameters());
+void StitcherProcessor::clearImpulseResponse()
+{
+    reverb_.clearImpulseResponse();
+    const juce::ScopedLock sl(sessionLock_);
+    irFile_ = juce::File();
+}
+
+void StitcherProcessor::setEmbedCorpus(bool shouldEmbed)
+{
+    embedCorpus_ = shouldEmbed;
+    updateCorpusArchive();
+}
 
-        apvts_.replaceState(juce::ValueTree::fromXml(*xml));
+bool StitcherProcessor::getEmbedCorpus() const
+{
+    return embedCorpus_.load();
+}
+
+// Message thread, after Freeze or the embed setting changed (or a session loaded).
+void StitcherProcessor::updateCorpusArchive()
+{
+    if (!freeze_.load()) {
+        corpusArchive_.clearEncoded();
+        releaseRestoredCorpus();   // the corpus is live again; the saved one is history
+        return;
     }
+    if (!getEmbedCorpus()) {
+        corpusArchive_.clearEncoded();
+        return;
+    }
+    bool restored;
+    {
+        const juce::ScopedLock sl(corpusLock_);
+        restored = !restoredChunk_.isEmpty();
+    }
+    if (!restored)
+        corpusArchive_.requestEncode();   // get ahead of the host's next save
+}
+
+// Any non-audio thread. The audio thread applies Freeze at its next block, so when
+// allowed to wait, give it a moment before giving up.
+bool StitcherProcessor::captureCorpus(CorpusImage& out, uint64_t& key, bool mayWait)
+{
+    for (int attempt = 0; attempt < 50; ++attempt) {
+        {
+            const juce::ScopedLock sl(corpusLock_);
+            if (corpus_.copyFrozen(out, key))
+                return out.size() > 0;
+        }
+        if (!mayWait || !freeze_.load())
+            return false;
+        juce::Thread::sleep(10);
+    }
+    return false;
+}
+
+void StitcherProcessor::restoreCorpusChunk(juce::MemoryBlock chunk)
+{
+    if (chunk.isEmpty()) {
+        releaseRestoredCorpus();
+        return;
+    }
+    {
+        const juce::ScopedLock sl(corpusLock_);
+        restoredChunk_ = chunk;
+    }
+    corpusArchive_.clearEncoded();
+    corpusArchive_.requestDecode(std::move(chunk));
+}
+
+// Archive thread.
+void StitcherProcessor::installRestoredCorpus(std::unique_ptr<CorpusImage> image)
+{
+    {
+        // A later session state without a corpus (or Freeze released) got here first
+        const juce::ScopedLock sl(corpusLock_);
+        if (restoredChunk_.isEmpty())
+            return;
+    }
+    const juce::ScopedLock sl(getCallbackLock());
+    std::swap(restoredCorpus_, image);
+    restorePos_ = 0;
+}   // the image replaced (if any) is freed here, not on the audio thread
+
+void StitcherProcessor::releaseRestoredCorpus()
+{
+    {
+        const juce::ScopedLock sl(corpusLock_);
+        restoredChunk_.reset();
+    }
+    std::unique_ptr<CorpusImage> old;
+    const juce::ScopedLock sl(getCallbackLock());
+    std::swap(old, restoredCorpus_);
+}
+
+// Audio thread: copy the next few frames of a restored corpus into the store, newest
+// frames that fit only. A corpus saved with another frame size (match length or sample
+// rate changed since) cannot be used and is skipped.
+void StitcherProcessor::streamRestoredCorpus() noexcept
+{
+    const auto& image = *restoredCorpus_;
+    const int   total = image.size();
+    if (restorePos_ >= total)
+        return;
+    if (image.frameSize != corpus_.getFrameSize()) {
+        restorePos_ = total;
+        return;
+    }
+    if (restorePos_ == 0)
+        restorePos_ = juce::jmax(0, total - corpus_.getCapacity());
+
+    const int end = juce::jmin(total, restorePos_ + kRestoreFramesPerBlock);
+    for (; restorePos_ < end; ++restorePos_) {
+        const auto offset = static_cast<size_t>(restorePos_) * static_cast<size_t>(image.frameSize);
+        corpus_.restore(image.audioL.data() + offset, image.audioR.data() + offset,
+                        image.features[static_cast<size_t>(restorePos_)]);
+    }
+}
+
+juce::File StitcherProcessor::getImpulseResponseFile() const
+{
+    const juce::ScopedLock sl(sessionLock_);
+    return irFile_;
 }
 
 void StitcherProcessor::parameterChanged(const juce::String& id, float newValue)
 {
     using namespace ParamIDs;
+    if (const int slot = ParamSnapshot::indexOf(id); slot >= 0) {
+        // The morpher's host updates trail its snapshots; the audio side already has the value
+        if (morphActive_.load())
+            return;
+        // Likewise for MIDI CCs, except that a change from anywhere else takes over. The
+        // host update of an older CC value must not undo a newer one already applied.
+        auto& held = midiHeld_[static_cast<size_t>(slot)];
+        if (held.load()) {
+            if (midiLearn_.isDispatching() && newValue != midiValue_[static_cast<size_t>(slot)].load())
+                return;
+            held = false;
+        }
+    }
     if (id == zcrWeight || id == rmsWeight || id == scWeight || id == stWeight || id == rand_)
         matcherDirty_ = true;
     else if (id == gainCtrl)
@@ -381,34 +694,266 @@ void StitcherProcessor::parameterChanged(const juce::String& id, float newValue)
         gainOut_ = juce::Decibels::decibelsToGain(newValue);
     else if (id == mix)
         mix_ = newValue / 100.f;
-    else if (id == freeze)
+    else if (id == freeze) {
         freeze_ = newValue > 0.5f;
-    else if (id == eqTilt)
+        freezeChanged_ = true;   // encode or release the embedded corpus
+    }
+    else if (id == eqLow || id == eqMid || id == eqHigh || id == eqTilt)
         eqDirty_ = true;
-    else if (id == reverbSpace || id == reverbWet)
+    else if (id == reverbSpace || id == reverbWet || id == reverbMode)
         reverbDirty_ = true;
-    else if (id == pitchShift)
+    else if (id == pitchShift || id == pitchMode) {
         pitchDirty_ = true;
-    else if (id == crush)
+        if (id == pitchMode)
+            latencyChanged_ = true;   // host latency changes with the pitch path
+    }
+    else if (id == crush || id == crushRate || id == crushAa)
         crushDirty_ = true;
     else if (id == ParamIDs::xfade)
         xfadeLenSamples_.store(
             juce::jlimit(0, frameSize_ - 1, static_cast<int>(newValue * 256.f)));
-    else if (id == ParamIDs::seekTime || id == ParamIDs::matchLen)
+    else if (id == ParamIDs::seekTime || id == ParamIDs::matchLen || id == ParamIDs::limiterLookahead)
     {
-        // seekTime and matchLen take effect on next prepareToPlay (plugin reload).
+        // seekTime, matchLen and the limiter lookahead take effect on next prepareToPlay (plugin reload).
         // Runtime resize of circular buffers is not supported.
     }
 }
 
+// A full frame is ready: extract features, push corpus, match, hand off grain
+void StitcherProcessor::handOffFrame(int64_t eventTime)
+{
+    // No sidechain or a silent input gives all-zero frames: reuse their features
+    const uint64_t featuresStart = profiler_.begin();
+    Features srcFeatures  = isAllZero(srcAccum_.data(), frameSize_)
+                                ? silentFeatures_ : featureExtractor_.extract(srcAccum_.data(),  frameSize_);
+    Features ctrlFeatures = isAllZero(ctrlAccum_.data(), frameSize_)
+                                ? silentFeatures_ : featureExtractor_.extract(ctrlAccum_.data(), frameSize_);
+    profiler_.end(StageProfiler::Features, featuresStart);
+
+    lastCtrlZcr_.store(ctrlFeatures.zcr);
+    lastCtrlRms_.store(ctrlFeatures.rms);
+    lastCtrlSc_.store(ctrlFeatures.sc);
+    lastCtrlSt_.store(ctrlFeatures.st);
+
+    // Apply gainSrc_ after feature extraction so RMS matching is unaffected
+    const float gs = gainSrc_.load();
+    if (gs != 1.f) {
+        juce::FloatVectorOperations::multiply(srcAccumL_.data(), gs, frameSize_);
+        juce::FloatVectorOperations::multiply(srcAccumR_.data(), gs, frameSize_);
+    }
+
+    const uint64_t matchStart = profiler_.begin();
+    corpus_.push(srcAccumL_.data(), srcAccumR_.data(), srcFeatures);
+
+    const float* matchedL = nullptr, *matchedR = nullptr;
+    const bool matched = matcher_.match(ctrlFeatures, corpus_, matchedL, matchedR);
+    profiler_.end(StageProfiler::Match, matchStart);
+    if (!matched)
+        return;
+
+    lastMatchedIndex_.store(matcher_.getLastMatchedIndex());
+    matchEpoch_.fetch_add(1, std::memory_order_relaxed);
+
+    MatchEvent ev;
+    ev.sampleTime   = eventTime;
+    ev.ctrl         = ctrlFeatures;
+    ev.matchedIndex = matcher_.getLastMatchedIndex();
+    ev.distance     = matcher_.getLastDistance();
+    ev.candidates   = matcher_.getLastCandidateCount();
+    matchEvents_.push(ev);
+    matchLog_.push(ev);
+
+    const StageProfiler::Scope grainScope(profiler_, StageProfiler::Grain);
+    const int xfadeLen = xfadeLenSamples_.load();
+    const int newSlot  = grainReady_ ? 1 - activeSlot_ : 0;
+    auto& nv = voices_[newSlot];
+
+    // Per-grain pitch: transpose the matched frame once (cached per corpus slot)
+    if (transposer_.isActive())
+        transposer_.transpose(corpus_.getFrame(matcher_.getLastMatchedIndex()), matchedL, matchedR);
+
+    std::copy(matchedL, matchedL + frameSize_, nv.bufL.begin());
+    std::copy(matchedR, matchedR + frameSize_, nv.bufR.begin());
+
+    // Bake a trapezoidal fade-in/fade-out window into the grain buffer.
+    // Ensures both endpoints are zero-amplitude so the hard cut at
+    // voice boundaries is inaudible regardless of grain content.
+    if (xfadeLen > 0) {
+        const int ramp = std::min(xfadeLen, frameSize_ / 2);
+        if (ramp >= 2) {
+            const float rampF = static_cast<float>(ramp - 1);
+            for (int j = 0; j < ramp; ++j) {
+                const float t = static_cast<float>(j) / rampF;
+                nv.bufL[j]                  *= t;
+                nv.bufR[j]                  *= t;
+                nv.bufL[frameSize_ - 1 - j] *= t;
+                nv.bufR[frameSize_ - 1 - j] *= t;
+            }
+        }
+    } else {
+        // xfade=0: hard cut — deactivate old voice immediately (intentional click)
+        if (grainReady_) voices_[activeSlot_].active = false;
+    }
+
+    nv.pos    = 0;
+    nv.active = true;
+    activeSlot_ = newSlot;
+    grainReady_ = true;
+}
+
+// Sums all active voices (at most 2 overlap during fade region) into [start, end)
+void StitcherProcessor::renderVoices(float* outL, float* outR, int start, int end) noexcept
+{
+    for (auto& v : voices_) {
+        if (!v.active) continue;
+        const int n = juce::jmin(end - start, frameSize_ - v.pos);
+        if (n <= 0) continue;
+        juce::FloatVectorOperations::add(outL + start, v.bufL.data() + v.pos, n);
+        juce::FloatVectorOperations::add(outR + start, v.bufR.data() + v.pos, n);
+        if ((v.pos += n) >= frameSize_) v.active = false;
+    }
+}
+
+void StitcherProcessor::applyParamSnapshot() noexcept
+{
+    using S = ParamSnapshot;
+    if (morphSnapshot_.settled) {
+        // The host parameters already hold these values, and a change made between the
+        // settle and this block has landed in them (or in a held CC value) while the
+        // snapshot has not: re-derive everything from the live values instead.
+        if (!morphStepped_)
+            for (auto& held : midiHeld_)
+                held = false;   // a jump straight to the preset supersedes waiting CCs
+        morphStepped_ = false;
+
+        gainCtrl_ = juce::Decibels::decibelsToGain(liveValue(S::GainCtrl));
+        gainSrc_  = juce::Decibels::decibelsToGain(liveValue(S::GainSrc));
+        gainOut_  = juce::Decibels::decibelsToGain(liveValue(S::GainOut));
+        mix_      = liveValue(S::Mix) / 100.f;
+        xfadeLenSamples_.store(juce::jlimit(0, frameSize_ - 1, static_cast<int>(liveValue(S::Xfade) * 256.f)));
+        matcherDirty_ = true;
+        eqDirty_      = true;
+        reverbDirty_  = true;
+        pitchDirty_   = true;
+        crushDirty_   = true;
+        return;
+    }
+    morphStepped_ = true;
+
+    const auto& v = morphSnapshot_.values;
+
+    matcher_.setWeights(v[S::ZcrWeight], v[S::RmsWeight], v[S::ScWeight], v[S::StWeight]);
+    matcher_.setRand(v[S::Rand]);
+
+    gainCtrl_ = juce::Decibels::decibelsToGain(v[S::GainCtrl]);
+    gainSrc_  = juce::Decibels::decibelsToGain(v[S::GainSrc]);
+    gainOut_  = juce::Decibels::decibelsToGain(v[S::GainOut]);
+    mix_      = v[S::Mix] / 100.f;
+    xfadeLenSamples_.store(juce::jlimit(0, frameSize_ - 1, static_cast<int>(v[S::Xfade] * 256.f)));
+
+    eq_.setGains(v[S::EqLow], v[S::EqMid], v[S::EqHigh]);
+    eq_.setTilt(v[S::EqTilt]);
+    reverb_.setSpace(v[S::ReverbSpace], v[S::ReverbWet]);
+
+    bitCrush_.setBits(16.f - v[S::Crush] * 14.f);
+    bitCrush_.setRate(v[S::CrushRate]);
+
+    const bool perGrain = raw_.pitchMode->load() > 0.5f;
+    pitchShift_.setSemitones(perGrain ? 0.f : v[S::PitchShift]);
+    transposer_.setSemitones(perGrain ? v[S::PitchShift] : 0.f);
+
+    // The morph supersedes any CC value still waiting for its host update
+    for (auto& held : midiHeld_)
+        held = false;
+}
+
+void StitcherProcessor::applyMidiValue(juce::RangedAudioParameter& param, float normalised) noexcept
+{
+    using S = ParamSnapshot;
+    const auto index = static_cast<size_t>(param.getParameterIndex());
+    const int  slot  = index < paramSlot_.size() ? paramSlot_[index] : -1;
+    // Switches and load-time parameters wait for the host update; a morph owns the rest
+    if (slot < 0 || morphActive_.load())
+        return;
+
+    const float value = param.convertFrom0to1(normalised);
+    midiValue_[static_cast<size_t>(slot)] = value;
+    midiHeld_[static_cast<size_t>(slot)]  = true;
+
+    switch (slot) {
+        case S::GainCtrl: gainCtrl_ = juce::Decibels::decibelsToGain(value); break;
+        case S::GainSrc:  gainSrc_  = juce::Decibels::decibelsToGain(value); break;
+        case S::GainOut:  gainOut_  = juce::Decibels::decibelsToGain(value); break;
+        case S::Mix:      mix_      = value / 100.f; break;
+        case S::Xfade:
+            xfadeLenSamples_.store(juce::jlimit(0, frameSize_ - 1, static_cast<int>(value * 256.f)));
+            break;
+        case S::EqLow: case S::EqMid: case S::EqHigh: case S::EqTilt:
+            eqDirty_ = true;
+            break;
+        case S::ReverbSpace: case S::ReverbWet:
+            reverbDirty_ = true;
+            break;
+        case S::PitchShift:
+            pitchDirty_ = true;
+            break;
+        case S::Crush: case S::CrushRate:
+            crushDirty_ = true;
+            break;
+        default:   // matcher weights and randomness
+            matcherDirty_ = true;
+            break;
+    }
+}
+
+float StitcherProcessor::liveValue(ParamSnapshot::Index index) const noexcept
+{
+    const auto k = static_cast<size_t>(index);
+    return midiHeld_[k].load() ? midiValue_[k].load() : raw_.continuous[k]->load();
+}
+
 void StitcherProcessor::updateMatcherFromParams()
 {
-    matcher_.setWeights(
-        apvts_.getRawParameterValue(ParamIDs::zcrWeight)->load(),
-        apvts_.getRawParameterValue(ParamIDs::rmsWeight)->load(),
-        apvts_.getRawParameterValue(ParamIDs::scWeight)->load(),
-        apvts_.getRawParameterValue(ParamIDs::stWeight)->load());
-    matcher_.setRand(apvts_.getRawParameterValue(ParamIDs::rand_)->load());
+    using S = ParamSnapshot;
+    matcher_.setWeights(liveValue(S::ZcrWeight), liveValue(S::RmsWeight),
+                        liveValue(S::ScWeight),  liveValue(S::StWeight));
+    matcher_.setRand(liveValue(S::Rand));
+}
+
+void StitcherProcessor::updatePitchFromParams()
+{
+    // Exactly one of the two pitch paths is active; the other sits at 0 st (bypassed)
+    const float semitones = liveValue(ParamSnapshot::PitchShift);
+    const bool  perGrain  = raw_.pitchMode->load() > 0.5f;
+    pitchShift_.setActive(!perGrain);
+    pitchShift_.setSemitones(perGrain ? 0.f : semitones);
+    transposer_.setSemitones(perGrain ? semitones : 0.f);
+    dryDelay_.setDelay(static_cast<float>(grainLatencySamples(perGrain)));
+}
+
+void StitcherProcessor::updateCrushFromParams()
+{
+    bitCrush_.setBits(16.f - liveValue(ParamSnapshot::Crush) * 14.f);
+    bitCrush_.setRate(liveValue(ParamSnapshot::CrushRate));
+    bitCrush_.setAntialiasing(raw_.crushAa->load() > 0.5f);
+}
+
+int StitcherProcessor::grainLatencySamples(bool perGrainPitch) const noexcept
+{
+    return frameSize_ - 1 + (perGrainPitch ? 0 : pitchShift_.getLatencySamples());
+}
+
+int StitcherProcessor::computeLatencySamples(bool perGrainPitch) const noexcept
+{
+    return grainLatencySamples(perGrainPitch) + limiter_.getLatencySamples();
+}
+
+void StitcherProcessor::timerCallback()
+{
+    if (latencyChanged_.exchange(false))
+        setLatencySamples(computeLatencySamples(raw_.pitchMode->load() > 0.5f));
+    if (freezeChanged_.exchange(false))
+        updateCorpusArchive();
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
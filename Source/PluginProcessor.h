@@ -3,15 +3,33 @@
 #include "Parameters.h"
 #include "FeatureExtractor.h"
 #include "CorpusStore.h"
+#include "CorpusArchive.h"
 #include "ConcatenativeMatcher.h"
+#include "MatchEventQueue.h"
+#include "MatchLogWriter.h"
 #include "EQProcessor.h"
 #include "ReverbProcessor.h"
 #include "BitCrushProcessor.h"
 #include "PitchShiftProcessor.h"
+#include "GrainTransposer.h"
 #include "MidiLearn.h"
+#include "RealtimeGuard.h"
+#include "ActivityTracker.h"
+#include "TruePeakLimiter.h"
+#include "ParamRamp.h"
+#include "StageProfiler.h"
+#include "PresetMorpher.h"
+#include "SnapshotHandoff.h"
+#include <optional>
+
+// Build with STITCHER_HEADLESS=1 to leave out the editor (offline renderer, no GUI).
+#ifndef STITCHER_HEADLESS
+ #define STITCHER_HEADLESS 0
+#endif
 
 class StitcherProcessor : public juce::AudioProcessor,
-                          public juce::AudioProcessorValueTreeState::Listener {
+                          public juce::AudioProcessorValueTreeState::Listener,
+                          private juce::Timer {
 public:
     StitcherProcessor();
     ~StitcherProcessor() override;
@@ -42,20 +60,66 @@ public:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts_; }
+
+    // Deterministic mode for offline renders and regression tests: the matcher is reseeded
+    // with this value on every prepareToPlay(). Call before prepareToPlay().
+    void setRandomSeed(juce::int64 seed) { randomSeed_ = seed; }
     MidiLearn& getMidiLearn() { return midiLearn_; }
+    // Glides between presets (message thread). While a morph runs it owns the continuous
+    // parameters: the audio thread takes them from its snapshots, not from the APVTS.
+    PresetMorpher& getMorpher() { return morpher_; }
+    // Per-stage DSP timing, always on (see StageProfiler); read from the message thread.
+    StageProfiler& getProfiler() { return profiler_; }
+
+    // Total latency reported to the host: the grain path (see grainLatencySamples) plus the
+    // output limiter's lookahead.
+    int computeLatencySamples(bool perGrainPitch) const noexcept;
 
     float getLastCtrlZcr()    const noexcept { return lastCtrlZcr_.load(); }
     float getLastCtrlRms()    const noexcept { return lastCtrlRms_.load(); }
     float getLastCtrlSc()     const noexcept { return lastCtrlSc_.load(); }
     float getLastCtrlSt()     const noexcept { return lastCtrlSt_.load(); }
-    float    getLastCorpusFill()   const noexcept { return lastCorpusFill_.load(); }
     int      getLastMatchedIndex() const noexcept { return lastMatchedIndex_.load(); }
     uint32_t getMatchEpoch()       const noexcept { return matchEpoch_.load(); }
     float getLastOutPeakL()      const noexcept { return lastOutPeakL_.load(); }
     float getLastOutPeakR()      const noexcept { return lastOutPeakR_.load(); }
+    // True while every effect stage is skipping silent blocks (dormant instance).
+    bool  isIdle()               const noexcept { return idle_.load(); }
+
+    // Lock-free corpus views (seqlock; never contend with the audio thread).
+    // readCorpusCursor is cheap enough for every UI tick; readCorpusSnapshot copies
+    // the whole feature table and belongs on a background thread for large corpora.
+    bool readCorpusCursor(CorpusCursor& out) const     { return corpus_.readCursor(out); }
+    bool readCorpusSnapshot(CorpusSnapshot& out) const { return corpus_.readSnapshot(out); }
+
+    // Every grain hand-off, in order (wait-free SPSC; the editor is the only consumer).
+    // Events are dropped, not overwritten, while nobody drains — discard before first use.
+    int  popMatchEvents(MatchEvent* dest, int maxEvents) noexcept { return matchEvents_.pop(dest, maxEvents); }
+    void discardMatchEvents() noexcept                           { matchEvents_.drain(); }
+
+    // Optional binary log of every match event, written on a background thread.
+    bool startMatchLog(const juce::File& file) { return matchLog_.start(file, getSampleRate(), frameSize_); }
+    void stopMatchLog()                        { matchLog_.stop(); }
+    bool isMatchLogging() const noexcept       { return matchLog_.isActive(); }
+
+    // Convolution reverb IR (message thread). The path is saved with the session, outside
+    // the parameter tree, and reloaded by setStateInformation(); presets do not carry it.
+    bool       loadImpulseResponse(const juce::File& file);
+    void       clearImpulseResponse();
+    juce::File getImpulseResponseFile() const;
+
+    // Opt-in: while Freeze is on, save the corpus (audio + features) with the session.
+    // It is compressed in the background as soon as the corpus freezes, and decoded in the
+    // background on load, then streamed back into the corpus a few frames per block.
+    // Message thread; the setting is saved with the session, like the IR path.
+    void setEmbedCorpus(bool shouldEmbed);
+    bool getEmbedCorpus() const;
+    // True once no corpus encode or decode is queued or running (tests, offline tools).
+    bool waitForCorpusArchive(int timeoutMs) const { return corpusArchive_.waitUntilIdle(timeoutMs); }
 
 private:
     int frameSize_ = 1024;  // set in prepareToPlay from matchLen parameter
+    std::optional<juce::int64> randomSeed_;   // unset: matcher keeps its time-based seed
     std::atomic<double> lastKnownBpm_ { 120.0 };
 
     juce::UndoManager undoManager_;
@@ -63,14 +127,24 @@ private:
 
     MidiLearn            midiLearn_;
 
+    // Preset morphing: the morpher's steps reach the audio thread through morphHandoff_
+    // and are applied together at the top of the next block.
+    SnapshotHandoff<ParamSnapshot> morphHandoff_;
+    ParamSnapshot                  morphSnapshot_;   // audio thread
+    bool                           morphStepped_ = false;   // audio thread: a step since the last settle
+    std::atomic<bool>              morphActive_ { false };
+    PresetMorpher                  morpher_;
+
     FeatureExtractor     featureExtractor_;
     CorpusStore          corpus_;
     ConcatenativeMatcher matcher_;
     EQProcessor          eq_;
     ReverbProcessor      reverb_;
     PitchShiftProcessor  pitchShift_;
+    GrainTransposer      transposer_;   // pitch_mode = Per Grain
     BitCrushProcessor    bitCrush_;
-    juce::dsp::Limiter<float> limiter_;
+    TruePeakLimiter      limiter_;
+    StageProfiler        profiler_;
 
     // Internal frame accumulation buffers
     std::vector<float> ctrlAccum_;
@@ -94,32 +168,115 @@ private:
     bool                     grainReady_ = false;
     juce::AudioBuffer<float> grainMixBuf_;  // 2-ch, samplesPerBlock — grain staging for grain-only EQ
 
-    // Cached parameter values (atomic for audio-thread safety)
+    // Cached parameter values (atomic for audio-thread safety). The continuous ones are
+    // read once per block into a ParamRamp, never per sample.
     std::atomic<float> gainCtrl_   { 1.f };
     std::atomic<float> gainSrc_    { 1.f };
     std::atomic<float> gainOut_    { 1.f };
     std::atomic<float> mix_        { 1.f };
     std::atomic<bool>  freeze_     { false };
 
+    ParamRamp ctrlGainRamp_;
+    ParamRamp mixRamp_;
+    ParamRamp outGainRamp_;
+    juce::AudioBuffer<float> dryBuf_;   // 2-ch, samplesPerBlock — delayed dry input for the blend
+
+    // Raw parameter values read from processBlock, looked up once in the constructor:
+    // getRawParameterValue() searches by ID string and is not real-time safe.
+    struct RawParams {
+        std::array<std::atomic<float>*, ParamSnapshot::kNumParams> continuous {};   // by ParamSnapshot::Index
+        std::atomic<float>* pitchMode   = nullptr;
+        std::atomic<float>* crushAa     = nullptr;
+        std::atomic<float>* reverbMode  = nullptr;
+    } raw_;
+
     std::atomic<bool> eqDirty_      { false };
     std::atomic<bool> reverbDirty_  { false };
     std::atomic<bool> matcherDirty_ { false };
     std::atomic<bool> pitchDirty_   { false };
     std::atomic<bool> crushDirty_   { false };
 
+    // MIDI CC values reach the audio side through applyMidiValue(), ahead of their host
+    // update (see MidiLearn). A held slot overrides the APVTS value until that update lands
+    // or the parameter is changed elsewhere.
+    std::vector<int> paramSlot_;   // parameter index → ParamSnapshot::Index, or -1
+    std::array<std::atomic<float>, ParamSnapshot::kNumParams> midiValue_ {};
+    std::array<std::atomic<bool>,  ParamSnapshot::kNumParams> midiHeld_ {};
+
     // UI observability — written on audio thread, read by message-thread timer ~30 Hz
     std::atomic<float> lastCtrlZcr_    { 0.f };
     std::atomic<float> lastCtrlRms_    { 0.f };
     std::atomic<float> lastCtrlSc_     { 0.f };
     std::atomic<float> lastCtrlSt_     { 0.f };
-    std::atomic<float>    lastCorpusFill_   { 0.f };
     std::atomic<int>      lastMatchedIndex_ { -1 };
     std::atomic<uint32_t> matchEpoch_       { 0 };
     std::atomic<float> lastOutPeakL_   { 0.f };
     std::atomic<float> lastOutPeakR_   { 0.f };
-    int corpusMaxFrames_ = 1;
 
+    // Match events — visualisation queue (drained by the editor) and file log
+    MatchEventQueue matchEvents_ { 4096 };
+    MatchLogWriter  matchLog_;
+    int64_t         samplePos_ = 0;   // samples processed since prepareToPlay
+
+    // Silent-block fast path: an all-zero frame always has the same features, and each
+    // stateful stage is skipped once its input is silent and its tail has rung out.
+    Features        silentFeatures_;
+    ActivityTracker grainFxActivity_;   // pitch → crush → EQ
+    ActivityTracker reverbActivity_;
+    ActivityTracker limiterActivity_;   // output gain + limiter
+    int             fxTailSamples_ = 0;
+    std::atomic<bool> idle_ { true };
+
+    // Dry main input, delayed to line up with the grains
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay_;
+
+    // Session settings outside the APVTS (see getStateInformation)
+    mutable juce::CriticalSection sessionLock_;
+    juce::File                    irFile_;   // guarded by sessionLock_
+    std::atomic<bool>             embedCorpus_ { false };
+
+    // Embedded corpus. The image restored from a session is swapped under the callback
+    // lock and streamed into corpus_ by the audio thread; its chunk is kept (and saved
+    // again as-is) until Freeze is released. corpusLock_ keeps captures away from
+    // corpus_.prepare(). The archive is declared last: its thread calls back into the rest.
+    static constexpr int kRestoreFramesPerBlock = 8;
+    juce::CriticalSection        corpusLock_;
+    juce::MemoryBlock            restoredChunk_;     // guarded by corpusLock_
+    std::unique_ptr<CorpusImage> restoredCorpus_;    // guarded by the callback lock
+    int                          restorePos_ = 0;    // next frame of restoredCorpus_ to stream in
+    CorpusArchive                corpusArchive_;
+
+    bool captureCorpus(CorpusImage& out, uint64_t& key, bool mayWait);
+    void installRestoredCorpus(std::unique_ptr<CorpusImage> image);
+    void releaseRestoredCorpus();
+    void restoreCorpusChunk(juce::MemoryBlock chunk);
+    void updateCorpusArchive();
+    void streamRestoredCorpus() noexcept;
+
+    void handOffFrame(int64_t eventTime);
+    void renderVoices(float* outL, float* outR, int start, int end) noexcept;
+
+    // Applies a decoded session state (either format) to the APVTS, MIDI learn and IR.
+    void restoreState(juce::ValueTree state);
+
+    void applyParamSnapshot() noexcept;
+    void applyMidiValue(juce::RangedAudioParameter& param, float normalised) noexcept;
+    float liveValue(ParamSnapshot::Index index) const noexcept;   // held MIDI value, else the APVTS
     void updateMatcherFromParams();
+    void updatePitchFromParams();
+    void updateCrushFromParams();
+    void timerCallback() override;   // pushes a latency change to the host; starts corpus encodes
+
+    // parameterChanged() may run on the audio thread (host automation), where posting a
+    // message is not allowed: it raises a flag and the message-thread timer acts on it.
+    static constexpr int kHousekeepingHz = 30;
+    std::atomic<bool> latencyChanged_ { false };
+    std::atomic<bool> freezeChanged_  { false };
+
+    // Grain-path latency: the frame accumulator (a grain starts sounding on the sample that
+    // completes its control frame, so one sample short of a frame) plus the streaming
+    // pitch shifter when it is in use. The dry path is delayed by this much before the blend.
+    int grainLatencySamples(bool perGrainPitch) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StitcherProcessor)
 };
@@ -0,0 +1,331 @@
+#include "PresetCatalogue.h"
+#include <algorithm>
+#include <iterator>
+
+PresetCatalogue::PresetCatalogue(juce::File userDir,
+                                 const std::vector<PresetManager::FactoryPreset>& factory)
+    : juce::Thread("Stitcher preset catalogue"), userDir_(std::move(userDir))
+{
+    for (const auto& fp : factory)
+        factoryEntries_.push_back({ fp.name, fp.category, false });
+    index_ = std::make_shared<const Index>(factoryEntries_);
+
+    scanRequested_ = true;
+    ++busy_;
+    startThread(juce::Thread::Priority::background);
+}
+
+PresetCatalogue::~PresetCatalogue()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);   // a listing of a slow mount checks threadShouldExit() per file
+}
+
+std::shared_ptr<const PresetCatalogue::Index> PresetCatalogue::getIndex() const
+{
+    const juce::ScopedLock sl(lock_);
+    return index_;
+}
+
+const PresetCatalogue::Entry* PresetCatalogue::find(const Index& index, const juce::String& name)
+{
+    for (const auto& e : index)
+        if (e.name == name)
+            return &e;
+    return nullptr;
+}
+
+juce::File PresetCatalogue::fileFor(const juce::String& name) const
+{
+    return userDir_.getChildFile(name + ".xml");
+}
+
+juce::ValueTree PresetCatalogue::readState(const juce::File& file)
+{
+    auto xml = juce::parseXML(file);
+    return xml ? juce::ValueTree::fromXml(*xml) : juce::ValueTree();
+}
+
+juce::ValueTree PresetCatalogue::getUserState(const juce::String& name)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        auto it = states_.find(name);
+        if (it != states_.end())
+            return it->second.state;
+    }
+
+    const auto file = fileFor(name);
+    if (!file.existsAsFile())
+        return {};
+    const auto modified = file.getLastModificationTime();
+    auto state = readState(file);
+    if (state.isValid()) {
+        const juce::ScopedLock sl(lock_);
+        states_[name] = { modified, state };
+    }
+    return state;
+}
+
+void PresetCatalogue::prefetchAround(const juce::String& name)
+{
+    const auto index = getIndex();
+    const int n = static_cast<int>(index->size());
+    int at = -1;
+    for (int i = 0; i < n && at < 0; ++i)
+        if ((*index)[static_cast<size_t>(i)].name == name)
+            at = i;
+    if (at < 0)
+        return;
+
+    juce::StringArray names;
+    for (int d = -kPrefetchRadius; d <= kPrefetchRadius; ++d) {
+        const auto& e = (*index)[static_cast<size_t>(((at + d) % n + n) % n)];
+        if (e.isUser)
+            names.addIfNotAlreadyThere(e.name);
+    }
+
+    {
+        const juce::ScopedLock sl(lock_);
+        prefetchNames_ = std::move(names);
+        if (!prefetchRequested_) {
+            prefetchRequested_ = true;
+            ++busy_;
+        }
+    }
+    notify();
+}
+
+juce::StringArray PresetCatalogue::search(const juce::String& query, int maxResults) const
+{
+    const auto index = getIndex();
+    std::vector<std::pair<int, int>> scored;   // (score, position in index)
+    for (size_t i = 0; i < index->size(); ++i) {
+        const int score = fuzzyScore(query, (*index)[i].name);
+        if (score >= 0)
+            scored.emplace_back(score, static_cast<int>(i));
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    juce::StringArray names;
+    for (const auto& s : scored) {
+        if (names.size() >= maxResults)
+            break;
+        names.add((*index)[static_cast<size_t>(s.second)].name);
+    }
+    return names;
+}
+
+int PresetCatalogue::fuzzyScore(const juce::String& query, const juce::String& candidate)
+{
+    const auto lowerQuery     = query.toLowerCase();
+    const auto lowerCandidate = candidate.toLowerCase();
+
+    juce::Array<juce::juce_wchar> q;
+    for (auto p = lowerQuery.getCharPointer(); !p.isEmpty();) {
+        const auto c = p.getAndAdvance();
+        if (!juce::CharacterFunctions::isWhitespace(c))
+            q.add(c);
+    }
+    if (q.isEmpty())
+        return 0;
+
+    int score = 0, matched = 0, run = 0, length = 0;
+    juce::juce_wchar prev = ' ';
+    for (auto p = lowerCandidate.getCharPointer(); !p.isEmpty(); ++length) {
+        const auto c = p.getAndAdvance();
+        if (matched < q.size() && c == q[matched]) {
+            ++matched;
+            score += 1 + 2 * run;                              // consecutive runs
+            if (!juce::CharacterFunctions::isLetterOrDigit(prev))
+                score += 5;                                    // word start
+            ++run;
+        } else {
+            run = 0;
+        }
+        prev = c;
+    }
+    if (matched < q.size())
+        return -1;
+    return std::max(0, score * 4 - (length - matched));        // shorter names win ties
+}
+
+void PresetCatalogue::publish(std::shared_ptr<const Index> index)
+{
+    // lock_ held by the caller
+    index_ = std::move(index);
+    for (auto it = states_.begin(); it != states_.end();) {
+        auto file = userFiles_.find(it->first);
+        const bool stale = file == userFiles_.end() || file->second != it->second.modified;
+        it = stale ? states_.erase(it) : std::next(it);
+    }
+}
+
+void PresetCatalogue::userPresetSaved(const juce::String& name, juce::ValueTree state)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        ++editCount_;
+        auto index = std::make_shared<Index>(*index_);
+        if (find(*index, name) == nullptr) {
+            Entry entry { name, {}, true };
+            auto pos = std::upper_bound(index->begin() + static_cast<std::ptrdiff_t>(factoryEntries_.size()),
+                                        index->end(), entry, [](const Entry& a, const Entry& b) {
+                                            return a.name.compare(b.name) < 0;   // as StringArray::sort(false)
+                                        });
+            index->insert(pos, entry);
+        }
+        const auto modified = fileFor(name).getLastModificationTime();
+        userFiles_[name] = modified;
+        states_[name]    = { modified, std::move(state) };
+        publish(std::move(index));
+    }
+    rescan();
+}
+
+void PresetCatalogue::userPresetDeleted(const juce::String& name)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        ++editCount_;
+        auto index = std::make_shared<Index>(*index_);
+        index->erase(std::remove_if(index->begin(), index->end(),
+                                    [&name](const Entry& e) { return e.isUser && e.name == name; }),
+                     index->end());
+        userFiles_.erase(name);
+        publish(std::move(index));
+    }
+    rescan();
+}
+
+void PresetCatalogue::rescan()
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        if (!scanRequested_) {
+            scanRequested_ = true;
+            ++busy_;
+        }
+    }
+    notify();
+}
+
+bool PresetCatalogue::waitUntilIdle(int timeoutMs) const
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+    while (busy_.load() > 0) {
+        if (juce::Time::getMillisecondCounter() >= deadline)
+            return false;
+        juce::Thread::sleep(1);
+    }
+    return true;
+}
+
+bool PresetCatalogue::isCached(const juce::String& name) const
+{
+    const juce::ScopedLock sl(lock_);
+    return states_.count(name) > 0;
+}
+
+void PresetCatalogue::scan()
+{
+    uint64_t editCount;
+    {
+        const juce::ScopedLock sl(lock_);
+        editCount = editCount_;
+    }
+
+    std::map<juce::String, juce::Time> files;
+    for (const auto& f : juce::RangedDirectoryIterator(userDir_, false, "*.xml", juce::File::findFiles)) {
+        if (threadShouldExit())
+            return;
+        files[f.getFile().getFileNameWithoutExtension()] = f.getModificationTime();
+    }
+
+    juce::StringArray userNames;
+    for (const auto& f : files) {
+        const bool shadowed = std::any_of(factoryEntries_.begin(), factoryEntries_.end(),
+                                          [&f](const Entry& e) { return e.name == f.first; });
+        if (!shadowed)
+            userNames.add(f.first);
+    }
+    userNames.sort(false);
+
+    auto index = std::make_shared<Index>(factoryEntries_);
+    for (const auto& name : userNames)
+        index->push_back({ name, {}, true });
+
+    const juce::ScopedLock sl(lock_);
+    if (editCount != editCount_)
+        return;   // an edit landed mid-listing and queued another scan
+    userFiles_ = std::move(files);
+    publish(std::move(index));
+}
+
+void PresetCatalogue::prefetch()
+{
+    juce::StringArray names;
+    {
+        const juce::ScopedLock sl(lock_);
+        names = prefetchNames_;
+    }
+
+    for (const auto& name : names) {
+        if (threadShouldExit())
+            return;
+        juce::Time modified;
+        {
+            const juce::ScopedLock sl(lock_);
+            if (states_.count(name) > 0)
+                continue;
+            auto it = userFiles_.find(name);
+            if (it == userFiles_.end())
+                continue;
+            modified = it->second;
+        }
+
+        auto state = readState(fileFor(name));
+        if (!state.isValid())
+            continue;
+
+        const juce::ScopedLock sl(lock_);
+        auto it = userFiles_.find(name);
+        if (it != userFiles_.end() && it->second == modified)
+            states_[name] = { modified, std::move(state) };
+    }
+
+    // Keep the cache to the browsing window once it has grown past its budget
+    const juce::ScopedLock sl(lock_);
+    for (auto it = states_.begin(); it != states_.end() && states_.size() > static_cast<size_t>(kMaxCachedStates);)
+        it = names.contains(it->first) ? std::next(it) : states_.erase(it);
+}
+
+void PresetCatalogue::run()
+{
+    juce::Time dirModified;
+    while (!threadShouldExit()) {
+        bool scanDue = false, prefetchDue = false;
+        {
+            const juce::ScopedLock sl(lock_);
+            std::swap(scanDue, scanRequested_);
+            std::swap(prefetchDue, prefetchRequested_);
+        }
+
+        const auto modified = userDir_.getLastModificationTime();
+        const bool changed  = modified != dirModified;
+        dirModified = modified;
+
+        if (scanDue || changed)
+            scan();
+        if (scanDue)
+            --busy_;
+        if (prefetchDue) {
+            prefetch();
+            --busy_;
+        }
+
+        wait(kPollIntervalMs);
+    }
+}
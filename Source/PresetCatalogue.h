@@ -0,0 +1,96 @@
+#pragma once
+#include "PresetManager.h"
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * PresetCatalogue — in-memory index of the factory and user presets, kept current by a
+ * background thread so browsing never touches the disk on the message thread.
+ *
+ * The thread lists the user preset directory, then polls the directory's modification
+ * time every kPollIntervalMs and re-lists it when it moves. JUCE has no portable file
+ * watcher; polling one stat is cheap even on a network mount, and PresetManager saves
+ * through a temp file and rename, so edits by other instances move the directory time
+ * too. Between listings, savePreset/deletePreset on this instance patch the index
+ * directly.
+ *
+ * Parsed user preset states are cached by name. prefetchAround() asks the thread to parse
+ * the kPrefetchRadius presets either side of the one just loaded, so next/prev finds its
+ * state ready; a cache miss parses on the calling thread as before.
+ *
+ * Thread model: every public method is for the message thread (or any non-audio thread).
+ */
+class PresetCatalogue : private juce::Thread {
+public:
+    static constexpr int kPollIntervalMs   = 2000;
+    static constexpr int kPrefetchRadius   = 2;
+    static constexpr int kMaxCachedStates  = 32;
+
+    struct Entry {
+        juce::String name;
+        juce::String category;   // factory category; empty for user presets
+        bool         isUser = false;
+    };
+    // Factory presets in list order, then user presets sorted by name. A user preset with a
+    // factory preset's name is left out.
+    using Index = std::vector<Entry>;
+
+    PresetCatalogue(juce::File userDir, const std::vector<PresetManager::FactoryPreset>& factory);
+    ~PresetCatalogue() override;
+
+    std::shared_ptr<const Index> getIndex() const;
+    static const Entry* find(const Index& index, const juce::String& name);
+
+    // Parsed state of a user preset: from the cache if it is there, otherwise read from
+    // disk now. Invalid tree if the file is missing or unreadable.
+    juce::ValueTree getUserState(const juce::String& name);
+    void prefetchAround(const juce::String& name);
+
+    // Up to maxResults preset names, best fuzzy match first (see fuzzyScore).
+    juce::StringArray search(const juce::String& query, int maxResults) const;
+
+    // Index patches for this instance's own edits; a rescan follows to confirm them.
+    void userPresetSaved(const juce::String& name, juce::ValueTree state);
+    void userPresetDeleted(const juce::String& name);
+    void rescan();
+
+    // True once no listing or prefetch is queued or running (tests).
+    bool waitUntilIdle(int timeoutMs) const;
+    bool isCached(const juce::String& name) const;
+
+    // Case-insensitive subsequence match of the query's non-space characters: -1 if some
+    // character is missing, otherwise higher for matches at word starts, consecutive runs
+    // and shorter names.
+    static int fuzzyScore(const juce::String& query, const juce::String& candidate);
+
+private:
+    struct CachedState {
+        juce::Time      modified;
+        juce::ValueTree state;
+    };
+
+    void run() override;
+    void scan();
+    void prefetch();
+    void publish(std::shared_ptr<const Index> index);
+    juce::File fileFor(const juce::String& name) const;
+    static juce::ValueTree readState(const juce::File& file);
+
+    const juce::File   userDir_;
+    std::vector<Entry> factoryEntries_;
+
+    juce::CriticalSection                 lock_;   // guards everything below
+    std::shared_ptr<const Index>          index_;
+    std::map<juce::String, juce::Time>    userFiles_;   // last listing
+    std::map<juce::String, CachedState>   states_;
+    juce::StringArray                     prefetchNames_;
+    bool                                  scanRequested_ = false;
+    bool                                  prefetchRequested_ = false;
+    uint64_t                              editCount_ = 0;   // bumped by local edits; stale listings are dropped
+
+    std::atomic<int> busy_ { 0 };   // requests queued or running
+};
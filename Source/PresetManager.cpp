@@ -1,4 +1,6 @@
 #include "PresetManager.h"
+#include "PresetCatalogue.h"
+#include "PresetMorpher.h"
 
 juce::File PresetManager::getUserPresetsDir()
 {
@@ -14,6 +16,24 @@ PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts,
     : apvts_(apvts), presetsDir_(presetsDir), factoryPresets_(std::move(factoryPresets))
 {
     presetsDir_.createDirectory();
+    for (auto& fp : factoryPresets_)
+        if (!fp.state.isValid())
+            fp.state = parseState(fp.xml);
+}
+
+PresetManager::~PresetManager() = default;
+
+PresetCatalogue& PresetManager::catalogue() const
+{
+    if (catalogue_ == nullptr)
+        catalogue_ = std::make_unique<PresetCatalogue>(presetsDir_, factoryPresets_);
+    return *catalogue_;
+}
+
+juce::ValueTree PresetManager::parseState(const juce::String& xmlString)
+{
+    auto xml = juce::parseXML(xmlString);
+    return xml ? juce::ValueTree::fromXml(*xml) : juce::ValueTree();
 }
 
 void PresetManager::savePreset(const juce::String& name)
@@ -24,36 +44,44 @@ void PresetManager::savePreset(const juce::String& name)
     auto xml = apvts_.copyState().createXml();
     if (!xml) return;
     presetsDir_.createDirectory();
-    if (presetsDir_.getChildFile(name + ".xml").replaceWithText(xml->toString()))
+    if (presetsDir_.getChildFile(name + ".xml").replaceWithText(xml->toString())) {
         currentPresetName_ = name;
+        catalogue().userPresetSaved(name, juce::ValueTree::fromXml(*xml));
+    }
 }
 
-bool PresetManager::loadFromXmlString(const juce::String& xmlString, const juce::String& name)
+bool PresetManager::loadState(const juce::ValueTree& state, const juce::String& name)
 {
-    auto xml = juce::parseXML(xmlString);
-    if (!xml) return false;
-    auto tree = juce::ValueTree::fromXml(*xml);
-    if (!tree.isValid()) return false;
-    apvts_.replaceState(tree);
+    if (!state.isValid()) return false;
+    if (morpher_ != nullptr && morphSeconds_ > 0.0) {
+        morpher_->morphTo(state, morphSeconds_);
+    } else {
+        if (morpher_ != nullptr)
+            morpher_->stop();   // a running morph would pull the parameters back
+        // The APVTS adopts and edits the tree it is given: hand it a copy so cached factory
+        // states stay untouched.
+        apvts_.replaceState(state.createCopy());
+    }
     currentPresetName_ = name;
     return true;
 }
 
 bool PresetManager::loadPreset(const juce::String& name)
 {
+    juce::ValueTree state;
     for (const auto& fp : factoryPresets_)
     {
         if (fp.name == name)
-            return loadFromXmlString(fp.xml, name);
+            state = fp.state;
     }
-    auto file = presetsDir_.getChildFile(name + ".xml");
-    if (!file.existsAsFile()) return false;
-    auto xml = juce::parseXML(file);
-    if (!xml) return false;
-    auto tree = juce::ValueTree::fromXml(*xml);
-    if (!tree.isValid()) return false;
-    apvts_.replaceState(tree);
-    currentPresetName_ = name;
+    if (!state.isValid()) {
+        state = catalogue_ != nullptr
+              ? catalogue_->getUserState(name)
+              : parseState(presetsDir_.getChildFile(name + ".xml").loadFileAsString());
+    }
+    if (!loadState(state, name)) return false;
+    if (catalogue_ != nullptr)
+        catalogue_->prefetchAround(name);   // next/prev will find their states parsed
     return true;
 }
 
@@ -61,12 +89,15 @@ void PresetManager::deletePreset(const juce::String& name)
 {
     if (name.isEmpty()) return;
     presetsDir_.getChildFile(name + ".xml").deleteFile();
+    catalogue().userPresetDeleted(name);
     if (currentPresetName_ == name)
         currentPresetName_ = {};
 }
 
 void PresetManager::initPreset()
 {
+    if (morpher_ != nullptr)
+        morpher_->stop();
     for (auto* param : apvts_.processor.getParameters())
         param->setValueNotifyingHost(param->getDefaultValue());
     currentPresetName_ = {};
@@ -75,22 +106,25 @@ void PresetManager::initPreset()
 juce::StringArray PresetManager::getPresetNames() const
 {
     juce::StringArray names;
-    for (const auto& fp : factoryPresets_)
-        names.add(fp.name);
-    for (const auto& n : getUserPresetNames())
-        names.addIfNotAlreadyThere(n);
+    for (const auto& e : *catalogue().getIndex())
+        names.add(e.name);
     return names;
 }
 
 juce::StringArray PresetManager::getUserPresetNames() const
 {
     juce::StringArray names;
-    for (auto& f : presetsDir_.findChildFiles(juce::File::findFiles, false, "*.xml"))
-        names.add(f.getFileNameWithoutExtension());
-    names.sort(false);
+    for (const auto& e : *catalogue().getIndex())
+        if (e.isUser)
+            names.add(e.name);
     return names;
 }
 
+juce::StringArray PresetManager::searchPresets(const juce::String& query, int maxResults) const
+{
+    return catalogue().search(query, maxResults);
+}
+
 juce::StringArray PresetManager::getCategoryNames() const
 {
     juce::StringArray cats;
@@ -116,6 +150,11 @@ juce::String PresetManager::getCurrentPresetName() const
 bool PresetManager::isCurrentPresetUser() const
 {
     if (currentPresetName_.isEmpty()) return false;
+    if (catalogue_ != nullptr) {
+        if (const auto* e = PresetCatalogue::find(*catalogue_->getIndex(), currentPresetName_))
+            return e->isUser;
+    }
+    // Not browsed yet, or loaded before the first listing finished
     return presetsDir_.getChildFile(currentPresetName_ + ".xml").existsAsFile();
 }
 
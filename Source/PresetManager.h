@@ -2,19 +2,30 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
+#include <memory>
 #include <vector>
 
+class PresetCatalogue;
+class PresetMorpher;
+
+// Saves, loads and lists presets. Listing and next/prev go through a PresetCatalogue, so
+// they read an in-memory index instead of the user preset directory. The catalogue (and
+// its thread) is created on the first browse, search, save or delete, so a manager that
+// only loads a preset, as in the offline renderer, never lists the directory.
 class PresetManager {
 public:
     struct FactoryPreset {
         juce::String name;
         juce::String category;
         juce::String xml;
+        juce::ValueTree state;   // parsed xml; filled in by the constructor if left empty.
+                                 // Shared between copies and never modified.
     };
 
     explicit PresetManager(juce::AudioProcessorValueTreeState& apvts,
                            juce::File presetsDir = getUserPresetsDir(),
                            std::vector<FactoryPreset> factoryPresets = {});
+    ~PresetManager();
 
     void savePreset(const juce::String& name);
     void deletePreset(const juce::String& name);
@@ -35,12 +46,28 @@ public:
 
     static juce::File getUserPresetsDir();
     juce::StringArray getUserPresetNames() const;
+    // Factory and user preset names ranked by fuzzy match against `query`.
+    juce::StringArray searchPresets(const juce::String& query, int maxResults = 20) const;
+    PresetCatalogue& getCatalogue() { return catalogue(); }
+    bool hasCatalogue() const { return catalogue_ != nullptr; }   // tests
+
+    // With a morpher and a non-zero time, loading a preset glides to it instead of jumping.
+    void   setMorpher(PresetMorpher* morpher) { morpher_ = morpher; }
+    void   setMorphTime(double seconds)       { morphSeconds_ = seconds; }
+    double getMorphTime() const               { return morphSeconds_; }
+
+    // Parses a preset's XML into a state tree (invalid tree on failure).
+    static juce::ValueTree parseState(const juce::String& xml);
 
 private:
-    bool loadFromXmlString(const juce::String& xml, const juce::String& name);
+    bool loadState(const juce::ValueTree& state, const juce::String& name);
+    PresetCatalogue& catalogue() const;
 
     juce::AudioProcessorValueTreeState& apvts_;
     juce::File presetsDir_;
     juce::String currentPresetName_;
     std::vector<FactoryPreset> factoryPresets_;
+    mutable std::unique_ptr<PresetCatalogue> catalogue_;   // see catalogue()
+    PresetMorpher* morpher_      = nullptr;
+    double         morphSeconds_ = 0.0;
 };
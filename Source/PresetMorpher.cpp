@@ -0,0 +1,197 @@
+#include "PresetMorpher.h"
+#include <algorithm>
+#include <cmath>
+
+PresetMorpher::PresetMorpher(juce::AudioProcessorValueTreeState& apvts, SnapshotFn onSnapshot)
+    : apvts_(apvts), onSnapshot_(std::move(onSnapshot))
+{
+    snapshotParam_.fill(-1);
+    for (auto* p : apvts_.processor.getParameters()) {
+        auto* rp = dynamic_cast<juce::RangedAudioParameter*>(p);
+        if (rp == nullptr)
+            continue;
+        const int slot = ParamSnapshot::indexOf(rp->getParameterID());
+        if (slot >= 0)
+            snapshotParam_[static_cast<size_t>(slot)] = static_cast<int>(params_.size());
+        continuous_.push_back(slot >= 0);
+        params_.push_back(rp);
+    }
+    // Every snapshot ID must be a parameter
+    jassert(std::find(snapshotParam_.begin(), snapshotParam_.end(), -1) == snapshotParam_.end());
+}
+
+PresetMorpher::~PresetMorpher()
+{
+    stopTimer();
+}
+
+PresetMorpher::Values PresetMorpher::currentValues() const
+{
+    Values v;
+    v.reserve(params_.size());
+    for (auto* p : params_)
+        v.push_back(p->convertFrom0to1(p->getValue()));
+    return v;
+}
+
+PresetMorpher::Values PresetMorpher::stateValues(const juce::ValueTree& state) const
+{
+    auto v = currentValues();
+    if (!state.isValid())
+        return v;
+    for (size_t i = 0; i < params_.size(); ++i) {
+        const auto child = state.getChildWithProperty("id", params_[i]->getParameterID());
+        if (child.isValid() && child.hasProperty("value"))
+            v[i] = params_[i]->getNormalisableRange().snapToLegalValue(static_cast<float>(child["value"]));
+    }
+    return v;
+}
+
+void PresetMorpher::morphTo(const juce::ValueTree& target, double seconds)
+{
+    from_     = mode_ == Mode::Idle ? currentValues() : evaluate();   // retarget mid-morph
+    to_       = stateValues(target);
+    duration_ = std::max(0.0, seconds);
+    elapsed_  = 0.0;
+    start(Mode::Glide);
+    if (duration_ == 0.0)
+        advance(0.0);   // jump now, still through a single snapshot
+}
+
+void PresetMorpher::setCorners(const std::array<juce::ValueTree, 4>& corners)
+{
+    for (size_t c = 0; c < corners_.size(); ++c)
+        corners_[c] = stateValues(corners[c]);
+    padMoved_ = true;
+    start(Mode::Pad);
+}
+
+void PresetMorpher::setPosition(float x, float y)
+{
+    padX_ = juce::jlimit(0.f, 1.f, x);
+    padY_ = juce::jlimit(0.f, 1.f, y);
+    padMoved_ = true;
+}
+
+void PresetMorpher::stop()
+{
+    if (mode_ == Mode::Idle)
+        return;
+    emit(true);
+}
+
+double PresetMorpher::getProgress() const noexcept
+{
+    if (mode_ != Mode::Glide || duration_ <= 0.0)
+        return 1.0;
+    return std::min(1.0, elapsed_ / duration_);
+}
+
+void PresetMorpher::start(Mode mode)
+{
+    if (!gestureOpen_) {
+        for (size_t i = 0; i < params_.size(); ++i)
+            if (continuous_[i])
+                params_[i]->beginChangeGesture();
+        gestureOpen_ = true;
+    }
+    mode_ = mode;
+    sinceHostSync_ = 0.0;
+    startTimerHz(kSnapshotHz);
+}
+
+PresetMorpher::Values PresetMorpher::evaluate() const
+{
+    if (mode_ == Mode::Glide) {
+        if (getProgress() >= 1.0)
+            return to_;
+        const auto t = static_cast<float>(getProgress());
+        const float s = t * t * (3.f - 2.f * t);   // smoothstep
+        Values v = from_;
+        for (size_t i = 0; i < v.size(); ++i)
+            if (continuous_[i])
+                v[i] += s * (to_[i] - from_[i]);
+        return v;
+    }
+
+    if (mode_ == Mode::Pad) {
+        const std::array<float, 4> w { (1.f - padX_) * (1.f - padY_), padX_ * (1.f - padY_),
+                                       (1.f - padX_) * padY_,         padX_ * padY_ };
+        const auto dominant = static_cast<size_t>(std::max_element(w.begin(), w.end()) - w.begin());
+        Values v = corners_[dominant];
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (!continuous_[i])
+                continue;
+            float sum = 0.f;
+            for (size_t c = 0; c < w.size(); ++c)
+                sum += w[c] * corners_[c][i];
+            v[i] = sum;
+        }
+        return v;
+    }
+
+    return currentValues();
+}
+
+void PresetMorpher::advance(double seconds)
+{
+    if (mode_ == Mode::Idle)
+        return;
+    sinceHostSync_ += seconds;
+
+    if (mode_ == Mode::Glide) {
+        elapsed_ += seconds;
+        emit(getProgress() >= 1.0);
+    } else if (padMoved_) {
+        padMoved_ = false;
+        emit(false);
+    }
+}
+
+void PresetMorpher::timerCallback()
+{
+    advance(1.0 / kSnapshotHz);
+}
+
+void PresetMorpher::emit(bool settled)
+{
+    const auto values = evaluate();
+    ParamSnapshot snapshot;
+    for (size_t k = 0; k < snapshot.values.size(); ++k)
+        snapshot.values[k] = values[static_cast<size_t>(snapshotParam_[k])];
+    snapshot.settled = settled;
+
+    if (!settled) {
+        onSnapshot_(snapshot, false);
+        if (sinceHostSync_ >= 1.0 / kHostSyncHz) {
+            sinceHostSync_ = 0.0;
+            syncHost(values, mode_ == Mode::Pad);
+        }
+        return;
+    }
+
+    // The host parameters reach their final values while the processor still ignores them,
+    // then the last snapshot hands the audio side back to the parameters.
+    stopTimer();
+    syncHost(values, true);
+    if (gestureOpen_) {
+        for (size_t i = 0; i < params_.size(); ++i)
+            if (continuous_[i])
+                params_[i]->endChangeGesture();
+        gestureOpen_ = false;
+    }
+    mode_ = Mode::Idle;
+    onSnapshot_(snapshot, true);
+}
+
+void PresetMorpher::syncHost(const Values& values, bool includeSwitches)
+{
+    for (size_t i = 0; i < params_.size(); ++i) {
+        if (!continuous_[i] && !includeSwitches)
+            continue;
+        auto* p = params_[i];
+        const float normalised = p->convertTo0to1(values[i]);
+        if (std::abs(normalised - p->getValue()) > 1.0e-6f)
+            p->setValueNotifyingHost(normalised);
+    }
+}
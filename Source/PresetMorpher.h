@@ -0,0 +1,86 @@
+#pragma once
+#include "ParamSnapshot.h"
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <functional>
+#include <vector>
+
+/**
+ * PresetMorpher — moves the plugin between parameter states along a trajectory instead
+ * of jumping with replaceState().
+ *
+ *   morphTo()       glides from the current parameters to a state over a set time, on a
+ *                   smoothstep curve so the trajectory starts and ends at rest.
+ *   setCorners() +  bilinear blend of up to four states on an XY pad; corners in the order
+ *   setPosition()   bottom-left, bottom-right, top-left, top-right.
+ *
+ * Continuous parameters are interpolated in their plain units. Switches and load-time
+ * parameters have no in-between: they take the target's value when a morphTo() settles,
+ * and the dominant corner's value on the pad.
+ *
+ * A timer evaluates the trajectory kSnapshotHz times a second and hands each step to the
+ * SnapshotFn as one ParamSnapshot; the processor passes it to the audio thread in a single
+ * lock-free handoff and applies it in one place. The host-visible parameters follow at
+ * kHostSyncHz, inside one change gesture per morph, so automation and knobs track the morph
+ * without a listener callback per parameter per step.
+ *
+ * Thread model: message thread only.
+ */
+class PresetMorpher : private juce::Timer {
+public:
+    static constexpr int kSnapshotHz = 60;
+    static constexpr int kHostSyncHz = 15;
+
+    // Receives every step; `settled` marks the last one of a morph.
+    using SnapshotFn = std::function<void(const ParamSnapshot& snapshot, bool settled)>;
+
+    PresetMorpher(juce::AudioProcessorValueTreeState& apvts, SnapshotFn onSnapshot);
+    ~PresetMorpher() override;
+
+    // `target` is a preset or APVTS state tree; parameters it lacks keep their value.
+    void morphTo(const juce::ValueTree& target, double seconds);
+
+    // Invalid trees stand for the parameters as they are now.
+    void setCorners(const std::array<juce::ValueTree, 4>& corners);
+    void setPosition(float x, float y);   // each in [0, 1]
+
+    // Settles where the trajectory is now.
+    void stop();
+
+    bool   isMorphing() const noexcept { return mode_ != Mode::Idle; }
+    double getProgress() const noexcept;   // morphTo() only: 0 .. 1
+
+    // Moves a morphTo() on by `seconds` (or applies a pending pad position) and emits one
+    // step. The timer calls this; offline tools and tests may drive it directly.
+    void advance(double seconds);
+
+private:
+    enum class Mode { Idle, Glide, Pad };
+    using Values = std::vector<float>;   // plain value per entry of params_
+
+    void   timerCallback() override;
+    void   start(Mode mode);
+    Values currentValues() const;
+    Values stateValues(const juce::ValueTree& state) const;
+    Values evaluate() const;
+    void   emit(bool settled);
+    void   syncHost(const Values& values, bool includeSwitches);
+
+    juce::AudioProcessorValueTreeState& apvts_;
+    SnapshotFn                          onSnapshot_;
+
+    std::vector<juce::RangedAudioParameter*> params_;
+    std::vector<bool>                        continuous_;          // carried by ParamSnapshot
+    std::array<int, ParamSnapshot::kNumParams> snapshotParam_ {};  // index into params_
+
+    Mode   mode_ = Mode::Idle;
+    Values from_, to_;
+    double duration_ = 0.0, elapsed_ = 0.0;
+    std::array<Values, 4> corners_;
+    float  padX_ = 0.f, padY_ = 0.f;
+    bool   padMoved_ = false;
+    double sinceHostSync_ = 0.0;
+    bool   gestureOpen_ = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetMorpher)
+};
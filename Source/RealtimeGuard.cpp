@@ -0,0 +1,118 @@
+#include "RealtimeGuard.h"
+#include <atomic>
+
+#if defined(__has_include)
+ #if __has_include(<execinfo.h>)
+  #include <execinfo.h>
+  #include <cstdlib>
+  #define STITCHER_HAS_BACKTRACE 1
+ #endif
+#endif
+#ifndef STITCHER_HAS_BACKTRACE
+ #define STITCHER_HAS_BACKTRACE 0
+#endif
+
+namespace {
+// Constant-initialised so the interposers can read them before/without TLS setup calls.
+thread_local int  guardDepth = 0;
+thread_local bool reporting  = false;
+
+RealtimeGuard::Violation violations[RealtimeGuard::kMaxViolations];
+std::atomic<int>         numReported { 0 };   // slots claimed (may exceed kMaxViolations)
+std::atomic<int>         numStored   { 0 };   // slots fully written
+
+int captureStack(void** frames, int maxFrames) noexcept
+{
+#if STITCHER_HAS_BACKTRACE
+    return ::backtrace(frames, maxFrames);
+#else
+    (void) frames; (void) maxFrames;
+    return 0;
+#endif
+}
+} // namespace
+
+#if STITCHER_RT_GUARD
+RealtimeGuard::RealtimeGuard() noexcept  { ++guardDepth; }
+RealtimeGuard::~RealtimeGuard() noexcept { --guardDepth; }
+#endif
+
+RealtimeGuard::ScopedSuspend::ScopedSuspend() noexcept : savedDepth_(guardDepth)
+{
+    guardDepth = 0;
+}
+
+RealtimeGuard::ScopedSuspend::~ScopedSuspend() noexcept
+{
+    guardDepth = savedDepth_;
+}
+
+bool RealtimeGuard::isGuarded() noexcept
+{
+    return guardDepth > 0 && !reporting;
+}
+
+void RealtimeGuard::report(Kind kind, const char* call) noexcept
+{
+    if (reporting) return;
+    reporting = true;   // backtrace() itself may allocate on first use
+
+    const int slot = numReported.fetch_add(1, std::memory_order_relaxed);
+    if (slot < kMaxViolations) {
+        auto& v = violations[slot];
+        v.kind      = kind;
+        v.call      = call;
+        v.numFrames = captureStack(v.frames, kMaxFrames);
+        numStored.fetch_add(1, std::memory_order_release);
+    }
+
+    reporting = false;
+}
+
+int RealtimeGuard::getNumViolations() noexcept
+{
+    return numReported.load(std::memory_order_relaxed);
+}
+
+bool RealtimeGuard::getViolation(int index, Violation& out) noexcept
+{
+    if (index < 0 || index >= numStored.load(std::memory_order_acquire))
+        return false;
+    out = violations[index];
+    return true;
+}
+
+void RealtimeGuard::clearViolations() noexcept
+{
+    // Warm up the unwinder here, outside any guard, so its lazy loading is not
+    // mistaken for a violation later.
+    void* warm[2];
+    captureStack(warm, 2);
+
+    numStored.store(0, std::memory_order_relaxed);
+    numReported.store(0, std::memory_order_release);
+}
+
+const char* RealtimeGuard::kindName(Kind kind) noexcept
+{
+    switch (kind) {
+        case Kind::Allocation:   return "allocation";
+        case Kind::Deallocation: return "deallocation";
+        case Kind::Lock:         return "lock";
+        case Kind::Syscall:      return "syscall";
+    }
+    return "?";
+}
+
+std::string RealtimeGuard::describe(const Violation& v)
+{
+    std::string s = std::string(kindName(v.kind)) + " on audio thread: " + v.call + "\n";
+#if STITCHER_HAS_BACKTRACE
+    if (char** symbols = ::backtrace_symbols(v.frames, v.numFrames)) {
+        for (int i = 0; i < v.numFrames; ++i)
+            s += "  #" + std::to_string(i) + " " + symbols[i] + "\n";
+        std::free(symbols);
+    }
+#endif
+    return s;
+}
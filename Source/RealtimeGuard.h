@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Build with STITCHER_RT_GUARD=1 to mark processBlock as a real-time region. On its own
+// the guard only flags the thread; violations are detected by the call interposers in
+// RealtimeGuardHooks.cpp, which are linked into test executables only (interposing
+// malloc from inside a plugin binary would hook the host too).
+#ifndef STITCHER_RT_GUARD
+ #define STITCHER_RT_GUARD 0
+#endif
+
+/**
+ * RealtimeGuard — scoped marker for code that must not allocate, lock or block.
+ *
+ * While a guard is alive on a thread, every intercepted call made from that thread
+ * (malloc/free/new/delete, mutex locks, blocking syscalls) is recorded as a Violation
+ * with a raw stack trace. Recording is wait-free and allocation-free; symbolising the
+ * trace (describe()) allocates and belongs on a non-real-time thread.
+ *
+ * With STITCHER_RT_GUARD=0 the constructor and destructor are empty and inline.
+ */
+class RealtimeGuard {
+public:
+    enum class Kind { Allocation, Deallocation, Lock, Syscall };
+
+    static constexpr int kMaxFrames     = 32;
+    static constexpr int kMaxViolations = 64;   // further violations are counted, not stored
+
+    struct Violation {
+        Kind        kind      = Kind::Allocation;
+        const char* call      = "";             // intercepted function name (static string)
+        int         numFrames = 0;
+        void*       frames[kMaxFrames] {};
+    };
+
+#if STITCHER_RT_GUARD
+    RealtimeGuard() noexcept;
+    ~RealtimeGuard() noexcept;
+#else
+    RealtimeGuard() noexcept {}
+    ~RealtimeGuard() noexcept {}
+#endif
+    RealtimeGuard(const RealtimeGuard&)            = delete;
+    RealtimeGuard& operator=(const RealtimeGuard&) = delete;
+
+    // Lifts the guard on this thread for a deliberate, reviewed exception.
+    class ScopedSuspend {
+    public:
+        ScopedSuspend() noexcept;
+        ~ScopedSuspend() noexcept;
+        ScopedSuspend(const ScopedSuspend&)            = delete;
+        ScopedSuspend& operator=(const ScopedSuspend&) = delete;
+    private:
+        int savedDepth_;
+    };
+
+    // ── Interposer API ────────────────────────────────────────────────────
+    // True if the calling thread is inside a guard and not already reporting.
+    static bool isGuarded() noexcept;
+    // Records a violation for the calling thread. Safe to call from inside malloc.
+    static void report(Kind kind, const char* call) noexcept;
+
+    // ── Inspection (any thread) ───────────────────────────────────────────
+    static int  getNumViolations() noexcept;                 // total, including unstored
+    static bool getViolation(int index, Violation& out) noexcept;
+    static void clearViolations() noexcept;
+    static const char* kindName(Kind kind) noexcept;
+    static std::string describe(const Violation& v);         // symbolised, allocates
+};
@@ -0,0 +1,168 @@
+// Call interposers for RealtimeGuard. Link into test executables only (see RealtimeGuard.h).
+//
+// Allocation calls forward to glibc's __libc_* entry points, so they work before the
+// dynamic linker is fully up and never recurse; locks and syscalls forward through
+// dlsym(RTLD_NEXT). Every hook is a thread-local check plus the real call when the
+// calling thread is not inside a RealtimeGuard.
+#include "RealtimeGuard.h"
+
+#if STITCHER_RT_GUARD && defined(__linux__) && defined(__GLIBC__)
+
+#include <atomic>
+#include <cstddef>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void  __libc_free(void*);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+}
+
+namespace {
+
+using Kind = RealtimeGuard::Kind;
+
+inline void check(Kind kind, const char* call) noexcept
+{
+    if (RealtimeGuard::isGuarded())
+        RealtimeGuard::report(kind, call);
+}
+
+// Resolved on first use; no function-local statics, whose guards may themselves lock.
+template <typename Fn>
+Fn resolve(std::atomic<Fn>& slot, const char* name) noexcept
+{
+    Fn fn = slot.load(std::memory_order_acquire);
+    if (fn == nullptr) {
+        fn = reinterpret_cast<Fn>(::dlsym(RTLD_NEXT, name));
+        slot.store(fn, std::memory_order_release);
+    }
+    return fn;
+}
+
+using MutexFn     = int (*)(pthread_mutex_t*);
+using RwFn        = int (*)(pthread_rwlock_t*);
+using CondWaitFn  = int (*)(pthread_cond_t*, pthread_mutex_t*);
+using NanosleepFn = int (*)(const struct timespec*, struct timespec*);
+using UsleepFn    = int (*)(useconds_t);
+using ReadFn      = ssize_t (*)(int, void*, size_t);
+using WriteFn     = ssize_t (*)(int, const void*, size_t);
+
+std::atomic<MutexFn>     realMutexLock   { nullptr };
+std::atomic<RwFn>        realRdLock      { nullptr };
+std::atomic<RwFn>        realWrLock      { nullptr };
+std::atomic<CondWaitFn>  realCondWait    { nullptr };
+std::atomic<NanosleepFn> realNanosleep   { nullptr };
+std::atomic<UsleepFn>    realUsleep      { nullptr };
+std::atomic<ReadFn>      realRead        { nullptr };
+std::atomic<WriteFn>     realWrite       { nullptr };
+
+} // namespace
+
+// ── Heap ───────────────────────────────────────────────────────────────────
+// operator new/delete in libstdc++ are built on malloc/free, so these cover them too.
+
+extern "C" void* malloc(size_t size)
+{
+    check(Kind::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void free(void* p)
+{
+    if (p != nullptr) check(Kind::Deallocation, "free");
+    __libc_free(p);
+}
+
+extern "C" void* calloc(size_t n, size_t size)
+{
+    check(Kind::Allocation, "calloc");
+    return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* p, size_t size)
+{
+    check(Kind::Allocation, "realloc");
+    return __libc_realloc(p, size);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size)
+{
+    check(Kind::Allocation, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size)
+{
+    check(Kind::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** out, size_t alignment, size_t size)
+{
+    check(Kind::Allocation, "posix_memalign");
+    void* p = __libc_memalign(alignment, size);
+    if (p == nullptr) return 12;  // ENOMEM
+    *out = p;
+    return 0;
+}
+
+// ── Locks ──────────────────────────────────────────────────────────────────
+// try-lock variants are deliberately not hooked: they never block.
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* m)
+{
+    check(Kind::Lock, "pthread_mutex_lock");
+    return resolve(realMutexLock, "pthread_mutex_lock")(m);
+}
+
+extern "C" int pthread_rwlock_rdlock(pthread_rwlock_t* l)
+{
+    check(Kind::Lock, "pthread_rwlock_rdlock");
+    return resolve(realRdLock, "pthread_rwlock_rdlock")(l);
+}
+
+extern "C" int pthread_rwlock_wrlock(pthread_rwlock_t* l)
+{
+    check(Kind::Lock, "pthread_rwlock_wrlock");
+    return resolve(realWrLock, "pthread_rwlock_wrlock")(l);
+}
+
+extern "C" int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m)
+{
+    check(Kind::Lock, "pthread_cond_wait");
+    return resolve(realCondWait, "pthread_cond_wait")(c, m);
+}
+
+// ── Blocking syscalls ──────────────────────────────────────────────────────
+
+extern "C" int nanosleep(const struct timespec* req, struct timespec* rem)
+{
+    check(Kind::Syscall, "nanosleep");
+    return resolve(realNanosleep, "nanosleep")(req, rem);
+}
+
+extern "C" int usleep(useconds_t us)
+{
+    check(Kind::Syscall, "usleep");
+    return resolve(realUsleep, "usleep")(us);
+}
+
+extern "C" ssize_t read(int fd, void* buf, size_t n)
+{
+    check(Kind::Syscall, "read");
+    return resolve(realRead, "read")(fd, buf, n);
+}
+
+extern "C" ssize_t write(int fd, const void* buf, size_t n)
+{
+    check(Kind::Syscall, "write");
+    return resolve(realWrite, "write")(fd, buf, n);
+}
+
+#endif
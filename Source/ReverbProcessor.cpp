@@ -1,24 +1,150 @@
 #include "ReverbProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Mutually prime-ish line lengths (ms) spread over ~30–75 ms
+constexpr float kDelayMs[ReverbProcessor::kNumLines] = { 31.1f, 37.3f, 41.9f, 47.3f, 53.9f, 59.3f, 67.1f, 73.7f };
+constexpr float kModDepthMs = 0.25f;
+constexpr float kModRateHz  = 0.45f;
+constexpr float kWetRampSec = 0.05f;
+// Input/output gains keep the wet level in the same range as the old Freeverb wrapper.
+constexpr float kInputGain  = 0.35f;
+constexpr float kOutputGain = 0.5f;
+// Output tap signs per line, so L and R get decorrelated mixes of the same network.
+constexpr float kTapL[ReverbProcessor::kNumLines] = { 1.f, -1.f,  1.f, -1.f,  1.f, -1.f,  1.f, -1.f };
+constexpr float kTapR[ReverbProcessor::kNumLines] = { 1.f,  1.f, -1.f, -1.f,  1.f,  1.f, -1.f, -1.f };
+constexpr float kTapIn[ReverbProcessor::kNumLines] = { 1.f, -1.f, -1.f,  1.f, -1.f,  1.f,  1.f, -1.f };
+} // namespace
 
 void ReverbProcessor::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    reverb_.prepare(spec);
-    juce::dsp::Reverb::Parameters p;
-    p.roomSize  = 0.5f;
-    p.damping   = 0.5f;
-    p.wetLevel  = 0.f;
-    p.dryLevel  = 1.f;
-    reverb_.setParameters(p);
+    sampleRate_ = spec.sampleRate;
+    const auto ms = static_cast<float>(sampleRate_ / 1000.0);
+
+    modDepth_ = kModDepthMs * ms;
+    const float maxDelay = kDelayMs[kNumLines - 1] * ms + modDepth_ + 4.f;
+    const int frames = juce::nextPowerOfTwo(static_cast<int>(std::ceil(maxDelay)));
+    mask_ = frames - 1;
+    lines_.assign(static_cast<size_t>(frames * kNumLines), 0.f);
+
+    for (int i = 0; i < kNumLines; ++i) {
+        delay_[static_cast<size_t>(i)] = kDelayMs[i] * ms;
+        const float phase = juce::MathConstants<float>::twoPi * static_cast<float>(i) / kNumLines;
+        lfoCos_[static_cast<size_t>(i)] = std::cos(phase);
+        lfoSin_[static_cast<size_t>(i)] = std::sin(phase);
+    }
+    const double w = juce::MathConstants<double>::twoPi * kModRateHz * kModInterval / sampleRate_;
+    lfoStepRe_ = static_cast<float>(std::cos(w));
+    lfoStepIm_ = static_cast<float>(std::sin(w));
+
+    wet_.reset(sampleRate_, kWetRampSec);
+    wet_.setCurrentAndTargetValue(0.f);
+    setParams(0.5f, 0.5f, 0.f);
+
+    convBuffer_.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+    // prepare() finishes any queued IR load and installs the latest engine, so whatever
+    // was last requested is what the convolution runs from here on.
+    convolution_.prepare(spec);
+    irRequestSeen_ = irRequest_.load(std::memory_order_acquire);
+    irLoaded_      = (irRequestSeen_ & 1u) != 0;
+    irSwapPending_ = false;
+    reset();
+}
+
+void ReverbProcessor::reset()
+{
+    std::fill(lines_.begin(), lines_.end(), 0.f);
+    damp_.fill(0.f);
+    writePos_ = 0;
+    lfoRe_    = 1.f;
+    lfoIm_    = 0.f;
+    updateModulation();
+    convolution_.reset();
+    mode_     = pendingMode_;
+    bypassed_ = wet_.getTargetValue() <= 0.f && !wet_.isSmoothing();
+}
+
+int ReverbProcessor::getTailSamples() const noexcept
+{
+    if (bypassed_ && wetTarget() <= 0.f)
+        return 0;   // dry only: nothing rings on
+    if (mode_ == Mode::Convolution)
+        return static_cast<int>(convolution_.getCurrentIRSize());
+    return static_cast<int>(2.f * rt60_ * static_cast<float>(sampleRate_));
+}
+
+void ReverbProcessor::setMode(Mode mode) noexcept
+{
+    pendingMode_ = mode;
+}
+
+bool ReverbProcessor::loadImpulseResponse(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return false;
+    // Reading, trimming, resampling to the current rate and normalising all happen on the
+    // convolution's background loader; the new engine is swapped in (with a crossfade)
+    // the next time process() runs.
+    convolution_.loadImpulseResponse(file, juce::dsp::Convolution::Stereo::yes,
+                                     juce::dsp::Convolution::Trim::yes, 0,
+                                     juce::dsp::Convolution::Normalise::yes);
+    irRequest_.store(((irRequest_.load() >> 1) + 1) << 1 | 1u, std::memory_order_release);
+    return true;
+}
+
+void ReverbProcessor::clearImpulseResponse()
+{
+    irLoaded_ = false;   // wet fades out
+    irRequest_.store(((irRequest_.load() >> 1) + 1) << 1, std::memory_order_release);
+    // Swap the engine to a silent one-sample IR: it frees the old IR, and the next load is
+    // seen as a size change even when it is the same file again.
+    juce::AudioBuffer<float> silence(1, 1);
+    silence.clear();
+    convolution_.loadImpulseResponse(std::move(silence), sampleRate_, juce::dsp::Convolution::Stereo::no,
+                                     juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
+}
+
+void ReverbProcessor::updateImpulseResponse(juce::dsp::AudioBlock<float>& block)
+{
+    const auto request = irRequest_.load(std::memory_order_acquire);
+    const bool isLoad  = (request & 1u) != 0;
+    if (request != irRequestSeen_) {
+        irRequestSeen_ = request;
+        irSizeBefore_  = convolution_.getCurrentIRSize();
+        // A load over a running IR crossfades inside the convolution; a clear only has
+        // something to swap out if the engine holds more than the silent placeholder.
+        irSwapPending_ = isLoad ? !irLoaded_.load(std::memory_order_relaxed) : irSizeBefore_ > 1;
+        if (!isLoad)
+            irLoaded_ = false;
+    }
+    if (!irSwapPending_)
+        return;
+
+    // The convolution only installs a newly loaded engine inside its own process(), so run
+    // it on a scratch copy while it is not otherwise being run.
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), convBuffer_.getNumChannels());
+    if ((mode_ != Mode::Convolution || bypassed_) && numChannels > 0) {
+        auto scratch = juce::dsp::AudioBlock<float>(convBuffer_)
+                           .getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                           .getSubBlock(0, block.getNumSamples());
+        scratch.copyFrom(block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels)));
+        juce::dsp::ProcessContextReplacing<float> ctx(scratch);
+        convolution_.process(ctx);
+    }
+    if (convolution_.getCurrentIRSize() != irSizeBefore_) {
+        irSwapPending_ = false;
+        if (isLoad)
+            irLoaded_ = true;
+    }
 }
 
 void ReverbProcessor::setParams(float roomSize, float damping, float wetLevel)
 {
-    juce::dsp::Reverb::Parameters p;
-    p.roomSize  = roomSize;
-    p.damping   = damping;
-    p.wetLevel  = wetLevel;
-    p.dryLevel  = 1.f - wetLevel;
-    reverb_.setParameters(p);
+    rt60_    = 0.3f * std::pow(16.f, juce::jlimit(0.f, 1.f, roomSize));   // 0.3 .. 4.8 s
+    hfRatio_ = 1.f - 0.85f * juce::jlimit(0.f, 1.f, damping);             // 1.0 .. 0.15
+    updateDecay();
+    wetLevel_ = juce::jlimit(0.f, 1.f, wetLevel);
 }
 
 void ReverbProcessor::setSpace(float space, float wet)
@@ -28,8 +154,154 @@ void ReverbProcessor::setSpace(float space, float wet)
     setParams(roomSize, damping, wet);
 }
 
+void ReverbProcessor::updateDecay()
+{
+    // Jot absorbent filter: per-line one-pole whose DC gain gives rt60_ and whose
+    // Nyquist gain gives rt60_ · hfRatio_ for that line's length.
+    const auto fs = static_cast<float>(sampleRate_);
+    for (size_t i = 0; i < static_cast<size_t>(kNumLines); ++i) {
+        const float gLow  = std::pow(10.f, -3.f * delay_[i] / (rt60_ * fs));
+        const float gHigh = std::pow(10.f, -3.f * delay_[i] / (rt60_ * hfRatio_ * fs));
+        const float p     = (gLow - gHigh) / (gLow + gHigh);
+        pole_[i]   = p;
+        gainDc_[i] = gLow * (1.f - p);
+    }
+}
+
 void ReverbProcessor::process(juce::dsp::AudioBlock<float>& block)
 {
-    juce::dsp::ProcessContextReplacing<float> ctx(block);
-    reverb_.process(ctx);
+    updateImpulseResponse(block);
+    wet_.setTargetValue(wetTarget());
+    if (wet_.getTargetValue() <= 0.f && !wet_.isSmoothing()) {
+        // Wet has finished fading out: output is the dry signal untouched. Clear the
+        // engines once so a later wet increase does not replay a stale tail.
+        if (!bypassed_) {
+            std::fill(lines_.begin(), lines_.end(), 0.f);
+            damp_.fill(0.f);
+            writePos_ = 0;
+            convolution_.reset();
+            bypassed_ = true;
+        }
+        // A mode change waits for the fade-out, then fades the new engine in.
+        if (mode_ != pendingMode_) {
+            mode_ = pendingMode_;
+            wet_.setTargetValue(wetTarget());
+        }
+        if (wet_.getTargetValue() <= 0.f)
+            return;
+    }
+    bypassed_ = false;
+
+    if (mode_ == Mode::Convolution)
+        processConvolution(block);
+    else
+        processNetwork(block);
+}
+
+float ReverbProcessor::wetTarget() const noexcept
+{
+    if (mode_ != pendingMode_)
+        return 0.f;
+    if (mode_ == Mode::Convolution && !irLoaded_.load(std::memory_order_relaxed))
+        return 0.f;
+    return wetLevel_;
+}
+
+void ReverbProcessor::processConvolution(juce::dsp::AudioBlock<float>& block)
+{
+    const int numSamples  = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), convBuffer_.getNumChannels());
+    if (numChannels == 0) return;
+
+    // Convolve a copy, then blend it back with the smoothed wet level
+    auto wetBlock = juce::dsp::AudioBlock<float>(convBuffer_)
+                        .getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                        .getSubBlock(0, static_cast<size_t>(numSamples));
+    wetBlock.copyFrom(block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels)));
+    juce::dsp::ProcessContextReplacing<float> ctx(wetBlock);
+    convolution_.process(ctx);
+
+    for (int n = 0; n < numSamples; ++n) {
+        const float wet = wet_.getNextValue();
+        const float dry = 1.f - wet;
+        for (int c = 0; c < numChannels; ++c) {
+            float* d = block.getChannelPointer(static_cast<size_t>(c));
+            d[n] = dry * d[n] + wet * wetBlock.getSample(c, n);
+        }
+    }
+}
+
+void ReverbProcessor::processNetwork(juce::dsp::AudioBlock<float>& block)
+{
+    const int numSamples  = static_cast<int>(block.getNumSamples());
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    if (numChannels == 0) return;
+    float* left  = block.getChannelPointer(0);
+    float* right = numChannels > 1 ? block.getChannelPointer(1) : nullptr;
+
+    constexpr float kMix = 2.f / kNumLines;   // Householder: y = x − (2/N)·Σx
+    float* const base = lines_.data();
+    float z[kNumLines];
+
+    for (int n = 0; n < numSamples; ++n) {
+        const float inL = left[n];
+        const float inR = right != nullptr ? right[n] : inL;
+
+        if (--modCountdown_ <= 0)
+            updateModulation();
+
+        // Modulated, linearly interpolated reads
+        for (int i = 0; i < kNumLines; ++i) {
+            const int   i0 = (writePos_ - readOffset_[static_cast<size_t>(i)]) & mask_;
+            const int   i1 = (i0 - 1) & mask_;
+            const float a  = base[i0 * kNumLines + i];
+            const float b  = base[i1 * kNumLines + i];
+            z[i] = a + readFrac_[static_cast<size_t>(i)] * (b - a);
+        }
+
+        // Frequency-dependent decay
+        for (size_t i = 0; i < static_cast<size_t>(kNumLines); ++i) {
+            damp_[i] = gainDc_[i] * z[i] + pole_[i] * damp_[i];
+            z[i]     = damp_[i];
+        }
+
+        float sum = 0.f, outL = 0.f, outR = 0.f;
+        for (int i = 0; i < kNumLines; ++i) {
+            sum  += z[i];
+            outL += kTapL[i] * z[i];
+            outR += kTapR[i] * z[i];
+        }
+
+        // Householder feedback plus input injection
+        const float in = 0.5f * (inL + inR) * kInputGain;
+        float* w = base + writePos_ * kNumLines;
+        for (int i = 0; i < kNumLines; ++i)
+            w[i] = z[i] - kMix * sum + kTapIn[i] * in;
+        writePos_ = (writePos_ + 1) & mask_;
+
+        const float wet = wet_.getNextValue();
+        const float dry = 1.f - wet;
+        left[n] = dry * inL + wet * kOutputGain * outL;
+        if (right != nullptr)
+            right[n] = dry * inR + wet * kOutputGain * outR;
+    }
+}
+
+void ReverbProcessor::updateModulation()
+{
+    // The LFO is far below audio rate, so read offsets are refreshed every kModInterval
+    // samples; the per-sample read is then two loads and a lerp per line.
+    for (size_t i = 0; i < static_cast<size_t>(kNumLines); ++i) {
+        const float d  = delay_[i] + modDepth_ * (lfoIm_ * lfoCos_[i] + lfoRe_ * lfoSin_[i]);
+        const float fl = std::floor(d);
+        readOffset_[i] = static_cast<int>(fl);
+        readFrac_[i]   = d - fl;
+    }
+
+    const float re = lfoRe_ * lfoStepRe_ - lfoIm_ * lfoStepIm_;
+    const float im = lfoRe_ * lfoStepIm_ + lfoIm_ * lfoStepRe_;
+    const float norm = 1.f / std::sqrt(re * re + im * im);   // stay on the unit circle
+    lfoRe_ = re * norm;
+    lfoIm_ = im * norm;
+    modCountdown_ = kModInterval;
 }
@@ -1,15 +1,105 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <vector>
 
+/**
+ * ReverbProcessor — 8-line feedback delay network.
+ *
+ * Lines are stored interleaved (one 8-float frame per sample) so the write side and the
+ * per-line decay/mix arithmetic are straight loops over kNumLines that vectorise. Feedback
+ * goes through a Householder matrix, each line has a one-pole absorbent filter giving
+ * separate low/high RT60s, and the read taps are slowly modulated to break up metallic
+ * modes. At wet = 0 the wet signal fades out, then processing stops and the network is
+ * cleared, so a dry reverb costs nothing.
+ *
+ * Convolution mode runs a user impulse response through juce::dsp::Convolution with
+ * non-uniform partitioning: a zero-latency head of kConvHeadSize samples and larger FFT
+ * partitions for the tail, so multi-second IRs stay cheap. Mode changes fade the wet
+ * signal out, switch engines and fade back in.
+ */
 class ReverbProcessor {
 public:
+    static constexpr int kNumLines    = 8;
+    static constexpr int kModInterval = 32;   // samples between read-tap modulation updates
+    static constexpr int kConvHeadSize = 512;
+
+    enum class Mode { Algorithmic, Convolution };
+
     void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
     // roomSize [0,1], damping [0,1], wetLevel [0,1]
     void setParams(float roomSize, float damping, float wetLevel);
     // space [0,1]: 0 = small/damped, 1 = large/open. wet [0,1] as usual.
     void setSpace(float space, float wet);
     void process(juce::dsp::AudioBlock<float>& block);
 
+    // Audio thread (with the other setters); applied through a wet fade-out/fade-in.
+    void setMode(Mode mode) noexcept;
+    Mode getMode() const noexcept { return mode_; }
+
+    // Message thread. Returns false if the file does not exist; decoding and resampling run
+    // in the background and the IR is picked up by process() once ready. Convolution mode
+    // stays silent (dry only) until the engine is running the new IR, and
+    // hasImpulseResponse() only turns true at that point.
+    bool loadImpulseResponse(const juce::File& file);
+    void clearImpulseResponse();
+    bool hasImpulseResponse() const noexcept { return irLoaded_.load(); }
+
+    // Low-frequency RT60 for the current room size, in seconds.
+    float getDecaySeconds() const noexcept { return rt60_; }
+    // Samples for the tail to die away after the input stops: −120 dB for the network,
+    // the IR length for convolution.
+    int   getTailSamples() const noexcept;
+    // True once wet has faded to zero and the network is no longer being run.
+    bool  isBypassed() const noexcept { return bypassed_; }
+
 private:
-    juce::dsp::Reverb reverb_;
+    void updateDecay();
+    void updateModulation();
+    float wetTarget() const noexcept;
+    void  updateImpulseResponse(juce::dsp::AudioBlock<float>& block);
+    void processNetwork(juce::dsp::AudioBlock<float>& block);
+    void processConvolution(juce::dsp::AudioBlock<float>& block);
+
+    double sampleRate_  = 44100.0;
+    float  rt60_        = 1.f;
+    float  hfRatio_     = 0.5f;   // high-frequency RT60 as a fraction of rt60_
+
+    std::vector<float> lines_;    // interleaved: lines_[pos * kNumLines + line]
+    int    mask_        = 0;      // frames - 1 (power of two)
+    int    writePos_    = 0;
+
+    std::array<float, kNumLines> delay_ {};      // nominal delay, samples
+    std::array<float, kNumLines> gainDc_ {};     // absorbent filter: feed gain g·(1 − p)
+    std::array<float, kNumLines> pole_ {};       //                   pole p
+    std::array<float, kNumLines> damp_ {};       //                   state
+    std::array<float, kNumLines> lfoCos_ {}, lfoSin_ {};   // per-line LFO phase offsets
+
+    std::array<int,   kNumLines> readOffset_ {}; // current modulated delay: whole samples
+    std::array<float, kNumLines> readFrac_ {};   //                          and fraction
+
+    float lfoRe_ = 1.f, lfoIm_ = 0.f;            // rotating LFO phasor, advanced every kModInterval
+    float lfoStepRe_ = 1.f, lfoStepIm_ = 0.f;
+    float modDepth_  = 0.f;                      // samples
+    int   modCountdown_ = 0;
+
+    juce::SmoothedValue<float> wet_;
+    float wetLevel_ = 0.f;
+    bool  bypassed_ = true;
+
+    Mode mode_        = Mode::Algorithmic;
+    Mode pendingMode_ = Mode::Algorithmic;
+
+    juce::dsp::Convolution   convolution_ { juce::dsp::Convolution::NonUniform { kConvHeadSize } };
+    juce::AudioBuffer<float> convBuffer_;
+    std::atomic<bool>        irLoaded_ { false };
+    // Load/clear requests from the message thread: a generation count in the upper bits,
+    // bit 0 set for a load. The audio thread notes the engine's IR size when it first sees
+    // a request and counts it as done once the convolution reports a different size.
+    std::atomic<uint32_t>    irRequest_ { 0 };
+    uint32_t                 irRequestSeen_ = 0;
+    size_t                   irSizeBefore_  = 0;
+    bool                     irSwapPending_ = false;
 };
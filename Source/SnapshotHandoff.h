@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * SnapshotHandoff — wait-free "latest value" mailbox from one producer thread to the audio
+ * thread (a triple buffer).
+ *
+ * push() publishes a complete T; pull() copies out the newest value published since the
+ * previous pull, or returns false. Values the consumer never got to are overwritten, not
+ * queued: only the latest one matters. Neither side blocks or allocates, and a value is
+ * never seen half-written.
+ *
+ * Thread model: push() from one producer thread, pull() from one consumer thread.
+ */
+template <typename T>
+class SnapshotHandoff {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots are copied between threads");
+
+public:
+    void push(const T& value) noexcept
+    {
+        slots_[static_cast<size_t>(back_)] = value;
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    bool pull(T& out) noexcept
+    {
+        if ((middle_.load(std::memory_order_acquire) & kFresh) == 0)
+            return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        out = slots_[static_cast<size_t>(front_)];
+        return true;
+    }
+
+private:
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFresh     = 4;   // set on middle_ by push(), cleared by pull()
+
+    std::array<T, 3> slots_ {};
+    int              back_ = 0;          // producer's slot
+    std::atomic<int> middle_ { 1 };      // last published slot (+ kFresh)
+    int              front_ = 2;         // consumer's slot
+};
@@ -0,0 +1,267 @@
+#include "StageProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+constexpr int kMaxOctave = 40;   // ticks >= 2^40 (minutes at GHz rates) share the last bin
+
+double measureTicksPerSecond()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto     t0 = Clock::now();
+    const uint64_t c0 = CycleClock::now();
+    while (Clock::now() - t0 < std::chrono::milliseconds(2))
+        std::this_thread::yield();
+    const auto     t1 = Clock::now();
+    const uint64_t c1 = CycleClock::now();
+    const double seconds = std::chrono::duration<double>(t1 - t0).count();
+    return seconds > 0.0 ? static_cast<double>(c1 - c0) / seconds : 1.0e9;
+}
+
+int highestBit(uint64_t v) noexcept
+{
+    int b = 0;
+    while (v >>= 1) ++b;
+    return b;
+}
+} // namespace
+
+const char* StageProfiler::getStageName(int stage) noexcept
+{
+    static const char* const names[kNumStages] = {
+        "Input", "Features", "Match", "Grain", "Pitch", "Crush", "EQ", "Blend", "Reverb", "Limiter", "Block"
+    };
+    return juce::isPositiveAndBelow(stage, static_cast<int>(kNumStages)) ? names[stage] : "?";
+}
+
+double StageProfiler::getTicksPerSecond() noexcept
+{
+    static const double ticksPerSecond = measureTicksPerSecond();
+    return ticksPerSecond;
+}
+
+// Bins 0–3 hold 0–3 ticks exactly; above that each octave [2^k, 2^(k+1)) is split in four.
+int StageProfiler::binForTicks(uint64_t ticks) noexcept
+{
+    if (ticks < 4)
+        return static_cast<int>(ticks);
+    const int msb = highestBit(ticks);
+    if (msb >= kMaxOctave)
+        return kNumBins - 1;
+    const int sub = static_cast<int>((ticks >> (msb - 2)) & 3u);
+    return 4 * (msb - 1) + sub;
+}
+
+uint64_t StageProfiler::binUpperTicks(int bin) noexcept
+{
+    if (bin < 4)
+        return static_cast<uint64_t>(bin) + 1;
+    const int msb = bin / 4 + 1;
+    const int sub = bin % 4;
+    return (static_cast<uint64_t>(4 + sub + 1)) << (msb - 2);
+}
+
+void StageProfiler::prepare(double sampleRate)
+{
+    sampleRate_     = sampleRate;
+    ticksPerSample_ = getTicksPerSecond() / sampleRate;
+    reset();
+}
+
+uint64_t StageProfiler::beginBlock() noexcept
+{
+    if (resetRequested_.exchange(false, std::memory_order_acquire))
+        clear();
+    return begin();
+}
+
+void StageProfiler::endBlock(uint64_t startTicks, int numSamples) noexcept
+{
+    if (startTicks == 0)
+        return;
+    const uint64_t ticks = CycleClock::now() - startTicks;
+    record(Block, startTicks, ticks);
+    recordLoad(ticks, numSamples);
+}
+
+void StageProfiler::record(Stage stage, uint64_t startTicks, uint64_t durationTicks) noexcept
+{
+    auto& h = stages_[static_cast<size_t>(stage)];
+    bump(h.bins[static_cast<size_t>(binForTicks(durationTicks))], 1u);
+    bump(h.sumTicks, durationTicks);
+    if (durationTicks > h.maxTicks.load(std::memory_order_relaxed))
+        h.maxTicks.store(durationTicks, std::memory_order_relaxed);
+
+    // The fence pairs with the reader's: a reader that sees any word of this event also
+    // sees traceWrite_ >= w and so discards the old event it overwrites.
+    const uint64_t w    = traceWrite_.load(std::memory_order_relaxed);
+    const size_t   slot = static_cast<size_t>(w & (kTraceCapacity - 1)) * 2;
+    std::atomic_thread_fence(std::memory_order_release);
+    trace_[slot].store(startTicks, std::memory_order_relaxed);
+    trace_[slot + 1].store((static_cast<uint64_t>(stage) << 56) | (durationTicks & ((uint64_t { 1 } << 56) - 1)),
+                           std::memory_order_relaxed);
+    traceWrite_.store(w + 1, std::memory_order_release);
+}
+
+void StageProfiler::recordLoad(uint64_t blockTicks, int numSamples) noexcept
+{
+    if (numSamples <= 0 || ticksPerSample_ <= 0.0)
+        return;
+    const double load = static_cast<double>(blockTicks) / (ticksPerSample_ * numSamples);
+    const int bin = juce::jmin(kNumLoadBins - 1, static_cast<int>(load * 100.0));
+    bump(loadBins_[static_cast<size_t>(bin)], 1u);
+    if (load > maxLoad_.load(std::memory_order_relaxed))
+        maxLoad_.store(load, std::memory_order_relaxed);
+}
+
+void StageProfiler::clear() noexcept
+{
+    for (auto& h : stages_) {
+        for (auto& b : h.bins)
+            b.store(0, std::memory_order_relaxed);
+        h.sumTicks.store(0, std::memory_order_relaxed);
+        h.maxTicks.store(0, std::memory_order_relaxed);
+    }
+    for (auto& b : loadBins_)
+        b.store(0, std::memory_order_relaxed);
+    maxLoad_.store(0.0, std::memory_order_relaxed);
+}
+
+StageProfiler::Stats StageProfiler::getStats() const
+{
+    const double usPerTick = 1.0e6 / getTicksPerSecond();
+    Stats s;
+
+    for (int i = 0; i < kNumStages; ++i) {
+        const auto& h = stages_[static_cast<size_t>(i)];
+        std::array<uint32_t, kNumBins> bins;
+        uint64_t total = 0;
+        for (int b = 0; b < kNumBins; ++b)
+            total += (bins[static_cast<size_t>(b)] = h.bins[static_cast<size_t>(b)].load(std::memory_order_relaxed));
+        if (total == 0)
+            continue;
+
+        auto& st   = s.stages[static_cast<size_t>(i)];
+        st.count   = total;
+        st.maxUs   = static_cast<double>(h.maxTicks.load(std::memory_order_relaxed)) * usPerTick;
+        st.meanUs  = static_cast<double>(h.sumTicks.load(std::memory_order_relaxed))
+                     / static_cast<double>(total) * usPerTick;
+
+        const uint64_t rank = total - total / 100;   // 99th percentile, rounded up
+        uint64_t seen = 0;
+        for (int b = 0; b < kNumBins; ++b)
+            if ((seen += bins[static_cast<size_t>(b)]) >= rank) {
+                st.p99Us = std::min(static_cast<double>(binUpperTicks(b)) * usPerTick, st.maxUs);
+                break;
+            }
+    }
+
+    std::array<uint32_t, kNumLoadBins> load;
+    uint64_t sumPct = 0;
+    for (int b = 0; b < kNumLoadBins; ++b) {
+        load[static_cast<size_t>(b)] = loadBins_[static_cast<size_t>(b)].load(std::memory_order_relaxed);
+        s.blocks += load[static_cast<size_t>(b)];
+        sumPct   += static_cast<uint64_t>(load[static_cast<size_t>(b)]) * static_cast<uint64_t>(b);
+        if (b >= 100)
+            s.overruns += load[static_cast<size_t>(b)];
+    }
+    if (s.blocks > 0) {
+        s.maxLoad  = maxLoad_.load(std::memory_order_relaxed);
+        // Bin b holds loads in [b, b + 1) %: use the bin centre for the mean
+        s.meanLoad = (static_cast<double>(sumPct) / static_cast<double>(s.blocks) + 0.5) / 100.0;
+        const uint64_t rank = s.blocks - s.blocks / 100;
+        uint64_t seen = 0;
+        for (int b = 0; b < kNumLoadBins; ++b)
+            if ((seen += load[static_cast<size_t>(b)]) >= rank) {
+                s.p99Load = std::min((b + 1) / 100.0, s.maxLoad);
+                break;
+            }
+    }
+    return s;
+}
+
+std::vector<StageProfiler::TraceEvent> StageProfiler::getRecentEvents() const
+{
+    const uint64_t end   = traceWrite_.load(std::memory_order_acquire);
+    const uint64_t begin = end > kTraceCapacity ? end - kTraceCapacity : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t i = begin; i < end; ++i) {
+        const size_t slot   = static_cast<size_t>(i & (kTraceCapacity - 1)) * 2;
+        const uint64_t word = trace_[slot + 1].load(std::memory_order_relaxed);
+        events.push_back({ static_cast<int>(word >> 56), trace_[slot].load(std::memory_order_relaxed),
+                           word & ((uint64_t { 1 } << 56) - 1) });
+    }
+
+    // Slots the writer reached while we were copying may hold a newer (or half-written)
+    // event: keep only indices it cannot have touched yet.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = traceWrite_.load(std::memory_order_relaxed);
+    const uint64_t firstSafe = after >= kTraceCapacity ? after - kTraceCapacity + 1 : 0;
+    if (firstSafe > begin)
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(
+                                         std::min<uint64_t>(firstSafe - begin, events.size())));
+    return events;
+}
+
+juce::String StageProfiler::toJson() const
+{
+    const auto s = getStats();
+
+    juce::Array<juce::var> stages;
+    for (int i = 0; i < kNumStages; ++i) {
+        const auto& st = s.stages[static_cast<size_t>(i)];
+        auto* o = new juce::DynamicObject();
+        o->setProperty("name",   getStageName(i));
+        o->setProperty("count",  static_cast<juce::int64>(st.count));
+        o->setProperty("meanUs", st.meanUs);
+        o->setProperty("p99Us",  st.p99Us);
+        o->setProperty("maxUs",  st.maxUs);
+        stages.add(juce::var(o));
+    }
+
+    auto* load = new juce::DynamicObject();
+    load->setProperty("blocks",   static_cast<juce::int64>(s.blocks));
+    load->setProperty("mean",     s.meanLoad);
+    load->setProperty("p99",      s.p99Load);
+    load->setProperty("max",      s.maxLoad);
+    load->setProperty("overruns", static_cast<juce::int64>(s.overruns));
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("sampleRate",     sampleRate_);
+    root->setProperty("ticksPerSecond", getTicksPerSecond());
+    root->setProperty("stages",         stages);
+    root->setProperty("load",           juce::var(load));
+    return juce::JSON::toString(juce::var(root));
+}
+
+// Chrome trace event format: one complete ("X") event per stage call, timestamps in
+// microseconds from the oldest event in the ring.
+juce::String StageProfiler::toChromeTrace() const
+{
+    const auto events = getRecentEvents();
+    const double usPerTick = 1.0e6 / getTicksPerSecond();
+    const uint64_t origin = events.empty() ? 0 : std::min_element(events.begin(), events.end(),
+        [](const TraceEvent& a, const TraceEvent& b) { return a.startTicks < b.startTicks; })->startTicks;
+
+    juce::Array<juce::var> list;
+    list.ensureStorageAllocated(static_cast<int>(events.size()));
+    for (const auto& e : events) {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("name", getStageName(e.stage));
+        o->setProperty("cat",  "dsp");
+        o->setProperty("ph",   "X");
+        o->setProperty("ts",   static_cast<double>(e.startTicks - origin) * usPerTick);
+        o->setProperty("dur",  static_cast<double>(e.durationTicks) * usPerTick);
+        o->setProperty("pid",  1);
+        o->setProperty("tid",  1);
+        list.add(juce::var(o));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("traceEvents",     list);
+    root->setProperty("displayTimeUnit", "ns");
+    return juce::JSON::toString(juce::var(root), true);
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "CycleClock.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * StageProfiler — always-on per-stage timing for processBlock.
+ *
+ * The audio thread brackets each stage with two CycleClock reads and drops the duration
+ * into a fixed log-scale histogram (four bins per octave, ~19 % wide): a few relaxed
+ * atomic stores per stage, no locks, no allocation. Each block's total time is also
+ * recorded as a fraction of its deadline (numSamples / sampleRate).
+ *
+ * The message thread reads mean / p99 / max per stage from the histograms, and the
+ * newest kTraceCapacity stage events from a ring buffer for Chrome trace export
+ * (chrome://tracing or ui.perfetto.dev). Stages that did not run in a block (silent
+ * fast path) record nothing; Block spans the whole processBlock call and contains the
+ * others.
+ */
+class StageProfiler {
+public:
+    enum Stage : int { Input, Features, Match, Grain, Pitch, Crush, Eq, Blend, Reverb, Limiter, Block,
+                       kNumStages };
+    static const char* getStageName(int stage) noexcept;
+
+    static constexpr int kNumBins      = 160;    // 4 per octave up to 2^40 ticks
+    static constexpr int kNumLoadBins  = 401;    // 1 % steps up to 400 %, last bin = overflow
+    static constexpr int kTraceCapacity = 8192;  // power of two
+
+    // Message thread. Sets the deadline for the load figures; the clock rate is measured
+    // once per process on first use (~2 ms).
+    void prepare(double sampleRate);
+
+    void setEnabled(bool on) noexcept { enabled_.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept   { return enabled_.load(std::memory_order_relaxed); }
+
+    // Message thread. Clears every statistic; carried out by the audio thread at the start
+    // of its next block, so the writer never races a clear.
+    void reset() noexcept { resetRequested_.store(true, std::memory_order_release); }
+
+    // ---- Audio thread ----
+    // Returns the block's start time (0 while profiling is disabled).
+    uint64_t beginBlock() noexcept;
+    void     endBlock(uint64_t startTicks, int numSamples) noexcept;
+
+    uint64_t begin() const noexcept { return isEnabled() ? CycleClock::now() : 0; }
+    void     end(Stage stage, uint64_t startTicks) noexcept
+    {
+        if (startTicks != 0)
+            record(stage, startTicks, CycleClock::now() - startTicks);
+    }
+
+    // RAII form of begin()/end() for a scope that is one stage.
+    class Scope {
+    public:
+        Scope(StageProfiler& p, Stage s) noexcept : profiler_(p), stage_(s), start_(p.begin()) {}
+        ~Scope() { profiler_.end(stage_, start_); }
+    private:
+        StageProfiler& profiler_;
+        Stage          stage_;
+        uint64_t       start_;
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    // Low-level entry points (used by the above, and by tests with synthetic timings).
+    void record(Stage stage, uint64_t startTicks, uint64_t durationTicks) noexcept;
+    void recordLoad(uint64_t blockTicks, int numSamples) noexcept;
+
+    // ---- Message thread ----
+    struct StageStats {
+        uint64_t count  = 0;
+        double   meanUs = 0.0;
+        double   p99Us  = 0.0;   // upper edge of the bin holding the 99th percentile, capped at max
+        double   maxUs  = 0.0;
+    };
+    struct Stats {
+        std::array<StageStats, kNumStages> stages;
+        uint64_t blocks   = 0;
+        double   meanLoad = 0.0;   // block time / deadline; 1.0 = exactly real time
+        double   p99Load  = 0.0;
+        double   maxLoad  = 0.0;
+        uint64_t overruns = 0;     // blocks that took longer than their deadline
+    };
+    Stats getStats() const;
+
+    struct TraceEvent {
+        int      stage;
+        uint64_t startTicks;
+        uint64_t durationTicks;
+    };
+    // Oldest first; events overwritten while copying are dropped, never torn.
+    std::vector<TraceEvent> getRecentEvents() const;
+
+    juce::String toJson() const;
+    juce::String toChromeTrace() const;
+    bool writeJson(const juce::File& file) const        { return file.replaceWithText(toJson()); }
+    bool writeChromeTrace(const juce::File& file) const { return file.replaceWithText(toChromeTrace()); }
+
+    static double getTicksPerSecond() noexcept;
+    static int    binForTicks(uint64_t ticks) noexcept;
+    static uint64_t binUpperTicks(int bin) noexcept;   // exclusive
+
+private:
+    struct Histogram {
+        std::array<std::atomic<uint32_t>, kNumBins> bins {};
+        std::atomic<uint64_t> sumTicks { 0 };
+        std::atomic<uint64_t> maxTicks { 0 };
+    };
+
+    // Single writer (the audio thread): plain load + store, no read-modify-write.
+    template <typename T>
+    static void bump(std::atomic<T>& a, T by) noexcept
+    {
+        a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+    void clear() noexcept;
+
+    std::array<Histogram, kNumStages>                 stages_;
+    std::array<std::atomic<uint32_t>, kNumLoadBins>   loadBins_ {};
+    std::atomic<double>                               maxLoad_  { 0.0 };
+
+    // Trace ring: two words per event — start ticks, and (stage << 56 | duration)
+    std::array<std::atomic<uint64_t>, kTraceCapacity * 2> trace_ {};
+    std::atomic<uint64_t> traceWrite_ { 0 };
+
+    std::atomic<bool> enabled_        { true };
+    std::atomic<bool> resetRequested_ { false };
+    double ticksPerSample_ = 0.0;   // set in prepare(); deadline = numSamples * this
+    double sampleRate_     = 44100.0;
+};
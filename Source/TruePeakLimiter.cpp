@@ -0,0 +1,207 @@
+#include "TruePeakLimiter.h"
+#include <cmath>
+
+namespace {
+constexpr int P = TruePeakLimiter::kOversample, K = TruePeakLimiter::kTapsPerPhase;
+
+// Phase p of the interpolator estimates the input kFilterDelay + p/kOversample samples ago
+double windowedSinc(int phase, int tap)
+{
+    const double t    = tap - TruePeakLimiter::kFilterDelay - static_cast<double>(phase) / P;
+    const double half = K / 2.0;
+    if (std::abs(t) >= half) return 0.0;
+
+    const double x    = juce::MathConstants<double>::pi * t;
+    const double sinc = t == 0.0 ? 1.0 : std::sin(x) / x;
+    // Blackman window over [-half, half]
+    const double u = (t + half) / (2.0 * half);
+    const double w = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * u)
+                          + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * u);
+    return sinc * w;
+}
+
+// Polyphase taps, each phase normalised to unity DC gain
+struct Taps {
+    float h[P][K];
+    Taps()
+    {
+        for (int p = 0; p < P; ++p) {
+            double sum = 0.0;
+            for (int k = 0; k < K; ++k) sum += windowedSinc(p, k);
+            for (int k = 0; k < K; ++k) h[p][k] = static_cast<float>(windowedSinc(p, k) / sum);
+        }
+    }
+};
+
+const Taps& taps()
+{
+    static const Taps t;
+    return t;
+}
+} // namespace
+
+TruePeakLimiter::TruePeakLimiter()
+{
+    for (int p = 0; p < kOversample; ++p)
+        for (int k = 0; k < kTapsPerPhase; ++k)
+            for (auto& lane : coeffs_[p][k])
+                lane = taps().h[p][k];
+}
+
+void TruePeakLimiter::setLookaheadMs(double ms)
+{
+    lookaheadMs_ = juce::jlimit(0.1, kMaxLookaheadMs, ms);
+}
+
+void TruePeakLimiter::setCeilingDb(float db)
+{
+    ceiling_ = juce::Decibels::decibelsToGain(db);
+}
+
+void TruePeakLimiter::setReleaseMs(float ms)
+{
+    releaseMs_    = juce::jmax(1.f, ms);
+    releaseCoeff_ = static_cast<float>(std::exp(-1.0 / (releaseMs_ * 0.001 * sampleRate_)));
+}
+
+void TruePeakLimiter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate_  = spec.sampleRate;
+    numChannels_ = juce::jlimit(1, kMaxChannels, static_cast<int>(spec.numChannels));
+    lookahead_   = juce::jmax(1, juce::roundToInt(lookaheadMs_ * 0.001 * sampleRate_));
+    setReleaseMs(releaseMs_);
+
+    const int dequeSize = juce::nextPowerOfTwo(lookahead_ + 2);
+    dequeGain_.assign(static_cast<size_t>(dequeSize), 1.f);
+    dequeIndex_.assign(static_cast<size_t>(dequeSize), 0);
+    dequeMask_ = static_cast<uint32_t>(dequeSize - 1);
+    box_.assign(static_cast<size_t>(lookahead_), 1.f);
+    for (auto& d : delay_)
+        d.assign(static_cast<size_t>(getLatencySamples() + 1), 0.f);
+    reset();
+}
+
+void TruePeakLimiter::reset()
+{
+    for (auto& row : history_)
+        for (auto& lane : row) lane = 0.f;
+    historyPos_  = 0;
+    dequeHead_   = dequeTail_ = 0;
+    sampleIndex_ = 0;
+    envelope_    = 1.f;
+    std::fill(box_.begin(), box_.end(), 1.f);
+    boxSum_ = static_cast<double>(box_.size());
+    boxPos_ = 0;
+    for (auto& d : delay_)
+        std::fill(d.begin(), d.end(), 0.f);
+    delayPos_ = 0;
+    minGain_  = 1.f;
+}
+
+float TruePeakLimiter::getAndResetMinGain() noexcept
+{
+    const float g = minGain_;
+    minGain_ = 1.f;
+    return g;
+}
+
+// Largest |value| over the four interpolated phases of the current history window, across
+// channels. Unused lanes hold zeros.
+float TruePeakLimiter::truePeak() const noexcept
+{
+    const float* window = history_[historyPos_];
+#if JUCE_USE_SIMD
+    using Reg = juce::dsp::SIMDRegister<float>;
+    static_assert(Reg::SIMDNumElements == kLanes, "history rows are one register wide");
+    Reg peak = Reg::expand(0.f);
+    for (int p = 0; p < kOversample; ++p) {
+        Reg acc = Reg::expand(0.f);
+        for (int k = 0; k < kTapsPerPhase; ++k)
+            acc += Reg::fromRawArray(coeffs_[p][k]) * Reg::fromRawArray(window + k * kLanes);
+        peak = Reg::max(peak, Reg::abs(acc));
+    }
+    alignas(16) float lanes[kLanes];
+    peak.copyToRawArray(lanes);
+    return juce::jmax(lanes[0], lanes[1]);
+#else
+    float peak = 0.f;
+    for (int c = 0; c < numChannels_; ++c)
+        for (int p = 0; p < kOversample; ++p) {
+            float acc = 0.f;
+            for (int k = 0; k < kTapsPerPhase; ++k)
+                acc += coeffs_[p][k][0] * window[k * kLanes + c];
+            peak = juce::jmax(peak, std::abs(acc));
+        }
+    return peak;
+#endif
+}
+
+// Appends a required gain and drops gains older than the lookahead window
+void TruePeakLimiter::pushGain(float gain) noexcept
+{
+    while (dequeTail_ != dequeHead_ && dequeGain_[(dequeTail_ - 1) & dequeMask_] >= gain)
+        --dequeTail_;
+    dequeGain_ [dequeTail_ & dequeMask_] = gain;
+    dequeIndex_[dequeTail_ & dequeMask_] = sampleIndex_;
+    ++dequeTail_;
+    while (dequeIndex_[dequeHead_ & dequeMask_] <= sampleIndex_ - (lookahead_ + 1))
+        ++dequeHead_;
+}
+
+void TruePeakLimiter::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numCh      = juce::jmin(numChannels_, static_cast<int>(block.getNumChannels()));
+    const int delaySize  = static_cast<int>(delay_[0].size());
+
+    float* channels[kMaxChannels] {};
+    for (int c = 0; c < numCh; ++c)
+        channels[c] = block.getChannelPointer(static_cast<size_t>(c));
+
+    for (int i = 0; i < numSamples; ++i) {
+        // History: newest frame at historyPos_, mirrored kTapsPerPhase rows on
+        historyPos_ = historyPos_ == 0 ? kTapsPerPhase - 1 : historyPos_ - 1;
+        for (int c = 0; c < numCh; ++c) {
+            history_[historyPos_][c]                 = channels[c][i];
+            history_[historyPos_ + kTapsPerPhase][c] = channels[c][i];
+        }
+
+        const float peak = truePeak();
+        pushGain(peak > ceiling_ ? ceiling_ / peak : 1.f);
+        ++sampleIndex_;
+
+        // Attack is immediate into the held minimum; release glides back up
+        const float held = dequeGain_[dequeHead_ & dequeMask_];
+        envelope_ = held < envelope_ ? held : held + releaseCoeff_ * (envelope_ - held);
+
+        boxSum_ += static_cast<double>(envelope_ - box_[static_cast<size_t>(boxPos_)]);
+        box_[static_cast<size_t>(boxPos_)] = envelope_;
+        boxPos_ = boxPos_ + 1 == lookahead_ ? 0 : boxPos_ + 1;
+        const float gain = juce::jmin(1.f, static_cast<float>(boxSum_ / lookahead_));   // exactly 1 when idle
+        minGain_ = juce::jmin(minGain_, gain);
+
+        // Delay line holds exactly getLatencySamples() samples ahead of the read
+        const int readPos = delayPos_ + 1 == delaySize ? 0 : delayPos_ + 1;
+        for (int c = 0; c < numCh; ++c) {
+            auto& d = delay_[c];
+            d[static_cast<size_t>(delayPos_)] = channels[c][i];
+            channels[c][i] = d[static_cast<size_t>(readPos)] * gain;
+        }
+        delayPos_ = readPos;
+    }
+}
+
+float TruePeakLimiter::measureTruePeak(const float* data, int numSamples)
+{
+    // Only where the whole interpolator window lies inside the data: zero-padding the
+    // edges would ring and report overs that are not in the signal
+    float peak = 0.f;
+    for (int i = kTapsPerPhase - 1; i < numSamples; ++i)
+        for (int p = 0; p < kOversample; ++p) {
+            float acc = 0.f;
+            for (int k = 0; k < kTapsPerPhase; ++k)
+                acc += taps().h[p][k] * data[i - k];
+            peak = juce::jmax(peak, std::abs(acc));
+        }
+    return peak;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+/**
+ * TruePeakLimiter — stereo-linked lookahead limiter driven by inter-sample peaks.
+ *
+ * Peaks are measured on a 4x oversampled signal: a 48-tap windowed-sinc interpolator
+ * split into four 12-tap polyphase branches, with L and R carried in two SIMD lanes so
+ * both channels are filtered in one pass. The required gain per sample is held over the
+ * lookahead window by a sliding minimum (monotonic deque, fixed capacity), released
+ * through a one-pole and then averaged over the lookahead, so the gain is already down
+ * by the time an over reaches the output. The audio is delayed to match; the total delay
+ * is getLatencySamples().
+ */
+class TruePeakLimiter {
+public:
+    static constexpr int    kMaxChannels   = 2;
+    static constexpr int    kOversample    = 4;
+    static constexpr int    kTapsPerPhase  = 12;
+    // Input samples the peak estimate trails its input by (centre of the interpolator)
+    static constexpr int    kFilterDelay   = kTapsPerPhase / 2 - 1;
+    static constexpr double kMaxLookaheadMs = 10.0;
+
+    TruePeakLimiter();
+
+    // Takes effect on the next prepare() (changes the latency)
+    void setLookaheadMs(double ms);
+    void setCeilingDb(float db);
+    void setReleaseMs(float ms);
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+    void process(juce::dsp::AudioBlock<float>& block) noexcept;
+
+    int   getLatencySamples() const noexcept { return lookahead_ + kFilterDelay; }
+    // Lowest gain applied since the last call (1 = no reduction); for metering and tests
+    float getAndResetMinGain() noexcept;
+
+    // Highest |sample| of the 4x-interpolated signal, skipping the first kTapsPerPhase - 1
+    // samples where the interpolator window is incomplete (also used by tests)
+    static float measureTruePeak(const float* data, int numSamples);
+
+private:
+    static constexpr int kLanes = 4;   // float lanes per history row (one SSE/NEON register)
+
+    float truePeak() const noexcept;
+    void  pushGain(float gain) noexcept;
+
+    double sampleRate_  = 44100.0;
+    double lookaheadMs_ = 1.5;
+    float  ceiling_     = 0.891251f;   // -1 dBFS
+    float  releaseMs_   = 50.f;
+    float  releaseCoeff_ = 0.f;
+    int    lookahead_   = 1;
+    int    numChannels_ = 2;
+
+    // Polyphase taps broadcast across lanes: [phase][tap][lane]
+    alignas(16) float coeffs_[kOversample][kTapsPerPhase][kLanes] {};
+    // Input history written twice (at w and w + kTapsPerPhase) so the newest kTapsPerPhase
+    // frames are always contiguous from row w: [row][lane], lane = channel
+    alignas(16) float history_[2 * kTapsPerPhase][kLanes] {};
+    int historyPos_ = 0;
+
+    // Sliding minimum over lookahead_ + 1 gains; head/tail are free-running (unsigned wrap)
+    std::vector<float>   dequeGain_;
+    std::vector<int64_t> dequeIndex_;
+    uint32_t dequeHead_ = 0, dequeTail_ = 0, dequeMask_ = 0;
+    int64_t sampleIndex_ = 0;
+
+    float               envelope_ = 1.f;
+    std::vector<float>  box_;   // last lookahead_ envelope values
+    double              boxSum_ = 0.0;
+    int                 boxPos_ = 0;
+
+    std::vector<float>  delay_[kMaxChannels];
+    int                 delayPos_ = 0;
+
+    float minGain_ = 1.f;
+};
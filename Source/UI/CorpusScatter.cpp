@@ -0,0 +1,329 @@
+#include "CorpusScatter.h"
+#include "../LookAndFeel/StitcherLookAndFeel.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr int   kTickMs    = 33;    // ~30 Hz, same cadence as the editor timer
+constexpr float kPointSize = 3.f;
+
+using Vec4 = std::array<float, 4>;
+using Mat4 = std::array<Vec4, 4>;
+
+Vec4 toVec(const Features& f) { return { f.zcr, f.rms, f.sc, f.st }; }
+
+float dot(const Vec4& a, const Vec4& b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+// Dominant eigenvector of a symmetric 4×4 matrix by power iteration.
+Vec4 dominantEigenvector(const Mat4& m, Vec4 v)
+{
+    for (int iter = 0; iter < 32; ++iter) {
+        Vec4 next {};
+        for (int r = 0; r < 4; ++r)
+            next[static_cast<size_t>(r)] = dot(m[static_cast<size_t>(r)], v);
+        const float norm = std::sqrt(dot(next, next));
+        if (norm < 1e-12f) break;
+        for (auto& x : next) x /= norm;
+        v = next;
+    }
+    return v;
+}
+
+} // namespace
+
+juce::Point<float> CorpusScatter::Basis::project(const Features& f) const noexcept
+{
+    const Vec4 v = toVec(f);
+    const Vec4 centred { v[0] - mean[0], v[1] - mean[1], v[2] - mean[2], v[3] - mean[3] };
+    const float x = (dot(axisX, centred) - minX) / (maxX - minX);
+    const float y = (dot(axisY, centred) - minY) / (maxY - minY);
+    return { juce::jlimit(0.f, 1.f, x), juce::jlimit(0.f, 1.f, y) };
+}
+
+CorpusScatter::CorpusScatter(SnapshotSource source)
+    : juce::Thread("Stitcher corpus scatter"), source_(std::move(source))
+{
+}
+
+CorpusScatter::~CorpusScatter()
+{
+    stopThread(1000);
+    cancelPendingUpdate();
+}
+
+void CorpusScatter::setProjection(Projection p)
+{
+    projection_.store(p);
+    notify();
+}
+
+juce::Rectangle<int> CorpusScatter::setLive(const Features& ctrl, int matchedIndex)
+{
+    liveCtrl_  = ctrl;
+    liveMatch_ = matchedIndex;
+
+    juce::Rectangle<float> area;
+    {
+        const juce::ScopedLock sl(lock_);
+        const auto c = toScreen(frontBasis_.project(ctrl));
+        area = juce::Rectangle<float>(c.x - 8.f, c.y - 8.f, 16.f, 16.f);   // ring plus stroke
+        if (matchedIndex >= 0 && matchedIndex < static_cast<int>(frontPositions_.size())) {
+            const auto m = toScreen(frontPositions_[static_cast<size_t>(matchedIndex)]);
+            area = area.getUnion({ m.x - 5.f, m.y - 5.f, 10.f, 10.f });
+        }
+    }
+    const auto now = area.getSmallestIntegerContainer();
+    if (now == markers_)
+        return {};
+    const auto dirty = now.getUnion(markers_);
+    markers_ = now;
+    return dirty.getIntersection(getLocalBounds());
+}
+
+juce::Point<float> CorpusScatter::toScreen(juce::Point<float> unit) const noexcept
+{
+    const float spanX = static_cast<float>(getWidth())  - 2.f * kPointSize;
+    const float spanY = static_cast<float>(getHeight()) - 2.f * kPointSize;
+    return { kPointSize + unit.x * spanX, kPointSize + (1.f - unit.y) * spanY };
+}
+
+void CorpusScatter::resized()
+{
+    width_.store(getWidth());
+    height_.store(getHeight());
+    notify();
+}
+
+void CorpusScatter::visibilityChanged()
+{
+    if (isVisible()) {
+        if (!isThreadRunning())
+            startThread(juce::Thread::Priority::low);
+    } else {
+        stopThread(1000);
+    }
+}
+
+void CorpusScatter::mouseDown(const juce::MouseEvent& e)
+{
+    if (e.mods.isPopupMenu())
+        return;   // the editor's corpus menu
+    setProjection(projection_.load() == Projection::CentroidRms ? Projection::Pca
+                                                                 : Projection::CentroidRms);
+}
+
+// ── Render thread ──────────────────────────────────────────────────────────
+
+void CorpusScatter::run()
+{
+    while (!threadShouldExit()) {
+        renderTick();
+        wait(kTickMs);
+    }
+}
+
+void CorpusScatter::renderTick()
+{
+    const int w = width_.load();
+    const int h = height_.load();
+    if (w < 8 || h < 8) return;
+    if (!source_ || !source_(snap_)) return;
+
+    const auto& cursor = snap_.cursor;
+    const auto  proj   = projection_.load();
+
+    const bool turnedOver = cursor.version - rebuildVersion_
+                          >= static_cast<uint64_t>(juce::jmax(1, cursor.count));
+    const bool needRebuild = !layer_.isValid()
+                          || layer_.getWidth() != w || layer_.getHeight() != h
+                          || proj != renderedProjection_
+                          || cursor.maxFrames != lastMaxFrames_
+                          || cursor.version < lastVersion_   // corpus was re-prepared
+                          || turnedOver;
+
+    if (!needRebuild && cursor.version == lastVersion_)
+        return;  // nothing new since the last tick
+
+    if (needRebuild) {
+        renderedProjection_ = proj;
+        basis_ = computeBasis(snap_.features, proj);
+    }
+
+    // Logical indices shift by one per push once the ring is full, so positions are
+    // re-projected every tick; this is a few flops per point, unlike redrawing them.
+    positions_.resize(snap_.features.size());
+    for (size_t i = 0; i < snap_.features.size(); ++i)
+        positions_[i] = basis_.project(snap_.features[i]);
+
+    bool layerChanged = needRebuild;
+    if (needRebuild) {
+        rebuild(w, h);
+    } else {
+        const auto fresh = static_cast<int>(
+            std::min<uint64_t>(cursor.version - lastVersion_, static_cast<uint64_t>(cursor.count)));
+        if (fresh > 0) {
+            juce::Graphics g(layer_);
+            plot(g, cursor.count - fresh, cursor.count, w, h);
+            layerChanged = true;
+        }
+    }
+
+    lastVersion_   = cursor.version;
+    lastMaxFrames_ = cursor.maxFrames;
+    publish(layerChanged);
+}
+
+void CorpusScatter::rebuild(int w, int h)
+{
+    layer_ = juce::Image(juce::Image::ARGB, w, h, true, juce::SoftwareImageType());
+    juce::Graphics g(layer_);
+    plot(g, 0, snap_.cursor.count, w, h);
+    rebuildVersion_ = snap_.cursor.version;
+}
+
+void CorpusScatter::plot(juce::Graphics& g, int firstIndex, int lastIndex, int w, int h)
+{
+    g.setColour(StitcherLookAndFeel::AccentDim.withAlpha(0.8f));
+    const float spanX = static_cast<float>(w) - 2.f * kPointSize;
+    const float spanY = static_cast<float>(h) - 2.f * kPointSize;
+    for (int i = juce::jmax(0, firstIndex); i < lastIndex; ++i) {
+        const auto p = positions_[static_cast<size_t>(i)];
+        g.fillEllipse(kPointSize + p.x * spanX - kPointSize * 0.5f,
+                      kPointSize + (1.f - p.y) * spanY - kPointSize * 0.5f,
+                      kPointSize, kPointSize);
+    }
+}
+
+void CorpusScatter::publish(bool layerChanged)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        if (layerChanged)   // the copy is a full-size blit; skip it when no point was drawn
+            front_ = layer_.createCopy();
+        frontBasis_     = basis_;
+        frontPositions_ = positions_;
+    }
+    triggerAsyncUpdate();
+}
+
+CorpusScatter::Basis CorpusScatter::computeBasis(const std::vector<Features>& feats, Projection p)
+{
+    Basis b;
+    const size_t n = feats.size();
+
+    if (p == Projection::Pca && n >= 3) {
+        // Standardise each feature, then take the top two eigenvectors of the
+        // correlation matrix; fold the scaling back into the axes.
+        Vec4 mean {}, stdev {};
+        for (const auto& f : feats) {
+            const Vec4 v = toVec(f);
+            for (size_t k = 0; k < 4; ++k) mean[k] += v[k];
+        }
+        for (auto& m : mean) m /= static_cast<float>(n);
+        for (const auto& f : feats) {
+            const Vec4 v = toVec(f);
+            for (size_t k = 0; k < 4; ++k) stdev[k] += (v[k] - mean[k]) * (v[k] - mean[k]);
+        }
+        for (auto& s : stdev) s = std::sqrt(s / static_cast<float>(n)) + 1e-6f;
+
+        Mat4 cov {};
+        for (const auto& f : feats) {
+            const Vec4 v = toVec(f);
+            Vec4 z {};
+            for (size_t k = 0; k < 4; ++k) z[k] = (v[k] - mean[k]) / stdev[k];
+            for (size_t r = 0; r < 4; ++r)
+                for (size_t c = 0; c < 4; ++c)
+                    cov[r][c] += z[r] * z[c];
+        }
+        for (auto& row : cov)
+            for (auto& x : row) x /= static_cast<float>(n);
+
+        const Vec4 e1 = dominantEigenvector(cov, { 0.5f, 0.5f, 0.5f, 0.5f });
+        Vec4 ce1 {};
+        for (size_t r = 0; r < 4; ++r) ce1[r] = dot(cov[r], e1);
+        const float lambda1 = dot(e1, ce1);
+        Mat4 deflated = cov;
+        for (size_t r = 0; r < 4; ++r)
+            for (size_t c = 0; c < 4; ++c)
+                deflated[r][c] -= lambda1 * e1[r] * e1[c];
+        const Vec4 e2 = dominantEigenvector(deflated, { 0.5f, -0.5f, 0.5f, -0.5f });
+
+        b.mean = mean;
+        for (size_t k = 0; k < 4; ++k) {
+            b.axisX[k] = e1[k] / stdev[k];
+            b.axisY[k] = e2[k] / stdev[k];
+        }
+    }
+
+    // Fit the view to the data (5 % padding); fall back to a unit range when degenerate.
+    if (n > 0) {
+        float minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+        float minY = minX, maxY = maxX;
+        for (const auto& f : feats) {
+            const Vec4 v = toVec(f);
+            const Vec4 c { v[0] - b.mean[0], v[1] - b.mean[1], v[2] - b.mean[2], v[3] - b.mean[3] };
+            const float x = dot(b.axisX, c);
+            const float y = dot(b.axisY, c);
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+        }
+        const float padX = juce::jmax(1e-3f, (maxX - minX) * 0.05f);
+        const float padY = juce::jmax(1e-3f, (maxY - minY) * 0.05f);
+        b.minX = minX - padX;  b.maxX = maxX + padX;
+        b.minY = minY - padY;  b.maxY = maxY + padY;
+    }
+    return b;
+}
+
+// ── Message thread ─────────────────────────────────────────────────────────
+
+void CorpusScatter::handleAsyncUpdate()
+{
+    repaint();
+}
+
+void CorpusScatter::paint(juce::Graphics& g)
+{
+    const auto bounds = getLocalBounds().toFloat();
+    g.setColour(StitcherLookAndFeel::Panel);
+    g.fillRoundedRectangle(bounds, 4.f);
+
+    juce::Image image;
+    Basis basis;
+    juce::Point<float> matchPos;
+    bool hasMatch = false;
+    {
+        const juce::ScopedLock sl(lock_);
+        image = front_;
+        basis = frontBasis_;
+        if (liveMatch_ >= 0 && liveMatch_ < static_cast<int>(frontPositions_.size())) {
+            matchPos = frontPositions_[static_cast<size_t>(liveMatch_)];
+            hasMatch = true;
+        }
+    }
+
+    if (image.isValid())
+        g.drawImageAt(image, 0, 0);
+
+    if (hasMatch) {
+        const auto m = toScreen(matchPos);
+        g.setColour(StitcherLookAndFeel::Accent);
+        g.fillEllipse(m.x - 4.f, m.y - 4.f, 8.f, 8.f);
+    }
+
+    // Control frame: hollow ring so it reads on top of a match at the same spot
+    const auto c = toScreen(basis.project(liveCtrl_));
+    g.setColour(StitcherLookAndFeel::Accent.withAlpha(0.8f));
+    g.drawEllipse(c.x - 6.f, c.y - 6.f, 12.f, 12.f, 1.5f);
+
+    g.setColour(StitcherLookAndFeel::Track.brighter(0.2f));
+    g.drawRoundedRectangle(bounds.reduced(0.5f), 4.f, 1.f);
+    g.setColour(StitcherLookAndFeel::TextDim);
+    g.setFont(juce::FontOptions(11.f));
+    g.drawText(projection_.load() == Projection::CentroidRms ? "Centroid / RMS" : "PCA",
+               getLocalBounds().reduced(6, 4), juce::Justification::bottomLeft, false);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../CorpusSnapshot.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+/**
+ * CorpusScatter — 2-D feature-space view of the corpus (CataRT style).
+ *
+ * The point cloud is drawn into a cached image on a background thread: each tick only
+ * frames pushed since the previous tick are plotted, and the layer is rebuilt from the
+ * full snapshot once the ring has turned over (so overwritten frames disappear), when
+ * the projection changes or when the component is resized.
+ *
+ * The message thread only blits the cached image and draws two markers (current control
+ * frame and chosen match), so paint() cost is independent of corpus size.
+ */
+class CorpusScatter : public juce::Component,
+                      private juce::Thread,
+                      private juce::AsyncUpdater {
+public:
+    enum class Projection { CentroidRms, Pca };
+
+    // Called on the render thread; must be lock-free with respect to the audio thread.
+    using SnapshotSource = std::function<bool(CorpusSnapshot&)>;
+
+    explicit CorpusScatter(SnapshotSource source);
+    ~CorpusScatter() override;
+
+    void setProjection(Projection p);
+
+    // Message thread (editor timer): latest control-frame features and matched logical index.
+    // Returns the region the two markers moved through (empty when neither moved a pixel).
+    juce::Rectangle<int> setLive(const Features& ctrl, int matchedIndex);
+
+    // Linear map Features → unit square, computed on the render thread at each rebuild.
+    struct Basis {
+        std::array<float, 4> mean  { 0.f, 0.f, 0.f, 0.f };
+        std::array<float, 4> axisX { 0.f, 0.f, 1.f, 0.f };  // default: centroid
+        std::array<float, 4> axisY { 0.f, 1.f, 0.f, 0.f };  // default: RMS
+        float minX = 0.f, maxX = 1.f, minY = 0.f, maxY = 1.f;
+
+        juce::Point<float> project(const Features& f) const noexcept;
+    };
+
+    // Pure function of the frames, so a given corpus always lands on the same layout.
+    static Basis computeBasis(const std::vector<Features>& frames, Projection p);
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void mouseDown(const juce::MouseEvent&) override;
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    void renderTick();
+    void rebuild(int w, int h);
+    void plot(juce::Graphics& g, int firstIndex, int lastIndex, int w, int h);
+    void publish(bool layerChanged);
+
+    SnapshotSource source_;
+
+    // Render-thread state
+    CorpusSnapshot snap_;
+    juce::Image    layer_;
+    Basis          basis_;
+    Projection     renderedProjection_ = Projection::CentroidRms;
+    uint64_t       lastVersion_        = 0;
+    uint64_t       rebuildVersion_     = 0;
+    int            lastMaxFrames_      = 0;
+    std::vector<juce::Point<float>> positions_;  // unit-square position per logical index
+
+    // Shared between render and message thread (guarded by lock_)
+    juce::CriticalSection            lock_;
+    juce::Image                      front_;
+    Basis                            frontBasis_;
+    std::vector<juce::Point<float>>  frontPositions_;
+
+    std::atomic<Projection> projection_ { Projection::CentroidRms };
+    std::atomic<int>        width_      { 0 };
+    std::atomic<int>        height_     { 0 };
+
+    // Message-thread state
+    Features liveCtrl_;
+    int      liveMatch_ = -1;
+    juce::Rectangle<int> markers_;   // screen area of the markers as last reported
+
+    juce::Point<float> toScreen(juce::Point<float> unit) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CorpusScatter)
+};
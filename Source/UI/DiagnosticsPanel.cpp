@@ -0,0 +1,122 @@
+#include "DiagnosticsPanel.h"
+#include "../LookAndFeel/StitcherLookAndFeel.h"
+
+namespace {
+constexpr int kRowH    = 16;
+constexpr int kHeaderH = 24;
+
+juce::String formatUs(double us)
+{
+    return us >= 1000.0 ? juce::String(us / 1000.0, 2) + " ms" : juce::String(us, 1) + " us";
+}
+
+juce::String formatLoad(double load) { return juce::String(load * 100.0, 1) + "%"; }
+} // namespace
+
+DiagnosticsPanel::DiagnosticsPanel(StageProfiler& profiler)
+    : profiler_(profiler)
+{
+    resetButton_.setTooltip("Clear the statistics");
+    resetButton_.onClick = [this] {
+        profiler_.reset();
+        stats_ = {};
+        repaint();
+    };
+    addAndMakeVisible(resetButton_);
+
+    exportButton_.setTooltip("Save the statistics (JSON) or the recent stage timeline (Chrome trace)");
+    exportButton_.onClick = [this] { showExportMenu(); };
+    addAndMakeVisible(exportButton_);
+}
+
+bool DiagnosticsPanel::tick()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+    if (now - lastReadMs_ < kReadIntervalMs)
+        return false;
+    lastReadMs_ = now;
+    stats_ = profiler_.getStats();
+    repaint();
+    return true;
+}
+
+void DiagnosticsPanel::showExportMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Statistics (JSON)...");
+    menu.addItem(2, "Stage timeline (Chrome trace)...");
+    menu.showMenuAsync(juce::PopupMenu::Options{}.withTargetComponent(&exportButton_),
+        [this](int result) {
+            if (result == 0) return;
+            const bool trace = result == 2;
+            chooser_ = std::make_unique<juce::FileChooser>(
+                trace ? "Save Chrome trace" : "Save DSP statistics",
+                juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                    .getChildFile(trace ? "stitcher-trace.json" : "stitcher-dsp-load.json"),
+                "*.json");
+            chooser_->launchAsync(
+                juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+                [this, trace](const juce::FileChooser& fc) {
+                    const auto file = fc.getResult();
+                    if (file == juce::File()) return;
+                    if (trace) profiler_.writeChromeTrace(file.withFileExtension("json"));
+                    else       profiler_.writeJson(file.withFileExtension("json"));
+                });
+        });
+}
+
+void DiagnosticsPanel::resized()
+{
+    auto header = getLocalBounds().reduced(6, 2).removeFromTop(kHeaderH - 2);
+    exportButton_.setBounds(header.removeFromRight(56).reduced(0, 2));
+    header.removeFromRight(4);
+    resetButton_.setBounds(header.removeFromRight(48).reduced(0, 2));
+}
+
+void DiagnosticsPanel::paint(juce::Graphics& g)
+{
+    g.setColour(StitcherLookAndFeel::Panel);
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.f);
+
+    auto area = getLocalBounds().reduced(8, 2);
+    g.setFont(juce::FontOptions(13.f));
+    g.setColour(StitcherLookAndFeel::TextBright);
+    g.drawText("DSP load", area.removeFromTop(kHeaderH), juce::Justification::centredLeft);
+
+    // Columns: stage | calls | mean | p99 | max
+    const int nameW = area.getWidth() * 28 / 100;
+    const int colW  = (area.getWidth() - nameW) / 4;
+    auto drawRow = [&](juce::Rectangle<int> row, const juce::String& name,
+                       const juce::StringArray& cells, juce::Colour colour) {
+        g.setColour(colour);
+        g.drawText(name, row.removeFromLeft(nameW), juce::Justification::centredLeft);
+        for (const auto& c : cells)
+            g.drawText(c, row.removeFromLeft(colW), juce::Justification::centredRight);
+    };
+
+    g.setFont(juce::FontOptions(11.f));
+    drawRow(area.removeFromTop(kRowH), "Stage", { "calls", "mean", "p99", "max" },
+            StitcherLookAndFeel::TextDim);
+
+    for (int i = 0; i < StageProfiler::kNumStages; ++i) {
+        const auto& st = stats_.stages[static_cast<size_t>(i)];
+        const auto row = area.removeFromTop(kRowH);
+        if (st.count == 0) {
+            drawRow(row, StageProfiler::getStageName(i), { "-", "", "", "" }, StitcherLookAndFeel::TextDim);
+            continue;
+        }
+        drawRow(row, StageProfiler::getStageName(i),
+                { juce::String(static_cast<juce::int64>(st.count)),
+                  formatUs(st.meanUs), formatUs(st.p99Us), formatUs(st.maxUs) },
+                i == StageProfiler::Block ? StitcherLookAndFeel::Accent : StitcherLookAndFeel::TextBright);
+    }
+
+    area.removeFromTop(6);
+    drawRow(area.removeFromTop(kRowH), "Deadline",
+            { juce::String(static_cast<juce::int64>(stats_.blocks)),
+              formatLoad(stats_.meanLoad), formatLoad(stats_.p99Load), formatLoad(stats_.maxLoad) },
+            StitcherLookAndFeel::TextBright);
+    g.setColour(stats_.overruns > 0 ? StitcherLookAndFeel::Accent : StitcherLookAndFeel::TextDim);
+    g.drawText(juce::String(static_cast<juce::int64>(stats_.overruns)) + " blocks over deadline",
+               area.removeFromTop(kRowH), juce::Justification::centredLeft);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../StageProfiler.h"
+
+/**
+ * DiagnosticsPanel — DSP load readout for the editor: mean / p99 / max time per
+ * processBlock stage and block-deadline utilisation, read from a StageProfiler.
+ *
+ * Message thread only. tick() is driven by the editor timer and re-reads the profiler
+ * a few times per second; Reset clears the statistics and Export writes them as JSON or
+ * the recent stage events as a Chrome trace.
+ */
+class DiagnosticsPanel : public juce::Component {
+public:
+    explicit DiagnosticsPanel(StageProfiler& profiler);
+
+    // Returns true if the panel repainted.
+    bool tick();
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+private:
+    static constexpr juce::uint32 kReadIntervalMs = 250;
+
+    void showExportMenu();
+
+    StageProfiler&       profiler_;
+    StageProfiler::Stats stats_;
+    juce::uint32         lastReadMs_ = 0;
+
+    juce::TextButton resetButton_  { "Reset" };
+    juce::TextButton exportButton_ { "Export" };
+    std::unique_ptr<juce::FileChooser> chooser_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsPanel)
+};
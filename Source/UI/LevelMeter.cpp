@@ -1,9 +1,36 @@
 #include "LevelMeter.h"
 #include "../LookAndFeel/StitcherLookAndFeel.h"
 
-void LevelMeter::setLevels(float l, float r) noexcept {
+juce::Rectangle<int> LevelMeter::setLevels(float l, float r) noexcept {
     peakL_ = juce::jlimit(0.f, 1.f, l);
     peakR_ = juce::jlimit(0.f, 1.f, r);
+
+    const int w2 = getWidth() / 2 - 1;
+    const int hL = fillHeight(peakL_);
+    const int hR = fillHeight(peakR_);
+
+    juce::Rectangle<int> dirty;
+    if (hL != shownL_) dirty = barSpan(0, shownL_, hL);
+    if (hR != shownR_) dirty = dirty.getUnion(barSpan(w2 + 2, shownR_, hR));
+    shownL_ = hL;
+    shownR_ = hR;
+    return dirty;
+}
+
+int LevelMeter::fillHeight(float peak) const noexcept
+{
+    return juce::roundToInt(static_cast<float>(getHeight()) * peak);
+}
+
+// Vertical band between two fill heights, widened by the corner radius so the
+// rounded top of the bar is redrawn as it moves.
+juce::Rectangle<int> LevelMeter::barSpan(int x, int fromH, int toH) const noexcept
+{
+    const int h   = getHeight();
+    const int top = h - juce::jmax(fromH, toH) - 2;
+    const int bot = h - juce::jmin(fromH, toH) + 2;
+    return juce::Rectangle<int>(x, top, getWidth() / 2 - 1, bot - top)
+               .getIntersection(getLocalBounds());
 }
 
 void LevelMeter::paint(juce::Graphics& g)
@@ -18,8 +45,9 @@ void LevelMeter::paint(juce::Graphics& g)
         g.setColour(StitcherLookAndFeel::Track);
         g.fillRoundedRectangle(bg.toFloat(), 2.f);
 
-        if (peak > 0.f) {
-            const float fillH = static_cast<float>(h) * peak;
+        // Whole-pixel fill height, matching the change detection in setLevels()
+        if (const int fillPx = fillHeight(peak); fillPx > 0) {
+            const float fillH = static_cast<float>(fillPx);
             juce::Rectangle<float> fill{static_cast<float>(x), static_cast<float>(h) - fillH,
                                         static_cast<float>(w2), fillH};
             g.setColour(StitcherLookAndFeel::Accent);
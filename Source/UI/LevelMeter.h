@@ -4,10 +4,19 @@
 class LevelMeter : public juce::Component {
 public:
     LevelMeter() = default;
-    void setLevels(float peakL, float peakR) noexcept;
+
+    // Returns the region whose rendering changed: bar heights are compared in whole
+    // pixels, so sub-pixel peak jitter does not invalidate anything.
+    juce::Rectangle<int> setLevels(float peakL, float peakR) noexcept;
+
     void paint(juce::Graphics&) override;
 private:
+    int fillHeight(float peak) const noexcept;
+    juce::Rectangle<int> barSpan(int x, int fromH, int toH) const noexcept;
+
     float peakL_ = 0.f;
     float peakR_ = 0.f;
+    int   shownL_ = 0;   // filled pixels as of the last returned region
+    int   shownR_ = 0;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
 };
@@ -1,22 +1,129 @@
 #include "MatchVisualizer.h"
 #include "../LookAndFeel/StitcherLookAndFeel.h"
+#include <cmath>
 
-void MatchVisualizer::tick(float ctrlRms, int matchedIndex, float corpusFill, uint32_t matchEpoch)
+namespace {
+// Alpha for a top-track block (small RMS values are scaled up to stay visible)
+float historyAlpha(float rms) { return juce::jlimit(0.15f, 1.0f, rms * 4.f); }
+
+uint8_t quantise(float v01) { return static_cast<uint8_t>(juce::jlimit(0.f, 1.f, v01) * 63.f + 0.5f); }
+} // namespace
+
+void MatchVisualizer::addMatchEvents(const MatchEvent* events, int numEvents) noexcept
+{
+    const int filled = filledSlots();
+    for (int i = 0; i < numEvents; ++i) {
+        const auto& e = events[i];
+        pendingPeakRms_ = juce::jmax(pendingPeakRms_, e.ctrl.rms);
+        if (const int slot = displaySlot(e.matchedIndex, filled); slot >= 0)
+            slotPulse_[static_cast<size_t>(slot)] = 1.f;
+    }
+}
+
+juce::Rectangle<int> MatchVisualizer::tick(float ctrlRms, int matchedIndex,
+                                           const CorpusCursor& corpus, double elapsedSeconds)
 {
-    // Push to ring buffer (overwrite oldest)
-    ctrlHistory_[historyHead_] = ctrlRms;
+    // Push to ring buffer (overwrite oldest). With events pending, the loudest control
+    // frame since the last tick is shown rather than whichever one happened to be last.
+    ctrlHistory_[historyHead_] = pendingPeakRms_ >= 0.f ? pendingPeakRms_ : ctrlRms;
     historyHead_ = (historyHead_ + 1) % kSlots;
     if (historyCount_ < kSlots) ++historyCount_;
+    pendingPeakRms_ = -1.f;
+
+    const auto decay = static_cast<float>(std::exp(-juce::jmax(0.0, elapsedSeconds) / kPulseDecaySeconds));
+    for (auto& p : slotPulse_)
+        p *= decay;
+
+    matchedIndex_    = matchedIndex;
+    corpusCount_     = corpus.count;
+    corpusMaxFrames_ = juce::jmax(1, corpus.maxFrames);
+
+    // Dirty-region tracking: compare what paint() would draw now with what was last
+    // reported. A constant RMS scrolls into an identical top track, so a steady signal
+    // (or silence) produces no top-track repaint at all.
+    const auto now = visualState();
+    juce::Rectangle<int> dirty;
+    if (now.history != painted_.history)
+        dirty = trackBounds(false);
+
+    if (now.filledSlots != painted_.filledSlots) {
+        const int lo = juce::jmin(now.filledSlots, painted_.filledSlots);
+        const int hi = juce::jmax(now.filledSlots, painted_.filledSlots) - 1;
+        dirty = dirty.getUnion(slotBlock(lo, true).getUnion(slotBlock(hi, true))
+                                   .getSmallestIntegerContainer());
+    }
+    for (int slot = 0; slot < kSlots; ++slot) {
+        const bool matchMoved = (slot == now.matchSlot || slot == painted_.matchSlot)
+                             && now.matchSlot != painted_.matchSlot;
+        if (matchMoved || now.pulse[static_cast<size_t>(slot)] != painted_.pulse[static_cast<size_t>(slot)])
+            dirty = dirty.getUnion(slotBlock(slot, true).expanded(3.f)   // glow radius
+                                       .getSmallestIntegerContainer());
+    }
+
+    painted_ = now;
+    return dirty.getIntersection(getLocalBounds());
+}
 
-    if (matchEpoch != lastMatchEpoch_)
-        matchPulse_ = 1.f;
-    lastMatchEpoch_ = matchEpoch;
-    matchPulse_ *= 0.78f;  // ~150 ms 1/e decay at 30 Hz
+// ── Geometry ───────────────────────────────────────────────────────────────
 
-    matchedIndex_ = matchedIndex;
-    corpusFill_   = corpusFill;
+juce::Rectangle<int> MatchVisualizer::trackBounds(bool bottom) const noexcept
+{
+    const int H       = getHeight();
+    const int trackH  = (H - 6) / 2;           // height for each track (2px gap between)
+    const int gap     = H - 2 * trackH - 2;    // remaining gap (at least 2px)
+    const int topY    = 1;
+    const int bottomY = topY + trackH + gap + 2;
+    return { 1, bottom ? bottomY : topY, getWidth() - 2, trackH };
+}
+
+juce::Rectangle<float> MatchVisualizer::slotBlock(int slot, bool bottom) const noexcept
+{
+    const auto track     = trackBounds(bottom);
+    const float blockW   = static_cast<float>(getWidth() - 2) / static_cast<float>(kSlots);
+    const float blockPad = std::max(1.f, blockW * 0.1f);
+    const float bx       = 1.f + static_cast<float>(slot) * blockW;
+    return { bx + blockPad, static_cast<float>(track.getY()),
+             blockW - 2.f * blockPad, static_cast<float>(track.getHeight()) };
 }
 
+int MatchVisualizer::filledSlots() const noexcept
+{
+    // Display slots cover the whole ring capacity: slot s spans logical corpus indices
+    // [s * maxFrames / kSlots, (s + 1) * maxFrames / kSlots), oldest on the left.
+    const float framesPerSlot = static_cast<float>(corpusMaxFrames_) / static_cast<float>(kSlots);
+    return juce::jlimit(0, kSlots,
+        static_cast<int>(std::ceil(static_cast<float>(corpusCount_) / framesPerSlot)));
+}
+
+int MatchVisualizer::displaySlot(int logicalIndex, int filled) const noexcept
+{
+    if (logicalIndex < 0 || logicalIndex >= corpusCount_ || filled <= 0)
+        return -1;
+    const float framesPerSlot = static_cast<float>(corpusMaxFrames_) / static_cast<float>(kSlots);
+    return juce::jlimit(0, filled - 1,
+        static_cast<int>(static_cast<float>(logicalIndex) / framesPerSlot));
+}
+
+MatchVisualizer::VisualState MatchVisualizer::visualState() const noexcept
+{
+    VisualState s;
+    for (int slot = 0; slot < kSlots; ++slot) {
+        if (historyCount_ < kSlots && slot >= historyCount_)
+            continue;  // not yet filled — drawn as empty (0)
+        const int ringIdx = historyCount_ < kSlots ? slot : (historyHead_ + slot) % kSlots;
+        s.history[static_cast<size_t>(slot)] = static_cast<uint8_t>(1 + quantise(historyAlpha(ctrlHistory_[ringIdx])));
+    }
+    for (int slot = 0; slot < kSlots; ++slot) {
+        const float p = slotPulse_[static_cast<size_t>(slot)];
+        s.pulse[static_cast<size_t>(slot)] = p > 0.01f ? quantise(p) : 0;
+    }
+    s.filledSlots = filledSlots();
+    s.matchSlot   = displaySlot(matchedIndex_, s.filledSlots);
+    return s;
+}
+
+// ── Paint ──────────────────────────────────────────────────────────────────
+
 void MatchVisualizer::paint(juce::Graphics& g)
 {
     const int W = getWidth();
@@ -29,14 +136,6 @@ void MatchVisualizer::paint(juce::Graphics& g)
     g.setColour(StitcherLookAndFeel::Track.brighter(0.2f));
     g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(0.5f), 3.f, 1.f);
 
-    const int trackH    = (H - 6) / 2;  // height for each track (2px gap between)
-    const int gap       = H - 2 * trackH - 2;  // remaining gap (at least 2px)
-    const int topY      = 1;
-    const int bottomY   = topY + trackH + gap + 2;
-
-    const float blockW  = static_cast<float>(W - 2) / static_cast<float>(kSlots);
-    const float blockPad = std::max(1.f, blockW * 0.1f);
-
     // ── Top track: ctrl RMS history ────────────────────────────────────────
     // Draw slots left=oldest, right=newest
     // historyHead_ points to the oldest valid entry (or the next-to-write if full)
@@ -53,57 +152,29 @@ void MatchVisualizer::paint(juce::Graphics& g)
         } else {
             ringIdx = (historyHead_ + slot) % kSlots;
         }
-        const float rms = ctrlHistory_[ringIdx];
-        const float alpha = juce::jlimit(0.15f, 1.0f, rms * 4.f);  // scale up small RMS values
-
-        const float bx = 1.f + slot * blockW;
-        const juce::Rectangle<float> block(bx + blockPad, static_cast<float>(topY),
-                                           blockW - 2.f * blockPad, static_cast<float>(trackH));
+        const float alpha = historyAlpha(ctrlHistory_[ringIdx]);
 
         g.setColour(StitcherLookAndFeel::Accent.withAlpha(alpha));
-        g.fillRoundedRectangle(block, 1.f);
+        g.fillRoundedRectangle(slotBlock(slot, false), 1.f);
     }
 
     // ── Bottom track: corpus slots ─────────────────────────────────────────
-    const int filledSlots = juce::jlimit(0, kSlots,
-                                static_cast<int>(std::round(corpusFill_ * kSlots)));
-
-    // Which display slot corresponds to the matched corpus index?
-    // corpusFill_ * kSlots gives filled count. matchedIndex_ is the logical index in CorpusStore.
-    // Map matchedIndex_ to display slot: scale to [0, kSlots-1]
-    // If corpusFill_ == 0, no match slot.
-    int matchDisplaySlot = -1;
-    if (matchedIndex_ >= 0 && filledSlots > 0) {
-        // Corpus logical indices [0..corpusFill_*maxFrames-1] map to display [0..kSlots-1]
-        // We don't know maxFrames here, so use a simpler heuristic:
-        // Assume matchedIndex_ is in [0, filledSlots*scale-1].
-        // Actually corpusFill = size/maxFrames; matchedIndex = [0, size-1].
-        // So slot = round(matchedIndex_ / size * (kSlots-1)) ... but we don't know size here.
-        // Simplest: use corpusFill to estimate size = round(corpusFill * maxSlots).
-        // We'll just map matchedIndex_ mod filledSlots to the display slot.
-        // Actually, the simplest correct approach:
-        //   matched_slot = matchedIndex_ * kSlots / max(1, round(corpusFill * kSlots))
-        // but capped at kSlots-1.
-        matchDisplaySlot = juce::jlimit(0, kSlots - 1,
-            static_cast<int>(static_cast<float>(matchedIndex_) /
-                             static_cast<float>(juce::jmax(1, filledSlots)) * kSlots));
-        matchDisplaySlot = juce::jlimit(0, filledSlots - 1, matchDisplaySlot);
-    }
+    const int filled = filledSlots();
+    const int matchSlot = displaySlot(matchedIndex_, filled);
 
     for (int slot = 0; slot < kSlots; ++slot) {
-        const float bx = 1.f + slot * blockW;
-        const juce::Rectangle<float> block(bx + blockPad, static_cast<float>(bottomY),
-                                           blockW - 2.f * blockPad, static_cast<float>(trackH));
+        const auto block = slotBlock(slot, true);
 
-        if (slot < filledSlots) {
-            const bool isMatch = (slot == matchDisplaySlot);
-            if (isMatch && matchPulse_ > 0.01f) {
+        if (slot < filled) {
+            const bool  isMatch = (slot == matchSlot);
+            const float pulse   = slotPulse_[static_cast<size_t>(slot)];
+            if (pulse > 0.01f) {
                 // Outer glow
-                g.setColour(StitcherLookAndFeel::Accent.withAlpha(0.4f * matchPulse_));
+                g.setColour(StitcherLookAndFeel::Accent.withAlpha(0.4f * pulse));
                 g.fillRoundedRectangle(block.expanded(2.f), 2.f);
-                // Blended fill: AccentDim → Accent by pulse
+                // Blended fill: AccentDim → Accent by pulse (latest match stays lit)
                 auto colour = StitcherLookAndFeel::AccentDim.interpolatedWith(
-                    StitcherLookAndFeel::Accent, matchPulse_);
+                    StitcherLookAndFeel::Accent, isMatch ? 1.f : pulse);
                 g.setColour(colour);
             } else {
                 g.setColour(isMatch ? StitcherLookAndFeel::Accent
@@ -1,5 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
+#include "../CorpusSnapshot.h"
+#include "../MatchEventQueue.h"
 #include <array>
 #include <cstdint>
 
@@ -7,23 +9,53 @@ class MatchVisualizer : public juce::Component {
 public:
     static constexpr int kSlots = 32;
 
-    // Called from 30Hz timer — push latest ctrl RMS, update matched index and fill.
-    // matchEpoch increments every grain hand-off in the processor (regardless of index).
-    void tick(float ctrlRms, int matchedIndex, float corpusFill, uint32_t matchEpoch);
+    // Match events drained from the processor since the last tick. Every event pulses the
+    // display slot it landed in, so bursts of short frames between two ticks all show up.
+    void addMatchEvents(const MatchEvent* events, int numEvents) noexcept;
+
+    // Called from the editor timer — push latest ctrl RMS, update matched index and corpus cursor.
+    // elapsedSeconds is the time since the previous tick, so pulses fade at the same speed
+    // whatever rate the timer runs at.
+    // Returns the region whose rendering changed (empty when the view is visually unchanged).
+    juce::Rectangle<int> tick(float ctrlRms, int matchedIndex, const CorpusCursor& corpus,
+                              double elapsedSeconds);
 
     void paint(juce::Graphics&) override;
 
 private:
+    // Quantised snapshot of everything paint() draws, used for change detection.
+    struct VisualState {
+        std::array<uint8_t, kSlots> history {};  // top-track alpha per display slot
+        std::array<uint8_t, kSlots> pulse {};    // bottom-track pulse per display slot
+        int     filledSlots = 0;
+        int     matchSlot   = -1;
+
+        bool operator==(const VisualState& o) const noexcept {
+            return history == o.history && pulse == o.pulse
+                && filledSlots == o.filledSlots && matchSlot == o.matchSlot;
+        }
+    };
+
+    VisualState visualState() const noexcept;
+    int  filledSlots() const noexcept;
+    int  displaySlot(int logicalIndex, int filled) const noexcept;
+    juce::Rectangle<int> trackBounds(bool bottom) const noexcept;
+    juce::Rectangle<float> slotBlock(int slot, bool bottom) const noexcept;
+
     // Ring buffer for top-track ctrl RMS history
     std::array<float, kSlots> ctrlHistory_ {};
     int historyHead_ = 0;   // index of oldest slot (newest = (historyHead_ - 1 + kSlots) % kSlots)
     int historyCount_ = 0;  // number of valid entries (0..kSlots)
 
     // Most recent values from tick()
-    int   matchedIndex_  = -1;
-    float corpusFill_    = 0.f;
+    int   matchedIndex_    = -1;
+    int   corpusCount_     = 0;
+    int   corpusMaxFrames_ = 1;
+
+    // Pulse animation: every match event lights its slot, decaying with a fixed time constant
+    static constexpr double kPulseDecaySeconds = 0.134;   // 1/e
+    std::array<float, kSlots> slotPulse_ {};   // 0..1
+    float pendingPeakRms_ = -1.f;              // loudest ctrl frame since last tick (-1 = none)
 
-    // Pulse animation: fires on every grain hand-off (epoch-driven, not index-driven)
-    uint32_t lastMatchEpoch_ = 0;
-    float    matchPulse_     = 0.f;   // 0..1
+    VisualState painted_;  // state as of the last returned dirty region
 };
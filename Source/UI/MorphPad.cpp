@@ -12,12 +12,41 @@ void MorphPad::setParams(juce::RangedAudioParameter* zcr,
     paramSt_  = st;
 }
 
-void MorphPad::setLiveLevels(float zcr, float rms, float sc, float st)
+namespace {
+constexpr float kDotRadius = 8.f;
+constexpr float kDotOffset = 12.f;  // centre distance from each corner edge
+
+float dotAlpha(float level) { return juce::jmax(0.15f, level); }
+} // namespace
+
+juce::Rectangle<int> MorphPad::setLiveLevels(float zcr, float rms, float sc, float st)
 {
     liveZcr_.store(juce::jlimit(0.f, 1.f, zcr));
     liveRms_.store(juce::jlimit(0.f, 1.f, rms));
     liveSc_ .store(juce::jlimit(0.f, 1.f, sc));
     liveSt_ .store(juce::jlimit(0.f, 1.f, st));
+
+    // Only the corner dots depend on live levels; compare alpha at 8-bit colour
+    // resolution so repaints track what actually reaches the screen.
+    const float levels[4] = { liveZcr_.load(), liveRms_.load(), liveSc_.load(), liveSt_.load() };
+    juce::Rectangle<int> dirty;
+    for (int i = 0; i < 4; ++i) {
+        const int shown = juce::roundToInt(dotAlpha(levels[i]) * 255.f);
+        if (shown != shownDots_[static_cast<size_t>(i)]) {
+            shownDots_[static_cast<size_t>(i)] = shown;
+            dirty = dirty.getUnion(cornerDot(i).expanded(1.f).getSmallestIntegerContainer());
+        }
+    }
+
+    // The crosshair spans the whole pad, so a thumb move invalidates everything.
+    const auto thumb = thumbFromWeights();
+    const juce::Point<int> thumbPx { juce::roundToInt(thumb.x * static_cast<float>(getWidth())),
+                                     juce::roundToInt(thumb.y * static_cast<float>(getHeight())) };
+    if (thumbPx != shownThumb_) {
+        shownThumb_ = thumbPx;
+        dirty = getLocalBounds();
+    }
+    return dirty;
 }
 
 // ── Static math helpers ────────────────────────────────────────────────────
@@ -65,6 +94,14 @@ void MorphPad::writeWeightsFromThumb(juce::Point<float> normPos)
     if (paramSt_)  paramSt_ ->setValueNotifyingHost(paramSt_ ->convertTo0to1(st));
 }
 
+juce::Rectangle<float> MorphPad::cornerDot(int i) const noexcept
+{
+    const auto bounds = getLocalBounds().toFloat();
+    const float cx = (i % 2 == 0) ? bounds.getX() + kDotOffset : bounds.getRight()  - kDotOffset;
+    const float cy = (i < 2)      ? bounds.getY() + kDotOffset : bounds.getBottom() - kDotOffset;
+    return { cx - kDotRadius, cy - kDotRadius, kDotRadius * 2.f, kDotRadius * 2.f };
+}
+
 juce::Point<float> MorphPad::normFromMouseEvent(const juce::MouseEvent& e) const
 {
     const auto b = getLocalBounds().toFloat();
@@ -110,31 +147,11 @@ void MorphPad::paint(juce::Graphics& g)
         g.drawLine(bounds.getX(), yLine, bounds.getRight(), yLine, 1.f);
     }
 
-    // Corner glow dots
-    const float dotRadius = 8.f;
-    const float dotOffset = 12.f;  // centre distance from each corner edge
-
-    struct CornerDot {
-        float cx, cy;
-        float liveLevel;
-    };
-
-    const CornerDot dots[4] = {
-        // TL — ZCR
-        { bounds.getX() + dotOffset,                bounds.getY() + dotOffset,                liveZcr_.load() },
-        // TR — RMS
-        { bounds.getRight() - dotOffset,            bounds.getY() + dotOffset,                liveRms_.load() },
-        // BL — SC
-        { bounds.getX() + dotOffset,                bounds.getBottom() - dotOffset,           liveSc_.load()  },
-        // BR — ST
-        { bounds.getRight() - dotOffset,            bounds.getBottom() - dotOffset,           liveSt_.load()  },
-    };
-
-    for (const auto& dot : dots) {
-        const float alpha = juce::jmax(0.15f, dot.liveLevel);
-        g.setColour(StitcherLookAndFeel::Accent.withAlpha(alpha));
-        g.fillEllipse(dot.cx - dotRadius, dot.cy - dotRadius,
-                      dotRadius * 2.f, dotRadius * 2.f);
+    // Corner glow dots: TL — ZCR, TR — RMS, BL — SC, BR — ST
+    const float levels[4] = { liveZcr_.load(), liveRms_.load(), liveSc_.load(), liveSt_.load() };
+    for (int i = 0; i < 4; ++i) {
+        g.setColour(StitcherLookAndFeel::Accent.withAlpha(dotAlpha(levels[i])));
+        g.fillEllipse(cornerDot(i));
     }
 
     // Thumb crosshair + circle
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <atomic>
 
 class MorphPad : public juce::Component {
@@ -12,8 +13,10 @@ public:
                    juce::RangedAudioParameter* sc,
                    juce::RangedAudioParameter* st);
 
-    // Called from 30Hz timer in PluginEditor
-    void setLiveLevels(float zcr, float rms, float sc, float st);
+    // Called from the editor timer. Returns the union of the corner dots whose drawn
+    // alpha changed, or the whole pad if the thumb moved through automation/MIDI
+    // (empty when nothing visible changed).
+    juce::Rectangle<int> setLiveLevels(float zcr, float rms, float sc, float st);
 
     // ── Pure math helpers (also called by tests) ──────────────────────────
     // Bilinear forward: thumb (x,y) → weights
@@ -35,6 +38,9 @@ private:
     // Compute weights from thumb position and write to APVTS
     void writeWeightsFromThumb(juce::Point<float> normPos);
 
+    // Bounds of corner dot i (0 = TL/ZCR, 1 = TR/RMS, 2 = BL/SC, 3 = BR/ST)
+    juce::Rectangle<float> cornerDot(int i) const noexcept;
+
     // Clamp mouse position to bounds and normalise to [0,1]^2
     juce::Point<float> normFromMouseEvent(const juce::MouseEvent& e) const;
 
@@ -49,5 +55,9 @@ private:
     std::atomic<float> liveSc_  { 0.f };
     std::atomic<float> liveSt_  { 0.f };
 
+    // Quantised dot alpha as of the last returned dirty region
+    std::array<int, 4> shownDots_ { -1, -1, -1, -1 };
+    juce::Point<int>   shownThumb_ { -1, -1 };  // thumb position in pixels
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorphPad)
 };
@@ -67,6 +67,18 @@ void PresetBar::mouseDown(const juce::MouseEvent& e)
         showPresetMenu();
 }
 
+// Scrolling over the preset name steps through the presets
+void PresetBar::mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+{
+    if (e.eventComponent != &presetNameLabel_ || wheel.deltaY == 0.f)
+        return;
+    if (wheel.deltaY < 0.f)
+        presetManager_.selectNext();
+    else
+        presetManager_.selectPrev();
+    updateLabel();
+}
+
 void PresetBar::updateLabel()
 {
     auto name = presetManager_.getCurrentPresetName();
@@ -78,6 +90,17 @@ void PresetBar::showPresetMenu()
 {
     juce::PopupMenu menu;
     menu.addItem(1, "Init");
+    menu.addItem(2, "Search...");
+
+    // Loading a preset or an A/B slot glides over this time instead of jumping
+    static constexpr double kMorphTimes[] = { 0.0, 0.5, 1.0, 2.0, 4.0 };
+    juce::PopupMenu morphMenu;
+    for (int i = 0; i < 5; ++i) {
+        const double t = kMorphTimes[i];
+        morphMenu.addItem(10 + i, t == 0.0 ? juce::String("Off") : juce::String(t, 1) + " s",
+                          true, presetManager_.getMorphTime() == t);
+    }
+    menu.addSubMenu("Morph time", morphMenu);
     menu.addSeparator();
 
     const auto cats = presetManager_.getCategoryNames();
@@ -110,6 +133,10 @@ void PresetBar::showPresetMenu()
             if (safeThis == nullptr || result == 0) return;
             if (result == 1) {
                 safeThis->presetManager_.initPreset();
+            } else if (result == 2) {
+                safeThis->showSearchDialog();
+            } else if (result >= 10 && result < 15) {
+                safeThis->presetManager_.setMorphTime(kMorphTimes[result - 10]);
             } else {
                 auto it = idToPreset.find(result);
                 if (it != idToPreset.end())
@@ -119,6 +146,45 @@ void PresetBar::showPresetMenu()
         });
 }
 
+void PresetBar::showSearchDialog()
+{
+    auto* dlg = new juce::AlertWindow("Find Preset",
+                                      "Type part of a preset name:",
+                                      juce::MessageBoxIconType::NoIcon);
+    dlg->addTextEditor("query", {}, "Search:");
+    dlg->addButton("Find",   1, juce::KeyPress(juce::KeyPress::returnKey));
+    dlg->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<PresetBar> safeThis(this);
+
+    dlg->enterModalState(true, juce::ModalCallbackFunction::create(
+        [safeThis, dlg](int result) {
+            if (result == 1 && safeThis != nullptr) {
+                auto query = dlg->getTextEditorContents("query").trim();
+                if (query.isNotEmpty())
+                    safeThis->showSearchResults(safeThis->presetManager_.searchPresets(query));
+            }
+            delete dlg;
+        }), false);
+}
+
+void PresetBar::showSearchResults(const juce::StringArray& names)
+{
+    juce::PopupMenu menu;
+    if (names.isEmpty())
+        menu.addItem(-1, "No matching presets", false);
+    for (int i = 0; i < names.size(); ++i)
+        menu.addItem(i + 1, names[i]);
+
+    juce::Component::SafePointer<PresetBar> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options{}.withTargetComponent(&presetNameLabel_),
+        [safeThis, names](int result) {
+            if (safeThis == nullptr || result <= 0) return;
+            safeThis->presetManager_.loadPreset(names[result - 1]);
+            safeThis->updateLabel();
+        });
+}
+
 void PresetBar::showSaveAsDialog()
 {
     auto* dlg = new juce::AlertWindow("Save Preset",
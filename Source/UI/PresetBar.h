@@ -8,6 +8,7 @@ public:
     void resized() override;
     void paint(juce::Graphics&) override;
     void mouseDown(const juce::MouseEvent& e) override;
+    void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
 
     std::function<void(int)> onCaptureSlot;
     std::function<void(int)> onLoadSlot;
@@ -23,6 +24,8 @@ private:
     void updateLabel();
     void showSaveAsDialog();
     void showPresetMenu();
+    void showSearchDialog();
+    void showSearchResults(const juce::StringArray& names);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBar)
 };
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * RefreshGovernor — picks the editor timer rate from visibility and activity.
+ *
+ * Active (something visibly changed recently): full 30 Hz.
+ * Idle (nothing changed for kIdleAfterTicks consecutive ticks): 10 Hz, enough to
+ * notice new activity within ~100 ms, at which point the rate snaps back to 30 Hz.
+ * Hidden (editor not showing — minimised, other tab, occluded host window): 4 Hz,
+ * which still services MIDI-learn capture.
+ *
+ * Message-thread only; header-only so tests can drive it without an editor.
+ */
+class RefreshGovernor {
+public:
+    static constexpr int kActiveHz       = 30;
+    static constexpr int kIdleHz         = 10;
+    static constexpr int kHiddenHz       = 4;
+    static constexpr int kIdleAfterTicks = 30;  // ~1 s of quiet at the active rate
+
+    // Call once per timer tick; returns the rate the timer should run at next.
+    int update(bool showing, bool changed) noexcept
+    {
+        if (!showing) {
+            quietTicks_ = kIdleAfterTicks;  // resume at the idle rate until activity shows up
+            rateHz_ = kHiddenHz;
+            return rateHz_;
+        }
+        if (changed)
+            quietTicks_ = 0;
+        else if (quietTicks_ < kIdleAfterTicks)
+            ++quietTicks_;
+
+        rateHz_ = quietTicks_ >= kIdleAfterTicks ? kIdleHz : kActiveHz;
+        return rateHz_;
+    }
+
+    int rateHz() const noexcept { return rateHz_; }
+
+private:
+    int quietTicks_ = 0;
+    int rateHz_     = kActiveHz;
+};
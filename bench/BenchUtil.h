@@ -0,0 +1,17 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <JuceHeader.h>
+
+// Reported as time per audio sample: the counter divides elapsed time by samples·1e-9.
+inline benchmark::Counter nsPerSample(double samples)
+{
+    return benchmark::Counter(samples * 1.0e-9,
+                              benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+inline void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& rng, float level = 0.5f)
+{
+    for (int c = 0; c < buffer.getNumChannels(); ++c)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(c, i, (rng.nextFloat() * 2.f - 1.f) * level);
+}
@@ -0,0 +1,104 @@
+// Feature extraction, corpus writes and matching: the per-frame work of the grain engine.
+#include "BenchUtil.h"
+#include "CycleClock.h"
+#include "FeatureExtractor.h"
+#include "CorpusStore.h"
+#include "ConcatenativeMatcher.h"
+#include <vector>
+
+namespace {
+
+// Weight presets for the matcher sweep: RMS only (the default) and all four features
+void applyWeights(ConcatenativeMatcher& m, int preset)
+{
+    if (preset == 0) m.setWeights(0.f, 1.f, 0.f, 0.f);
+    else             m.setWeights(1.f, 1.f, 1.f, 1.f);
+}
+
+Features randomFeatures(juce::Random& rng)
+{
+    return { rng.nextFloat(), rng.nextFloat(), rng.nextFloat(), rng.nextFloat() };
+}
+
+void fillCorpus(CorpusStore& corpus, int frameSize, int frames, juce::Random& rng)
+{
+    juce::AudioBuffer<float> audio(2, frameSize);
+    fillNoise(audio, rng);
+    for (int i = 0; i < frames; ++i)
+        corpus.push(audio.getReadPointer(0), audio.getReadPointer(1), randomFeatures(rng));
+}
+
+} // namespace
+
+// args: frame size
+static void BM_FeatureExtract(benchmark::State& state)
+{
+    const int frameSize = static_cast<int>(state.range(0));
+    FeatureExtractor fx;
+    fx.prepare(frameSize);
+    juce::AudioBuffer<float> frame(1, frameSize);
+    juce::Random rng(1);
+    fillNoise(frame, rng);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fx.extract(frame.getReadPointer(0), frameSize));
+
+    state.counters["ns/sample"] = nsPerSample(static_cast<double>(state.iterations()) * frameSize);
+}
+BENCHMARK(BM_FeatureExtract)->RangeMultiplier(2)->Range(64, 8192);
+
+// args: frame size, corpus capacity (frames)
+static void BM_CorpusPush(benchmark::State& state)
+{
+    const int frameSize = static_cast<int>(state.range(0));
+    const int maxFrames = static_cast<int>(state.range(1));
+    CorpusStore corpus;
+    corpus.prepare(frameSize, maxFrames);
+    juce::AudioBuffer<float> audio(2, frameSize);
+    juce::Random rng(2);
+    fillNoise(audio, rng);
+    const Features f = randomFeatures(rng);
+
+    for (auto _ : state) {
+        corpus.push(audio.getReadPointer(0), audio.getReadPointer(1), f);
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["ns/sample"] = nsPerSample(static_cast<double>(state.iterations()) * frameSize);
+}
+BENCHMARK(BM_CorpusPush)->ArgsProduct({ benchmark::CreateRange(64, 8192, 4), { 64, 512 } });
+
+// args: frame size, corpus frames, weight preset (0 = RMS only, 1 = all), rand (percent)
+static void BM_Match(benchmark::State& state)
+{
+    const int frameSize = static_cast<int>(state.range(0));
+    const int frames    = static_cast<int>(state.range(1));
+    juce::Random rng(3);
+
+    CorpusStore corpus;
+    corpus.prepare(frameSize, frames);
+    fillCorpus(corpus, frameSize, frames, rng);
+
+    ConcatenativeMatcher matcher;
+    matcher.prepare(frameSize, frames);
+    applyWeights(matcher, static_cast<int>(state.range(2)));
+    matcher.setRand(static_cast<float>(state.range(3)) / 100.f);
+
+    std::vector<Features> controls(64);
+    for (auto& c : controls) c = randomFeatures(rng);
+
+    uint64_t cycles = 0;
+    size_t   next   = 0;
+    for (auto _ : state) {
+        const float* outL = nullptr, *outR = nullptr;
+        const uint64_t t0 = CycleClock::now();
+        benchmark::DoNotOptimize(matcher.match(controls[next++ % controls.size()], corpus, outL, outR));
+        cycles += CycleClock::now() - t0;
+        benchmark::DoNotOptimize(outL);
+    }
+
+    state.counters["cycles/match"] = benchmark::Counter(static_cast<double>(cycles),
+                                                        benchmark::Counter::kAvgIterations);
+    state.counters["ns/sample"] = nsPerSample(static_cast<double>(state.iterations()) * frameSize);
+}
+BENCHMARK(BM_Match)->ArgsProduct({ { 256, 2048, 8192 }, { 16, 128, 1024 }, { 0, 1 }, { 0, 50 } });
@@ -0,0 +1,125 @@
+// Grain and output effects, and the whole processBlock, across host block sizes.
+#include "BenchUtil.h"
+#include "EQProcessor.h"
+#include "ReverbProcessor.h"
+#include "BitCrushProcessor.h"
+#include "PitchShiftProcessor.h"
+#include "TruePeakLimiter.h"
+#include "PluginProcessor.h"
+#include <memory>
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// Runs processor.process() on a stereo noise block of state.range(0) samples
+template <typename Processor>
+void runEffect(benchmark::State& state, Processor& processor)
+{
+    const int blockSize = static_cast<int>(state.range(0));
+    juce::AudioBuffer<float> noise(2, blockSize), buffer(2, blockSize);
+    juce::Random rng(4);
+    fillNoise(noise, rng);
+
+    for (auto _ : state) {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        processor.process(block);
+        benchmark::DoNotOptimize(buffer.getReadPointer(0));
+    }
+    state.counters["ns/sample"] = nsPerSample(static_cast<double>(state.iterations()) * blockSize);
+}
+
+juce::dsp::ProcessSpec specFor(const benchmark::State& state)
+{
+    return { kSampleRate, static_cast<juce::uint32>(state.range(0)), 2 };
+}
+
+void blockSizes(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(2)->Range(64, 1024);
+}
+
+} // namespace
+
+static void BM_EQ(benchmark::State& state)
+{
+    EQProcessor eq;
+    eq.prepare(specFor(state));
+    eq.setGains(3.f, -2.f, 4.f);
+    runEffect(state, eq);
+}
+
+static void BM_Reverb(benchmark::State& state)
+{
+    ReverbProcessor reverb;
+    reverb.prepare(specFor(state));
+    reverb.setSpace(0.7f, 0.4f);
+    runEffect(state, reverb);
+}
+
+// extra arg: 0 = plain quantiser, 1 = ADAA, 2 = ADAA + rate reduction
+static void BM_BitCrush(benchmark::State& state)
+{
+    BitCrushProcessor crush;
+    crush.prepare(specFor(state));
+    crush.setBits(6.f);
+    crush.setAntialiasing(state.range(1) >= 1);
+    crush.setRate(state.range(1) >= 2 ? 0.5f : 0.f);
+    runEffect(state, crush);
+}
+
+static void BM_PitchShift(benchmark::State& state)
+{
+    PitchShiftProcessor pitch;
+    pitch.prepare(specFor(state));
+    pitch.setSemitones(7.f);
+    runEffect(state, pitch);
+}
+
+static void BM_TruePeakLimiter(benchmark::State& state)
+{
+    TruePeakLimiter limiter;
+    limiter.prepare(specFor(state));
+    runEffect(state, limiter);
+}
+
+BENCHMARK(BM_EQ)->Apply(blockSizes);
+BENCHMARK(BM_Reverb)->Apply(blockSizes);
+BENCHMARK(BM_BitCrush)->ArgsProduct({ benchmark::CreateRange(64, 1024, 2), { 0, 1, 2 } });
+BENCHMARK(BM_PitchShift)->Apply(blockSizes);
+BENCHMARK(BM_TruePeakLimiter)->Apply(blockSizes);
+
+// args: block size, match length (ms), rand (percent)
+static void BM_ProcessBlock(benchmark::State& state)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    const int blockSize = static_cast<int>(state.range(0));
+
+    auto proc = std::make_unique<StitcherProcessor>();
+    auto setParam = [&](const char* id, float plainValue) {
+        auto* p = proc->getAPVTS().getParameter(id);
+        p->setValueNotifyingHost(p->convertTo0to1(plainValue));
+    };
+    setParam(ParamIDs::matchLen, static_cast<float>(state.range(1)));
+    setParam(ParamIDs::rand_, static_cast<float>(state.range(2)) / 100.f);
+    proc->setPlayConfigDetails(4, 2, kSampleRate, blockSize);
+    proc->prepareToPlay(kSampleRate, blockSize);
+
+    juce::AudioBuffer<float> noise(4, blockSize), buffer(4, blockSize);
+    juce::MidiBuffer midi;
+    juce::Random rng(5);
+    fillNoise(noise, rng);
+    for (int i = 0; i < static_cast<int>(5.0 * kSampleRate) / blockSize; ++i) {   // fill the corpus
+        buffer.makeCopyOf(noise, true);
+        proc->processBlock(buffer, midi);
+    }
+
+    for (auto _ : state) {
+        buffer.makeCopyOf(noise, true);
+        proc->processBlock(buffer, midi);
+        benchmark::DoNotOptimize(buffer.getReadPointer(0));
+    }
+    state.counters["ns/sample"] = nsPerSample(static_cast<double>(state.iterations()) * blockSize);
+}
+BENCHMARK(BM_ProcessBlock)->ArgsProduct({ { 64, 128, 256, 512 }, { 10, 50, 100 }, { 0, 50 } });
@@ -0,0 +1,133 @@
+// Message-thread session work: restoring instance state on project load and stepping
+// through a large preset library.
+#include "BenchUtil.h"
+#include "PluginProcessor.h"
+#include "PresetManager.h"
+#include "PresetCatalogue.h"
+#include "FactoryPresets.h"
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kInstances   = 256;
+constexpr int kUserPresets = 500;
+
+// A processor with a few non-default parameters and one MIDI binding
+void customise(StitcherProcessor& proc)
+{
+    auto& apvts = proc.getAPVTS();
+    apvts.getParameter(ParamIDs::rmsWeight)->setValueNotifyingHost(0.25f);
+    apvts.getParameter(ParamIDs::rand_)->setValueNotifyingHost(0.75f);
+
+    auto& ml = proc.getMidiLearn();
+    ml.startLearning(apvts.getParameter(ParamIDs::rmsWeight));
+    ml.handleCC(21, 0);
+    ml.processCapture();
+}
+
+// arg 0: the binary session format; arg 1: the legacy copyXmlToBinary one
+juce::MemoryBlock sessionState(StitcherProcessor& proc, bool legacy)
+{
+    juce::MemoryBlock mb;
+    if (!legacy) {
+        proc.getStateInformation(mb);
+        return mb;
+    }
+    auto xml = proc.getAPVTS().copyState().createXml();
+    xml->addChildElement(proc.getMidiLearn().createBindingsXml());
+    juce::AudioProcessor::copyXmlToBinary(*xml, mb);
+    return mb;
+}
+
+std::vector<std::unique_ptr<StitcherProcessor>> makeInstances()
+{
+    std::vector<std::unique_ptr<StitcherProcessor>> procs;
+    for (int n = 0; n < kInstances; ++n)
+        procs.push_back(std::make_unique<StitcherProcessor>());
+    return procs;
+}
+
+struct PresetLibrary {
+    juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getChildFile("StitcherBenchPresets");
+
+    PresetLibrary()
+    {
+        dir.deleteRecursively();
+        dir.createDirectory();
+        for (int i = 0; i < kUserPresets; ++i) {
+            const auto rms = juce::String(static_cast<float>(i) / kUserPresets);
+            dir.getChildFile("User " + juce::String(i).paddedLeft('0', 3) + ".xml")
+               .replaceWithText("<PARAMETERS><PARAM id=\"rms_weight\" value=\"" + rms + "\"/></PARAMETERS>");
+        }
+    }
+    ~PresetLibrary() { dir.deleteRecursively(); }
+};
+
+} // namespace
+
+// Project load: every instance in a session restores its state one after another
+static void BM_RestoreSession(benchmark::State& state)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    StitcherProcessor src;
+    customise(src);
+    const auto session = sessionState(src, state.range(0) == 1);
+    auto procs = makeInstances();
+
+    for (auto _ : state)
+        for (auto& p : procs)
+            p->setStateInformation(session.getData(), static_cast<int>(session.getSize()));
+    state.counters["instances"] = kInstances;
+}
+BENCHMARK(BM_RestoreSession)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveSession(benchmark::State& state)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    auto procs = makeInstances();
+    for (auto& p : procs)
+        customise(*p);
+
+    juce::MemoryBlock mb;
+    for (auto _ : state) {
+        for (auto& p : procs)
+            p->getStateInformation(mb);
+        benchmark::DoNotOptimize(mb.getData());
+    }
+    state.counters["instances"] = kInstances;
+}
+BENCHMARK(BM_SaveSession)->Unit(benchmark::kMillisecond);
+
+// The preset bar's scroll wheel through a large user library; neighbours are prefetched
+static void BM_PresetSelectNext(benchmark::State& state)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    PresetLibrary library;
+    StitcherProcessor proc;
+    PresetManager pm(proc.getAPVTS(), library.dir, getFactoryPresets());
+    pm.getCatalogue().waitUntilIdle(10000);
+    pm.loadPreset("User 000");
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        pm.getCatalogue().waitUntilIdle(5000);
+        state.ResumeTiming();
+        pm.selectNext();
+    }
+}
+BENCHMARK(BM_PresetSelectNext);
+
+static void BM_PresetNames(benchmark::State& state)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    PresetLibrary library;
+    StitcherProcessor proc;
+    PresetManager pm(proc.getAPVTS(), library.dir, getFactoryPresets());
+    pm.getCatalogue().waitUntilIdle(10000);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pm.getPresetNames().size());
+}
+BENCHMARK(BM_PresetNames);
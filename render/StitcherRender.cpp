@@ -0,0 +1,142 @@
+// StitcherRender — headless offline renderer.
+//
+//   StitcherRender --main=in.wav [--sidechain=ctrl.wav] --out=out.wav [options]
+//   StitcherRender --batch=jobs.txt [options]
+//
+// Options:
+//   --preset=NAME|FILE.xml   factory/user preset name or preset file (default: parameter defaults)
+//   --threads=N              parallel jobs, one processor each (default: one per CPU core)
+//   --block=N                processBlock size in samples (default 512)
+//   --tail=SECONDS           rendered past the end of the inputs (default 2)
+//   --bits=16|24|32          output WAV bit depth, 32 = float (default 24)
+//   --seed=N                 seed the matcher so repeated renders are bit-identical
+//   --no-latency-comp        keep the plugin latency at the head of the output
+//
+// A batch file holds one job per line: main, sidechain ("-" for none), output and an
+// optional preset overriding --preset. Quote paths containing spaces; '#' starts a comment.
+#include "OfflineRenderer.h"
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <iostream>
+#include <mutex>
+
+namespace {
+void printUsage()
+{
+    std::cerr << "usage: StitcherRender --main=in.wav [--sidechain=ctrl.wav] --out=out.wav [options]\n"
+                 "       StitcherRender --batch=jobs.txt [options]\n"
+                 "options: --preset=NAME|FILE.xml  --threads=N  --block=N  --tail=SECONDS\n"
+                 "         --bits=16|24|32  --seed=N  --no-latency-comp\n";
+}
+
+juce::File fileArg(const juce::String& path)
+{
+    return juce::File::getCurrentWorkingDirectory().getChildFile(path.unquoted());
+}
+
+bool parseBatch(const juce::File& list, const juce::String& defaultPreset,
+                std::vector<RenderJob>& jobs, juce::String& error)
+{
+    juce::StringArray lines;
+    list.readLines(lines);
+    for (int i = 0; i < lines.size(); ++i) {
+        const auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty()) continue;
+
+        juce::StringArray tokens;
+        tokens.addTokens(line, " \t", "\"");
+        tokens.removeEmptyStrings();
+        if (tokens.size() < 3 || tokens.size() > 4) {
+            error = list.getFileName() + ":" + juce::String(i + 1)
+                    + ": expected <main> <sidechain|-> <output> [preset]";
+            return false;
+        }
+
+        RenderJob job;
+        job.mainInput = fileArg(tokens[0]);
+        if (tokens[1] != "-")
+            job.sidechainInput = fileArg(tokens[1]);
+        job.output = fileArg(tokens[2]);
+        job.preset = tokens.size() == 4 ? tokens[3].unquoted() : defaultPreset;
+        jobs.push_back(job);
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // no window or display is ever opened
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h")) {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    const auto preset = args.getValueForOption("--preset");
+
+    RenderOptions options;
+    if (args.containsOption("--block"))
+        options.blockSize = args.getValueForOption("--block").getIntValue();
+    if (args.containsOption("--tail"))
+        options.tailSeconds = juce::jmax(0.0, args.getValueForOption("--tail").getDoubleValue());
+    if (args.containsOption("--bits"))
+        options.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+    if (args.containsOption("--seed"))
+        options.seed = args.getValueForOption("--seed").getLargeIntValue();
+    options.compensateLatency = !args.containsOption("--no-latency-comp");
+
+    std::vector<RenderJob> jobs;
+    if (args.containsOption("--batch")) {
+        const auto list = fileArg(args.getValueForOption("--batch"));
+        juce::String error;
+        if (!list.existsAsFile()) {
+            std::cerr << "cannot open batch file " << list.getFullPathName() << "\n";
+            return 1;
+        }
+        if (!parseBatch(list, preset, jobs, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+    } else {
+        if (!args.containsOption("--main") || !args.containsOption("--out")) {
+            printUsage();
+            return 1;
+        }
+        RenderJob job;
+        job.mainInput = fileArg(args.getValueForOption("--main"));
+        if (args.containsOption("--sidechain"))
+            job.sidechainInput = fileArg(args.getValueForOption("--sidechain"));
+        job.output = fileArg(args.getValueForOption("--out"));
+        job.preset = preset;
+        jobs.push_back(job);
+    }
+
+    const int threads = args.containsOption("--threads")
+                            ? args.getValueForOption("--threads").getIntValue() : 0;
+
+    std::mutex printLock;
+    const auto start = juce::Time::getHighResolutionTicks();
+    const auto results = OfflineRenderer::renderAll(jobs, options, threads,
+        [&](int i, const RenderResult& r) {
+            const std::lock_guard<std::mutex> lock(printLock);
+            const auto& out = jobs[static_cast<size_t>(i)].output.getFullPathName();
+            if (r.result.wasOk())
+                std::cout << "ok    " << out << "  (" << juce::String(r.audioSeconds, 1) << " s audio, "
+                          << juce::String(r.audioSeconds / juce::jmax(r.wallSeconds, 1e-9), 1)
+                          << "x real time)\n";
+            else
+                std::cerr << "FAIL  " << out << ": " << r.result.getErrorMessage() << "\n";
+        });
+    const double wall = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    int failed = 0;
+    double audio = 0.0;
+    for (const auto& r : results) {
+        if (r.result.failed()) ++failed;
+        audio += r.audioSeconds;
+    }
+    std::cout << jobs.size() - static_cast<size_t>(failed) << "/" << jobs.size() << " rendered, "
+              << juce::String(audio, 1) << " s of audio in " << juce::String(wall, 2) << " s\n";
+    return failed == 0 ? 0 : 1;
+}
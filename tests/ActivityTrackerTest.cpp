@@ -0,0 +1,109 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <JuceHeader.h>
+#include "ActivityTracker.h"
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include <memory>
+#include <vector>
+
+TEST_CASE("ActivityTracker: runs through the tail, then goes idle", "[ActivityTracker]")
+{
+    ActivityTracker t;
+    t.setTail(1000);
+    t.reset();
+    REQUIRE(t.isIdle());
+    REQUIRE_FALSE(t.run(true, 512));      // idle and still silent: skip
+
+    REQUIRE(t.run(false, 512));           // signal wakes it
+    REQUIRE_FALSE(t.isIdle());
+    REQUIRE(t.run(true, 512));            // ringing out: 512 of 1000
+    REQUIRE(t.run(true, 512));            // 1024 ≥ 1000 after this block
+    REQUIRE(t.isIdle());
+    REQUIRE_FALSE(t.run(true, 512));
+
+    REQUIRE(t.run(false, 64));            // any non-silent block restarts the tail
+    REQUIRE(t.run(true, 64));
+}
+
+TEST_CASE("ActivityTracker: silence threshold", "[ActivityTracker]")
+{
+    juce::AudioBuffer<float> b(2, 64);
+    b.clear();
+    REQUIRE(ActivityTracker::isSilent(b, 64));
+    b.setSample(1, 63, 1.0e-8f);
+    REQUIRE(ActivityTracker::isSilent(b, 64));
+    b.setSample(1, 63, 1.0e-4f);
+    REQUIRE_FALSE(ActivityTracker::isSilent(b, 64));
+    REQUIRE(ActivityTracker::isSilent(b, 63));   // only the first numSamples count
+}
+
+TEST_CASE("StitcherProcessor: goes idle on silence and wakes on input", "[ActivityTracker]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    preparePlugin(proc);
+
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    juce::Random rng(9);
+
+    auto runNoise = [&](int blocks) {
+        for (int b = 0; b < blocks; ++b) {
+            for (int c = 0; c < 4; ++c)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(c, i, rng.nextFloat() - 0.5f);
+            proc.processBlock(buffer, midi);
+        }
+    };
+
+    runNoise(100);
+    REQUIRE_FALSE(proc.isIdle());
+
+    // Silent main and sidechain: grains go silent once a silent frame is in the corpus,
+    // then the effect tails ring out.
+    bool idle = false;
+    for (int b = 0; b < 400 && !idle; ++b) {
+        buffer.clear();
+        proc.processBlock(buffer, midi);
+        idle = proc.isIdle();
+    }
+    REQUIRE(idle);
+
+    buffer.clear();
+    proc.processBlock(buffer, midi);
+    REQUIRE(buffer.getMagnitude(0, 0, 512) == 0.f);
+    REQUIRE(buffer.getMagnitude(1, 0, 512) == 0.f);
+
+    // Mix is 100 % wet, so output returns with the first grain matched from the new input
+    runNoise(8);
+    REQUIRE_FALSE(proc.isIdle());
+    REQUIRE(buffer.getMagnitude(0, 0, 512) > 0.f);
+}
+
+TEST_CASE("40 dormant instances", "[.benchmark]")
+{
+    JuceInit init;
+    constexpr int kInstances = 40;
+    std::vector<std::unique_ptr<StitcherProcessor>> procs;
+    for (int n = 0; n < kInstances; ++n) {
+        procs.push_back(std::make_unique<StitcherProcessor>());
+        preparePlugin(*procs.back());
+    }
+
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    for (int b = 0; b < 200; ++b)   // let every stage go idle
+        for (auto& p : procs) {
+            buffer.clear();
+            p->processBlock(buffer, midi);
+        }
+
+    BENCHMARK("processBlock x40, silent 512") {
+        for (auto& p : procs) {
+            buffer.clear();
+            p->processBlock(buffer, midi);
+        }
+        return buffer.getSample(0, 0);
+    };
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "BitCrushProcessor.h"
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+// Fraction of the spectrum's energy that is not within a few bins of a harmonic of f0
+// (i.e. folded-back aliases), Hann-windowed plain DFT.
+double aliasRatio(const juce::AudioBuffer<float>& buffer, double f0, double sampleRate)
+{
+    const int n = buffer.getNumSamples();
+    const double binHz = sampleRate / n;
+    double alias = 0.0, total = 0.0;
+    for (int k = 1; k < n / 2; ++k) {
+        std::complex<double> s;
+        for (int i = 0; i < n; ++i) {
+            const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / n);
+            s += std::polar(buffer.getSample(0, i) * w, -juce::MathConstants<double>::twoPi * k * i / n);
+        }
+        const double e = std::norm(s);
+        const double h = k * binHz / f0;
+        total += e;
+        if (std::abs(h - std::round(h)) * f0 / binHz >= 3.0)
+            alias += e;
+    }
+    return alias / total;
+}
+
+void fillSine(juce::AudioBuffer<float>& buffer, double freq, double sampleRate, float amp)
+{
+    for (int c = 0; c < buffer.getNumChannels(); ++c)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(c, i, amp * static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * freq * i / sampleRate)));
+}
+
+} // namespace
+
+TEST_CASE("BitCrush: quantiser matches scalar rounding at any alignment") {
+    std::vector<float> data(1031), ref(1031);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = ref[i] = 0.93f * std::sin(0.0137f * static_cast<float>(i));
+
+    constexpr float kLevels = 15.f;   // 4 bits
+    BitCrushProcessor::quantise(data.data() + 3, 1024, kLevels);   // unaligned start, odd head
+    for (size_t i = 3; i < 1027; ++i)
+        REQUIRE(data[i] == Catch::Approx(std::round(ref[i] * kLevels) / kLevels).margin(1e-6));
+    REQUIRE(data[0] == ref[0]);       // untouched outside the range
+    REQUIRE(data[1030] == ref[1030]);
+}
+
+TEST_CASE("BitCrush: 16 bits with no rate reduction is a bypass") {
+    BitCrushProcessor crush;
+    crush.prepare({ 44100.0, 512, 2 });
+    crush.setBits(16.f);
+
+    juce::AudioBuffer<float> buffer(2, 512), ref(2, 512);
+    fillSine(buffer, 440.0, 44100.0, 0.7f);
+    ref.makeCopyOf(buffer);
+    juce::dsp::AudioBlock<float> block(buffer);
+    crush.process(block);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 512; ++i)
+            REQUIRE(buffer.getSample(c, i) == ref.getSample(c, i));
+}
+
+TEST_CASE("BitCrush: bit-depth changes glide instead of stepping") {
+    BitCrushProcessor crush;
+    crush.prepare({ 44100.0, 512, 1 });
+    crush.setBits(16.f);
+
+    juce::AudioBuffer<float> buffer(1, 512);
+    auto run = [&] {
+        for (int i = 0; i < 512; ++i) buffer.setSample(0, i, 0.3f);
+        juce::dsp::AudioBlock<float> block(buffer);
+        crush.process(block);
+    };
+    run();
+    crush.setBits(2.f);   // 3 levels: 0.3 → 1/3
+    run();
+    REQUIRE(buffer.getSample(0, 0) == Catch::Approx(0.3f).margin(1e-3));   // starts from 16 bits
+    REQUIRE(buffer.getSample(0, 511) != Catch::Approx(1.f / 3.f));        // still ramping (20 ms)
+    run();
+    REQUIRE(buffer.getSample(0, 511) == Catch::Approx(1.f / 3.f));
+}
+
+TEST_CASE("BitCrush: fractional bit depths settle on the whole-bit staircase") {
+    BitCrushProcessor crush;
+    crush.prepare({ 44100.0, 512, 1 });
+    crush.setBits(2.7f);   // floor → 2 bits, 3 levels
+
+    juce::AudioBuffer<float> buffer(1, 512);
+    for (int i = 0; i < 512; ++i) buffer.setSample(0, i, 0.3f);
+    juce::dsp::AudioBlock<float> block(buffer);
+    crush.process(block);
+    REQUIRE(buffer.getSample(0, 511) == Catch::Approx(1.f / 3.f));
+}
+
+TEST_CASE("BitCrush: rate reduction holds samples at the requested rate") {
+    constexpr double kSampleRate = 96000.0;   // the hold rate is in Hz, not in samples
+    BitCrushProcessor crush;
+    crush.prepare({ kSampleRate, 4800, 1 });
+    crush.setBits(16.f);
+    crush.setRate(1.f);   // kMinHoldHz
+
+    juce::AudioBuffer<float> buffer(1, 4800);   // 50 ms
+    for (int i = 0; i < 4800; ++i) buffer.setSample(0, i, static_cast<float>(i));
+    juce::dsp::AudioBlock<float> block(buffer);
+    crush.process(block);
+
+    int changes = 0;
+    for (int i = 1; i < 4800; ++i)
+        changes += buffer.getSample(0, i) != buffer.getSample(0, i - 1) ? 1 : 0;
+    REQUIRE(changes == Catch::Approx(0.05 * BitCrushProcessor::kMinHoldHz).margin(1.0));
+}
+
+TEST_CASE("BitCrush: ADAA lowers aliasing of a crushed sine") {
+    constexpr double kSampleRate = 44100.0, kFreq = 4410.7;
+    double ratio[2] {};
+    for (int adaa = 0; adaa < 2; ++adaa) {
+        BitCrushProcessor crush;
+        crush.prepare({ kSampleRate, 2048, 1 });
+        crush.setBits(4.f);
+        crush.setAntialiasing(adaa == 1);
+
+        juce::AudioBuffer<float> buffer(1, 2048);
+        fillSine(buffer, kFreq, kSampleRate, 0.8f);
+        juce::dsp::AudioBlock<float> block(buffer);
+        crush.process(block);
+        ratio[adaa] = aliasRatio(buffer, kFreq, kSampleRate);
+    }
+    REQUIRE(ratio[1] < ratio[0] * 0.25);
+}
+
+TEST_CASE("BitCrush benchmark: SIMD quantiser vs per-sample std::round", "[.benchmark]") {
+    constexpr int kBlock = 512;
+    juce::AudioBuffer<float> noise(2, kBlock), buffer(2, kBlock);
+    juce::Random rng(3);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < kBlock; ++i)
+            noise.setSample(c, i, rng.nextFloat() * 2.f - 1.f);
+
+    BitCrushProcessor crush;
+    crush.prepare({ 44100.0, kBlock, 2 });
+    crush.setBits(8.f);
+
+    BENCHMARK("std::round loop, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        const float levels = std::pow(2.f, 8.f) - 1.f, inv = 1.f / levels;
+        for (int c = 0; c < 2; ++c) {
+            float* d = buffer.getWritePointer(c);
+            for (int i = 0; i < kBlock; ++i)
+                d[i] = std::round(d[i] * levels) * inv;
+        }
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    BENCHMARK("BitCrushProcessor, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        crush.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    crush.setAntialiasing(true);
+    BENCHMARK("BitCrushProcessor with ADAA, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        crush.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+}
@@ -213,3 +213,56 @@ TEST_CASE("getLastMatchedIndex returns correct index after match") {
     matcher.match(ctrl_quiet, corpus, outL, outR);
     REQUIRE(matcher.getLastMatchedIndex() == 0);
 }
+
+TEST_CASE("match reports distance and candidate count of the chosen frame") {
+    ConcatenativeMatcher matcher;
+    matcher.prepare(4);
+    matcher.setWeights(0.f, 1.f, 0.f, 0.f);  // RMS only
+
+    CorpusStore corpus;
+    corpus.prepare(4, 10);
+    float audio[4] = {0.1f, 0.1f, 0.1f, 0.1f};
+    corpus.push(audio, audio, Features{0.f, 0.2f, 0.f, 0.f});
+    corpus.push(audio, audio, Features{0.f, 0.4f, 0.f, 0.f});
+    corpus.push(audio, audio, Features{0.f, 0.9f, 0.f, 0.f});
+
+    const float* outL = nullptr, *outR = nullptr;
+    Features ctrl{0.f, 0.3f, 0.f, 0.f};
+
+    matcher.setRand(0.f);
+    matcher.match(ctrl, corpus, outL, outR);
+    REQUIRE(matcher.getLastDistance() == Catch::Approx(0.1f));
+    REQUIRE(matcher.getLastCandidateCount() == 1);
+
+    // Threshold (1 + 1) * 0.1 admits both 0.2 and 0.4 but not 0.9
+    matcher.setRand(1.f);
+    matcher.match(ctrl, corpus, outL, outR);
+    REQUIRE(matcher.getLastCandidateCount() == 2);
+    REQUIRE(matcher.getLastDistance() == Catch::Approx(0.1f));
+}
+
+TEST_CASE("setSeed makes the random pick among near-matches reproducible") {
+    CorpusStore corpus;
+    corpus.prepare(4, 16);
+    float audio[4] = {0.1f, 0.1f, 0.1f, 0.1f};
+    for (int i = 0; i < 16; ++i)
+        corpus.push(audio, audio, Features{0.f, 0.5f + 0.001f * static_cast<float>(i), 0.f, 0.f});
+
+    auto pickSequence = [&](juce::int64 seed) {
+        ConcatenativeMatcher matcher;
+        matcher.prepare(4, 16);
+        matcher.setWeights(0.f, 1.f, 0.f, 0.f);
+        matcher.setRand(1.f);
+        matcher.setSeed(seed);
+        std::vector<int> picks;
+        const float* outL = nullptr, *outR = nullptr;
+        for (int i = 0; i < 64; ++i) {
+            matcher.match(Features{0.f, 0.49f, 0.f, 0.f}, corpus, outL, outR);   // ~11 candidates
+            picks.push_back(matcher.getLastMatchedIndex());
+        }
+        return picks;
+    };
+
+    REQUIRE(pickSequence(1234) == pickSequence(1234));
+    REQUIRE(pickSequence(1234) != pickSequence(4321));
+}
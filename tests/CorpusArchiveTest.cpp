@@ -0,0 +1,184 @@
+#include "catch2/catch_test_macros.hpp"
+#include <JuceHeader.h>
+#include "CorpusArchive.h"
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+CorpusImage makeImage(int frameSize, int numFrames)
+{
+    CorpusImage image;
+    image.frameSize = frameSize;
+    juce::Random rng(3);
+    for (int i = 0; i < numFrames * frameSize; ++i) {
+        image.audioL.push_back(std::sin(0.01f * static_cast<float>(i)) * 0.5f + rng.nextFloat() * 1.0e-3f);
+        image.audioR.push_back(rng.nextFloat() * 2.f - 1.f);
+    }
+    for (int i = 0; i < numFrames; ++i)
+        image.features.push_back({ rng.nextFloat(), rng.nextFloat(), rng.nextFloat(), rng.nextFloat() });
+    return image;
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+void runBlocks(StitcherProcessor& proc, int numBlocks, float level)
+{
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    juce::Random rng(11);
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int c = 0; c < 4; ++c)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample(c, i, (rng.nextFloat() * 2.f - 1.f) * level);
+        proc.processBlock(buffer, midi);
+    }
+}
+
+void setFreeze(StitcherProcessor& proc, bool on)
+{
+    proc.getAPVTS().getParameter(ParamIDs::freeze)->setValueNotifyingHost(on ? 1.f : 0.f);
+}
+
+juce::MemoryBlock saveState(StitcherProcessor& proc)
+{
+    juce::MemoryBlock mb;
+    proc.getStateInformation(mb);
+    return mb;
+}
+
+} // namespace
+
+TEST_CASE("CorpusArchive: encode/decode is bit-exact", "[CorpusArchive]")
+{
+    const auto image = makeImage(256, 40);
+    const auto chunk = CorpusArchive::encode(image);
+    REQUIRE(chunk.getSize() < static_cast<size_t>(image.size()) * 256 * 2 * sizeof(float));
+
+    const auto decoded = CorpusArchive::decode(chunk.getData(), chunk.getSize());
+    REQUIRE(decoded != nullptr);
+    REQUIRE(decoded->frameSize == 256);
+    REQUIRE(decoded->size() == 40);
+    REQUIRE(sameBits(decoded->audioL, image.audioL));
+    REQUIRE(sameBits(decoded->audioR, image.audioR));
+    for (int i = 0; i < 40; ++i) {
+        const auto& a = decoded->features[static_cast<size_t>(i)];
+        const auto& b = image.features[static_cast<size_t>(i)];
+        REQUIRE(std::memcmp(&a, &b, sizeof(Features)) == 0);
+    }
+}
+
+TEST_CASE("CorpusArchive: damaged chunks are rejected", "[CorpusArchive]")
+{
+    const auto chunk = CorpusArchive::encode(makeImage(64, 8));
+    REQUIRE(CorpusArchive::decode(chunk.getData(), chunk.getSize() / 2) == nullptr);   // truncated
+
+    auto badMagic = chunk;
+    static_cast<char*>(badMagic.getData())[0] = 'X';
+    REQUIRE(CorpusArchive::decode(badMagic.getData(), badMagic.getSize()) == nullptr);
+
+    auto newer = chunk;
+    const auto version = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(CorpusArchive::kVersion + 1));
+    newer.copyFrom(&version, 4, 4);
+    REQUIRE(CorpusArchive::decode(newer.getData(), newer.getSize()) == nullptr);
+}
+
+TEST_CASE("CorpusArchive: a save never waits for a fresh encode", "[CorpusArchive]")
+{
+    std::atomic<int>  numFrames { 8 };
+    std::atomic<bool> waitedOnCaller { false };
+    const auto caller = std::this_thread::get_id();
+    CorpusArchive archive(
+        [&](CorpusImage& out, uint64_t& key, bool mayWait) {
+            if (mayWait && std::this_thread::get_id() == caller)
+                waitedOnCaller = true;
+            out = makeImage(64, numFrames.load());
+            key = static_cast<uint64_t>(numFrames.load());
+            return true;
+        },
+        [](std::unique_ptr<CorpusImage>) {});
+
+    auto framesIn = [](const juce::MemoryBlock& chunk) {
+        const auto image = CorpusArchive::decode(chunk.getData(), chunk.getSize());
+        return image != nullptr ? image->size() : -1;
+    };
+
+    REQUIRE(framesIn(archive.getEncoded(8)) == 8);   // nothing cached: encoded in place
+
+    numFrames = 12;
+    REQUIRE(framesIn(archive.getEncoded(12)) == 8);  // stale chunk now, fresh one queued
+    REQUIRE(archive.waitUntilIdle(5000));
+    REQUIRE(framesIn(archive.getEncoded(12)) == 12);
+    REQUIRE_FALSE(waitedOnCaller.load());
+}
+
+TEST_CASE("StitcherProcessor: a frozen corpus is saved with the session and streams back in", "[CorpusArchive]")
+{
+    JuceInit init;
+    StitcherProcessor src;
+    preparePlugin(src);
+    runBlocks(src, 200, 0.5f);   // fill the corpus ring
+    setFreeze(src, true);
+    runBlocks(src, 2, 0.5f);     // the audio thread applies Freeze
+
+    const auto paramsOnly = saveState(src);
+    src.setEmbedCorpus(true);
+    REQUIRE(src.waitForCorpusArchive(5000));
+    const auto withCorpus = saveState(src);
+    REQUIRE(withCorpus.getSize() > paramsOnly.getSize() + 1000);
+
+    CorpusSnapshot expected;
+    REQUIRE(src.readCorpusSnapshot(expected));
+    REQUIRE(expected.cursor.count > 0);
+
+    StitcherProcessor dst;
+    preparePlugin(dst);
+    dst.setStateInformation(withCorpus.getData(), static_cast<int>(withCorpus.getSize()));
+    REQUIRE(dst.getEmbedCorpus());
+    REQUIRE(dst.waitForCorpusArchive(5000));
+    runBlocks(dst, expected.cursor.count, 0.f);   // streams a few frames per block
+
+    CorpusSnapshot restored;
+    REQUIRE(dst.readCorpusSnapshot(restored));
+    REQUIRE(restored.cursor.count == expected.cursor.count);
+    for (size_t i = 0; i < expected.features.size(); ++i)
+        REQUIRE(std::memcmp(&restored.features[i], &expected.features[i], sizeof(Features)) == 0);
+
+    // Saving again keeps the corpus, even though it was never re-captured
+    REQUIRE(saveState(dst).getSize() > paramsOnly.getSize() + 1000);
+}
+
+TEST_CASE("StitcherProcessor: the corpus is only embedded while frozen and opted in", "[CorpusArchive]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    preparePlugin(proc);
+    runBlocks(proc, 200, 0.5f);
+
+    const auto baseline = saveState(proc).getSize();
+
+    proc.setEmbedCorpus(true);   // not frozen: nothing to embed
+    REQUIRE(saveState(proc).getSize() < baseline + 100);
+
+    setFreeze(proc, true);
+    runBlocks(proc, 2, 0.5f);
+    REQUIRE(saveState(proc).getSize() > baseline + 1000);
+
+    // Loading a preset replaces the parameter tree but not the opt-in
+    StitcherProcessor other;
+    proc.getAPVTS().replaceState(other.getAPVTS().copyState());
+    setFreeze(proc, true);
+    runBlocks(proc, 2, 0.5f);
+    REQUIRE(proc.getEmbedCorpus());
+    REQUIRE(saveState(proc).getSize() > baseline + 1000);
+
+    proc.setEmbedCorpus(false);
+    REQUIRE(saveState(proc).getSize() < baseline + 100);
+}
@@ -0,0 +1,42 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include <cmath>
+#include <vector>
+#include "../Source/UI/CorpusScatter.h"
+
+TEST_CASE("CorpusScatter: PCA projection is deterministic on a known corpus", "[CorpusScatter]")
+{
+    // ZCR, RMS and centroid all follow latent a (on very different scales); tilt follows
+    // an independent b. The first component must therefore be a and the second b.
+    std::vector<Features> corpus;
+    for (int a = 0; a < 5; ++a)
+        for (int b = 0; b < 5; ++b)
+            corpus.push_back({ 0.1f * a, 0.01f + 0.02f * a, 0.2f + 0.15f * a, 0.3f * b });
+
+    const auto basis = CorpusScatter::computeBasis(corpus, CorpusScatter::Projection::Pca);
+    const auto again = CorpusScatter::computeBasis(corpus, CorpusScatter::Projection::Pca);
+    std::vector<Features> reversed(corpus.rbegin(), corpus.rend());
+    const auto shuffled = CorpusScatter::computeBasis(reversed, CorpusScatter::Projection::Pca);
+
+    for (const auto& f : corpus) {
+        const auto p = basis.project(f);
+        REQUIRE(p == again.project(f));
+        REQUIRE(p.x == Catch::Approx(shuffled.project(f).x).margin(1e-4));
+        REQUIRE(p.y == Catch::Approx(shuffled.project(f).y).margin(1e-4));
+    }
+
+    auto at = [&](int a, int b) { return basis.project(corpus[static_cast<size_t>(a * 5 + b)]); };
+    for (int a = 0; a < 5; ++a) {
+        for (int b = 0; b < 5; ++b) {
+            REQUIRE(at(a, b).x == Catch::Approx(at(a, 0).x).margin(1e-4));   // x ignores b
+            REQUIRE(at(a, b).y == Catch::Approx(at(0, b).y).margin(1e-4));   // y ignores a
+            if (a > 0) REQUIRE(at(a, b).x > at(a - 1, b).x);
+            if (b > 0) REQUIRE(std::abs(at(a, b).y - at(a, b - 1).y) > 0.1f);
+        }
+    }
+    // The view is fitted to the data with 5 % padding on each side
+    REQUIRE(at(0, 0).x == Catch::Approx(0.05f / 1.1f).margin(1e-3));
+    REQUIRE(at(4, 0).x == Catch::Approx(1.05f / 1.1f).margin(1e-3));
+    REQUIRE(at(0, 0).y == Catch::Approx(1.05f / 1.1f).margin(1e-3));
+    REQUIRE(at(0, 4).y == Catch::Approx(0.05f / 1.1f).margin(1e-3));
+}
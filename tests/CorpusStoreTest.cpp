@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include "CorpusStore.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 
 static Features zeroFeatures() { return {0.f, 0.f, 0.f, 0.f}; }
@@ -69,3 +72,92 @@ TEST_CASE("Stereo corpus stores distinct L and R audio independently") {
     REQUIRE(frame.audioL[0] == Catch::Approx(1.f));
     REQUIRE(frame.audioR[0] == Catch::Approx(2.f));
 }
+
+TEST_CASE("Snapshot is unavailable before prepare") {
+    CorpusStore store;
+    CorpusCursor cursor;
+    REQUIRE_FALSE(store.readCursor(cursor));
+}
+
+TEST_CASE("Snapshot mirrors features in logical order across wrap") {
+    CorpusStore store;
+    store.prepare(4, 3);
+    float audio[4] = {0.f, 0.f, 0.f, 0.f};
+    for (int k = 1; k <= 4; ++k) {
+        Features f{0.f, static_cast<float>(k), 0.f, 0.f};
+        store.push(audio, audio, f);
+    }
+
+    CorpusSnapshot snap;
+    REQUIRE(store.readSnapshot(snap));
+    REQUIRE(snap.cursor.count == 3);
+    REQUIRE(snap.cursor.maxFrames == 3);
+    REQUIRE(snap.cursor.version == 4);
+    REQUIRE(snap.features.size() == 3);
+    // Oldest frame (k=1) was overwritten; logical order is 2, 3, 4
+    REQUIRE(snap.features[0].rms == Catch::Approx(2.f));
+    REQUIRE(snap.features[2].rms == Catch::Approx(4.f));
+    REQUIRE(snap.features[2].rms == store.getFrame(store.newestIndex()).features.rms);
+}
+
+TEST_CASE("Snapshot version does not advance while frozen") {
+    CorpusStore store;
+    store.prepare(4, 5);
+    float audio[4] = {1.f, 1.f, 1.f, 1.f};
+    store.push(audio, audio, zeroFeatures());
+    store.setFrozen(true);
+    store.push(audio, audio, zeroFeatures());
+
+    CorpusCursor cursor;
+    REQUIRE(store.readCursor(cursor));
+    REQUIRE(cursor.version == 1);
+    REQUIRE(cursor.count == 1);
+    REQUIRE(cursor.writeIndex == 1);
+}
+
+TEST_CASE("Concurrent snapshot reads never observe a torn table") {
+    // Writer pushes frames whose features all equal the push counter; a consistent
+    // snapshot is therefore strictly increasing by exactly 1 from oldest to newest.
+    CorpusStore store;
+    store.prepare(4, 64);
+    float audio[4] = {0.f, 0.f, 0.f, 0.f};
+    std::atomic<bool> done { false };
+    std::atomic<int>  reads { 0 };
+
+    // The writer yields after every push, like an audio thread between blocks, and once
+    // past the burst slows to a 1 ms cadence until the reader has landed 100 snapshots,
+    // so the checks below cannot pass just because the writer finished first. The
+    // deadline only bounds a broken reader.
+    std::thread writer([&] {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        for (int k = 1; k <= 20000 || (reads.load() < 100 && std::chrono::steady_clock::now() < deadline); ++k) {
+            const float v = static_cast<float>(k);
+            store.push(audio, audio, Features{v, v, v, v});
+            if (k <= 20000)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    CorpusSnapshot snap;
+    while (!done.load()) {
+        if (!store.readSnapshot(snap)) continue;
+        ++reads;
+        for (size_t i = 0; i < snap.features.size(); ++i) {
+            const auto& f = snap.features[i];
+            if (f.zcr != f.rms || f.rms != f.sc || f.sc != f.st)
+                consistent = false;
+            if (i > 0 && f.rms != snap.features[i - 1].rms + 1.f)
+                consistent = false;
+        }
+        if (!snap.features.empty()
+            && snap.features.back().rms != static_cast<float>(snap.cursor.version))
+            consistent = false;
+    }
+    writer.join();
+    REQUIRE(reads.load() > 0);
+    REQUIRE(consistent);
+}
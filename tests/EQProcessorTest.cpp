@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include "EQProcessor.h"
+#include <algorithm>
+#include <cmath>
 
 TEST_CASE("EQ with 0dB gains passes DC signal at unity (post-transient)") {
     EQProcessor eq;
@@ -103,3 +106,184 @@ TEST_CASE("High-shelf boost raises output of a high-frequency sine") {
     float boosted = measure(6.f);
     REQUIRE(boosted > flat * 1.1f);  // +6 dB high shelf clearly raises 10 kHz content
 }
+
+TEST_CASE("Closed-form designs match JUCE's IIR coefficient factories") {
+    using Coeffs = juce::dsp::IIR::Coefficients<float>;
+    const double sr = 48000.0;
+    for (float db : { -12.f, -3.f, 0.f, 4.5f, 12.f }) {
+        const float gain = juce::Decibels::decibelsToGain(db);
+        const std::pair<BiquadCoeffs, Coeffs::Ptr> pairs[] = {
+            { EQProcessor::makeLowShelf (sr, 200.0,  0.707, db), Coeffs::makeLowShelf (sr, 200.0,  0.707, gain) },
+            { EQProcessor::makePeak     (sr, 1000.0, 0.707, db), Coeffs::makePeakFilter(sr, 1000.0, 0.707, gain) },
+            { EQProcessor::makeHighShelf(sr, 6000.0, 0.707, db), Coeffs::makeHighShelf(sr, 6000.0, 0.707, gain) },
+        };
+        for (const auto& [ours, ref] : pairs) {
+            const float* r = ref->getRawCoefficients();   // b0 b1 b2 a1 a2, normalised
+            REQUIRE(ours.b0 == Catch::Approx(r[0]).margin(1e-5));
+            REQUIRE(ours.b1 == Catch::Approx(r[1]).margin(1e-5));
+            REQUIRE(ours.b2 == Catch::Approx(r[2]).margin(1e-5));
+            REQUIRE(ours.a1 == Catch::Approx(r[3]).margin(1e-5));
+            REQUIRE(ours.a2 == Catch::Approx(r[4]).margin(1e-5));
+        }
+    }
+}
+
+TEST_CASE("Gain changes glide instead of stepping") {
+    EQProcessor eq;
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate       = 44100.0;
+    spec.maximumBlockSize = 64;
+    spec.numChannels      = 1;
+    eq.prepare(spec);
+    eq.setGains(0.f, 0.f, 0.f);
+
+    juce::AudioBuffer<float> buffer(1, 64);
+    float prev = 0.25f, maxStep = 0.f, firstAfterChange = 0.f;
+    for (int b = 0; b < 80; ++b) {
+        if (b == 20) eq.setGains(12.f, 0.f, 0.f);
+        for (int i = 0; i < 64; ++i)
+            buffer.setSample(0, i, 0.25f);
+        juce::dsp::AudioBlock<float> block(buffer);
+        eq.process(block);
+        if (b == 20) firstAfterChange = buffer.getSample(0, 0);
+        for (int i = 0; i < 64; ++i) {
+            const float y = buffer.getSample(0, i);
+            if (b >= 20) maxStep = std::max(maxStep, std::abs(y - prev));
+            prev = y;
+        }
+    }
+
+    REQUIRE(firstAfterChange < 0.3f);                           // no jump at the block edge
+    REQUIRE(maxStep < 0.003f);                                  // 0.25 → 1.0 spread over the ramp
+    REQUIRE(prev == Catch::Approx(1.f).margin(0.02f));          // settles at +12 dB
+}
+
+TEST_CASE("Tilt adds to the band gains") {
+    EQProcessor eq;
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate       = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels      = 1;
+    eq.prepare(spec);
+    eq.setGains(6.f, 0.f, 0.f);
+    eq.setTilt(0.5f);   // −6 dB on the low shelf cancels the +6 dB band gain
+
+    juce::AudioBuffer<float> buffer(1, 512);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < 512; ++i)
+            buffer.setSample(0, i, 1.f);
+        juce::dsp::AudioBlock<float> block(buffer);
+        eq.process(block);
+    }
+    for (int i = 384; i < 512; ++i)
+        REQUIRE(buffer.getSample(0, i) == Catch::Approx(1.f).margin(0.05f));
+}
+
+TEST_CASE("EQ under fast automation", "[.benchmark]") {
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate       = 48000.0;
+    spec.maximumBlockSize = 64;
+    spec.numChannels      = 2;
+
+    juce::AudioBuffer<float> noise(2, 64), buffer(2, 64);
+    juce::Random rng(7);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 64; ++i)
+            noise.setSample(c, i, rng.nextFloat() * 2.f - 1.f);
+
+    EQProcessor eq;
+    eq.prepare(spec);
+    eq.setGains(3.f, -2.f, 4.f);
+
+    BENCHMARK("static gains, 64-sample blocks") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        eq.process(block);
+        return buffer.getSample(0, 0);
+    };
+
+    int tick = 0;
+    BENCHMARK("tilt automated every block, 64-sample blocks") {
+        eq.setTilt(std::sin(0.05f * static_cast<float>(tick++)));
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        eq.process(block);
+        return buffer.getSample(0, 0);
+    };
+}
+
+TEST_CASE("Stereo cascade matches the mono path on each channel") {
+    juce::dsp::ProcessSpec mono { 44100.0, 64, 1 }, stereo { 44100.0, 64, 2 };
+    EQProcessor eqMono, eqStereo;
+    eqMono.prepare(mono);
+    eqStereo.prepare(stereo);
+    eqMono.setGains(6.f, -3.f, 4.f);
+    eqStereo.setGains(6.f, -3.f, 4.f);
+
+    juce::AudioBuffer<float> m(1, 64), s(2, 64);
+    float maxDiff = 0.f;
+    for (int b = 0; b < 100; ++b) {
+        if (b == 40) {   // exercise the ramped path too
+            eqMono.setTilt(0.7f);
+            eqStereo.setTilt(0.7f);
+        }
+        for (int i = 0; i < 64; ++i) {
+            const float x = std::sin(0.1f * static_cast<float>(b * 64 + i));
+            m.setSample(0, i, x);
+            s.setSample(0, i, x);
+            s.setSample(1, i, -x);
+        }
+        juce::dsp::AudioBlock<float> bm(m), bs(s);
+        eqMono.process(bm);
+        eqStereo.process(bs);
+        for (int i = 0; i < 64; ++i) {
+            maxDiff = std::max(maxDiff, std::abs(m.getSample(0, i) - s.getSample(0, i)));
+            maxDiff = std::max(maxDiff, std::abs(m.getSample(0, i) + s.getSample(1, i)));
+        }
+    }
+    REQUIRE(maxDiff < 1e-5f);
+}
+
+TEST_CASE("Fused stereo EQ vs three IIR passes", "[.benchmark]") {
+    using Filter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
+                                                  juce::dsp::IIR::Coefficients<float>>;
+    using Coeffs = juce::dsp::IIR::Coefficients<float>;
+    constexpr int kBlock = 512;
+    juce::dsp::ProcessSpec spec { 48000.0, kBlock, 2 };
+
+    juce::AudioBuffer<float> noise(2, kBlock), buffer(2, kBlock);
+    juce::Random rng(11);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < kBlock; ++i)
+            noise.setSample(c, i, rng.nextFloat() * 2.f - 1.f);
+
+    // The previous implementation: one scalar pass per section
+    Filter low, mid, high;
+    *low.state  = *Coeffs::makeLowShelf  (spec.sampleRate, 200.0,  0.707, juce::Decibels::decibelsToGain(3.f));
+    *mid.state  = *Coeffs::makePeakFilter(spec.sampleRate, 1000.0, 0.707, juce::Decibels::decibelsToGain(-2.f));
+    *high.state = *Coeffs::makeHighShelf (spec.sampleRate, 6000.0, 0.707, juce::Decibels::decibelsToGain(4.f));
+    low.prepare(spec);
+    mid.prepare(spec);
+    high.prepare(spec);
+
+    EQProcessor eq;
+    eq.prepare(spec);
+    eq.setGains(3.f, -2.f, 4.f);
+
+    BENCHMARK("three IIR passes, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> ctx(block);
+        low.process(ctx);
+        mid.process(ctx);
+        high.process(ctx);
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    BENCHMARK("fused cascade, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        eq.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+}
@@ -0,0 +1,251 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <JuceHeader.h>
+#include <cmath>
+#include "../Source/UI/RefreshGovernor.h"
+#include "../Source/UI/MatchVisualizer.h"
+#include "../Source/UI/LevelMeter.h"
+#include "../Source/UI/MorphPad.h"
+#include "TestHelpers.h"
+
+namespace {
+
+constexpr double kTick = 1.0 / RefreshGovernor::kActiveHz;
+
+CorpusCursor makeCursor(int count, int maxFrames)
+{
+    CorpusCursor c;
+    c.count = count;
+    c.maxFrames = maxFrames;
+    c.writeIndex = count % maxFrames;
+    c.version = static_cast<uint64_t>(count);
+    return c;
+}
+
+} // namespace
+
+// ── RefreshGovernor ──────────────────────────────────────────────────────
+
+TEST_CASE("RefreshGovernor: starts active and drops to idle after quiet ticks", "[EditorRefresh]")
+{
+    RefreshGovernor gov;
+    REQUIRE(gov.rateHz() == RefreshGovernor::kActiveHz);
+
+    for (int i = 0; i < RefreshGovernor::kIdleAfterTicks - 1; ++i)
+        REQUIRE(gov.update(true, false) == RefreshGovernor::kActiveHz);
+    REQUIRE(gov.update(true, false) == RefreshGovernor::kIdleHz);
+}
+
+TEST_CASE("RefreshGovernor: activity snaps back to the active rate", "[EditorRefresh]")
+{
+    RefreshGovernor gov;
+    for (int i = 0; i < 100; ++i) gov.update(true, false);
+    REQUIRE(gov.rateHz() == RefreshGovernor::kIdleHz);
+
+    REQUIRE(gov.update(true, true) == RefreshGovernor::kActiveHz);
+}
+
+TEST_CASE("RefreshGovernor: hidden editor runs at the hidden rate", "[EditorRefresh]")
+{
+    RefreshGovernor gov;
+    REQUIRE(gov.update(false, true) == RefreshGovernor::kHiddenHz);
+    // Becoming visible again without activity resumes at the idle rate
+    REQUIRE(gov.update(true, false) == RefreshGovernor::kIdleHz);
+}
+
+// ── Dirty regions ────────────────────────────────────────────────────────
+
+TEST_CASE("LevelMeter: unchanged levels report no dirty region", "[EditorRefresh]")
+{
+    JuceInit init;
+    LevelMeter meter;
+    meter.setBounds(0, 0, 20, 200);
+
+    REQUIRE_FALSE(meter.setLevels(0.5f, 0.5f).isEmpty());
+    REQUIRE(meter.setLevels(0.5f, 0.5f).isEmpty());
+    // Sub-pixel jitter does not invalidate
+    REQUIRE(meter.setLevels(0.501f, 0.5f).isEmpty());
+}
+
+TEST_CASE("LevelMeter: dirty region covers only the changed bar span", "[EditorRefresh]")
+{
+    JuceInit init;
+    LevelMeter meter;
+    meter.setBounds(0, 0, 20, 200);
+    meter.setLevels(0.5f, 0.5f);
+
+    const auto dirty = meter.setLevels(0.6f, 0.5f);
+    REQUIRE_FALSE(dirty.isEmpty());
+    REQUIRE(dirty.getRight() <= 10);      // left bar only
+    REQUIRE(dirty.getHeight() < 40);      // 20 px move plus corner margin
+}
+
+TEST_CASE("MatchVisualizer: steady input settles to no repaint", "[EditorRefresh]")
+{
+    JuceInit init;
+    MatchVisualizer viz;
+    viz.setBounds(0, 0, 320, 40);
+    const auto cursor = makeCursor(100, 400);
+
+    // Fill the history with a constant level and let the pulse decay
+    for (int i = 0; i < MatchVisualizer::kSlots + 40; ++i)
+        viz.tick(0.1f, 10, cursor, kTick);
+
+    REQUIRE(viz.tick(0.1f, 10, cursor, kTick).isEmpty());
+}
+
+TEST_CASE("MatchVisualizer: new grain invalidates only the bottom track", "[EditorRefresh]")
+{
+    JuceInit init;
+    MatchVisualizer viz;
+    viz.setBounds(0, 0, 320, 40);
+    const auto cursor = makeCursor(400, 400);
+    for (int i = 0; i < MatchVisualizer::kSlots + 40; ++i)
+        viz.tick(0.1f, 10, cursor, kTick);
+
+    MatchEvent ev;
+    ev.ctrl.rms     = 0.1f;
+    ev.matchedIndex = 30;
+    viz.addMatchEvents(&ev, 1);
+    const auto dirty = viz.tick(0.1f, 30, cursor, kTick);
+    REQUIRE_FALSE(dirty.isEmpty());
+    REQUIRE(dirty.getY() >= 40 / 2 - 4);            // bottom half (minus glow)
+    REQUIRE(dirty.getWidth() < viz.getWidth());      // old + new slot, not the whole track
+}
+
+TEST_CASE("MatchVisualizer: every event between ticks pulses its slot", "[EditorRefresh]")
+{
+    JuceInit init;
+    MatchVisualizer viz;
+    viz.setBounds(0, 0, 320, 40);
+    const auto cursor = makeCursor(400, 400);
+    for (int i = 0; i < MatchVisualizer::kSlots + 40; ++i)
+        viz.tick(0.1f, 200, cursor, kTick);
+
+    // Two matches far apart land between ticks; only the last is the "current" index
+    MatchEvent events[2];
+    events[0].matchedIndex = 5;     // slot 0
+    events[1].matchedIndex = 395;   // slot 31
+    for (auto& e : events) e.ctrl.rms = 0.1f;
+    viz.addMatchEvents(events, 2);
+
+    const auto dirty = viz.tick(0.1f, 200, cursor, kTick);
+    REQUIRE(dirty.getX() <= 2);
+    REQUIRE(dirty.getRight() >= viz.getWidth() - 2);
+}
+
+TEST_CASE("MatchVisualizer: pulses fade by elapsed time, not by tick count", "[EditorRefresh]")
+{
+    JuceInit init;
+    const auto cursor = makeCursor(400, 400);
+    // Time from a match until the pulse stops changing, with the timer at `hz`
+    auto fadeSeconds = [&](int hz) {
+        MatchVisualizer viz;
+        viz.setBounds(0, 0, 320, 40);
+        for (int i = 0; i < MatchVisualizer::kSlots + 40; ++i)
+            viz.tick(0.1f, 200, cursor, kTick);
+        MatchEvent ev;
+        ev.ctrl.rms     = 0.1f;
+        ev.matchedIndex = 5;
+        viz.addMatchEvents(&ev, 1);
+        double t = 0.0;
+        while (!viz.tick(0.1f, 200, cursor, 1.0 / hz).isEmpty() && t < 10.0)
+            t += 1.0 / hz;
+        return t;
+    };
+    const double active = fadeSeconds(RefreshGovernor::kActiveHz);
+    const double idle   = fadeSeconds(RefreshGovernor::kIdleHz);
+    REQUIRE(active > 0.2);
+    REQUIRE(std::abs(active - idle) <= 1.0 / RefreshGovernor::kIdleHz + 1e-9);
+}
+
+TEST_CASE("MorphPad: live levels invalidate only the changed corner", "[EditorRefresh]")
+{
+    JuceInit init;
+    MorphPad pad;
+    pad.setBounds(0, 0, 200, 200);
+    pad.setLiveLevels(0.f, 0.f, 0.f, 0.f);
+    REQUIRE(pad.setLiveLevels(0.f, 0.f, 0.f, 0.f).isEmpty());
+
+    const auto dirty = pad.setLiveLevels(0.f, 0.8f, 0.f, 0.f);   // TR — RMS
+    REQUIRE_FALSE(dirty.isEmpty());
+    REQUIRE(dirty.getX() > 150);
+    REQUIRE(dirty.getBottom() < 50);
+}
+
+// ── Benchmark: message-thread paint cost for N open editors ──────────────
+// Hidden by default; run with:  StitcherTests "[.benchmark]"
+
+namespace {
+
+struct SimEditor {
+    MorphPad        pad;
+    MatchVisualizer viz;
+    LevelMeter      meter;
+
+    SimEditor()
+    {
+        pad.setBounds(0, 0, 300, 300);
+        viz.setBounds(0, 0, 400, 48);
+        meter.setBounds(0, 0, 20, 300);
+    }
+
+    // One timer tick of a mostly-steady session: features drift slowly and a grain
+    // hand-off happens every few ticks, like a sustained pad through the plugin.
+    template <typename PaintFn>
+    void tick(int t, PaintFn&& paint)
+    {
+        const float drift = 0.3f + 0.02f * static_cast<float>((t / 15) % 4);
+        const auto cursor = makeCursor(400, 400);
+        paint(pad,   pad.setLiveLevels(drift, drift, 0.2f, 0.2f));
+        if (t % 8 == 0) {
+            MatchEvent ev;
+            ev.ctrl.rms     = drift;
+            ev.matchedIndex = (t / 8) % 400;
+            viz.addMatchEvents(&ev, 1);
+        }
+        paint(viz,   viz.tick(drift, (t / 8) % 400, cursor, kTick));
+        paint(meter, meter.setLevels(drift, drift));
+    }
+};
+
+void paintRegion(juce::Component& c, juce::Rectangle<int> region, juce::Image& target)
+{
+    juce::Graphics g(target);
+    g.reduceClipRegion(region);
+    c.paintEntireComponent(g, false);
+}
+
+} // namespace
+
+TEST_CASE("Editor refresh cost for N open editors", "[.benchmark][EditorRefresh]")
+{
+    JuceInit init;
+    constexpr int kEditors = 30;
+    constexpr int kTicks   = 30;   // one second of UI time
+    std::vector<std::unique_ptr<SimEditor>> editors;
+    for (int i = 0; i < kEditors; ++i)
+        editors.push_back(std::make_unique<SimEditor>());
+    juce::Image target(juce::Image::ARGB, 400, 300, true, juce::SoftwareImageType());
+
+    int tick = 0;
+    BENCHMARK("full repaint every tick (30 editors, 1 s)") {
+        for (int t = 0; t < kTicks; ++t, ++tick)
+            for (auto& e : editors)
+                e->tick(tick, [&](juce::Component& c, juce::Rectangle<int>) {
+                    paintRegion(c, c.getLocalBounds(), target);
+                });
+        return tick;
+    };
+
+    BENCHMARK("dirty regions only (30 editors, 1 s)") {
+        for (int t = 0; t < kTicks; ++t, ++tick)
+            for (auto& e : editors)
+                e->tick(tick, [&](juce::Component& c, juce::Rectangle<int> dirty) {
+                    if (!dirty.isEmpty())
+                        paintRegion(c, dirty, target);
+                });
+        return tick;
+    };
+}
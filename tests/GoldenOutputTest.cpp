@@ -0,0 +1,233 @@
+#include "catch2/catch_test_macros.hpp"
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "FactoryPresets.h"
+#include "TestHelpers.h"
+#include <cmath>
+
+// Golden-output regression harness. Every factory preset is rendered, with a seeded
+// matcher, over the fixed signals below and compared with tests/golden/<preset>.wav.
+//
+//   STITCHER_GOLDEN_UPDATE=1        write (or overwrite) the golden files instead of comparing
+//   STITCHER_GOLDEN_TOLERANCE=x     max absolute sample error allowed (default 1e-4; 0 = bit-exact)
+//   STITCHER_GOLDEN_DIR=path        read/write goldens elsewhere (default: tests/golden)
+//
+// Regenerate the goldens only for intentional output changes, on a reference build, and
+// commit them together with that change.
+
+#ifndef STITCHER_GOLDEN_DIR
+ #define STITCHER_GOLDEN_DIR "golden"
+#endif
+
+namespace {
+
+constexpr double      kSampleRate = 44100.0;
+constexpr int         kLength     = 44100;   // 1 s of each signal
+constexpr juce::int64 kSeed       = 0x5717c4e5;
+
+juce::File goldenDir()
+{
+    const auto env = juce::SystemStats::getEnvironmentVariable("STITCHER_GOLDEN_DIR", STITCHER_GOLDEN_DIR);
+    return juce::File::getCurrentWorkingDirectory().getChildFile(env);
+}
+
+bool updatingGoldens()
+{
+    return juce::SystemStats::getEnvironmentVariable("STITCHER_GOLDEN_UPDATE", "0").getIntValue() != 0;
+}
+
+float goldenTolerance()
+{
+    return juce::SystemStats::getEnvironmentVariable("STITCHER_GOLDEN_TOLERANCE", "1e-4").getFloatValue();
+}
+
+void writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio)
+{
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    REQUIRE(stream != nullptr);
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), kSampleRate, static_cast<unsigned>(audio.getNumChannels()), 32, {}, 0));
+    REQUIRE(writer != nullptr);
+    stream.release();
+    REQUIRE(writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples()));
+}
+
+juce::AudioBuffer<float> readWav(const juce::File& file)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr)
+        return {};
+    juce::AudioBuffer<float> audio(static_cast<int>(reader->numChannels),
+                                   static_cast<int>(reader->lengthInSamples));
+    reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+    return audio;
+}
+
+// Source: a decaying two-note figure over quiet noise, with a different phrase on each
+// side so the corpus has stereo and timbral variety.
+juce::AudioBuffer<float> makeSourceSignal()
+{
+    juce::AudioBuffer<float> audio(2, kLength);
+    juce::Random rng(1);
+    const double notes[2][4] = { { 110.0, 220.0, 165.0, 330.0 }, { 147.0, 294.0, 196.0, 440.0 } };
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < kLength; ++i) {
+            const int    note = (i / (kLength / 8)) % 4;
+            const double t    = static_cast<double>(i % (kLength / 8)) / kSampleRate;
+            const double tone = std::sin(juce::MathConstants<double>::twoPi * notes[c][note] * t)
+                              * std::exp(-6.0 * t);
+            audio.setSample(c, i, static_cast<float>(0.4 * tone) + (rng.nextFloat() - 0.5f) * 0.02f);
+        }
+    return audio;
+}
+
+// Control: noise bursts whose brightness and level change every 50 ms, so every feature
+// weight sees movement.
+juce::AudioBuffer<float> makeControlSignal()
+{
+    juce::AudioBuffer<float> audio(2, kLength);
+    juce::Random rng(2);
+    const int burst = static_cast<int>(kSampleRate * 0.05);
+    float lp = 0.f;
+    for (int i = 0; i < kLength; ++i) {
+        const int   k     = i / burst;
+        const float level = 0.1f + 0.4f * static_cast<float>((k * 7) % 5) / 4.f;
+        const float coeff = 0.05f + 0.9f * static_cast<float>((k * 3) % 4) / 3.f;   // one-pole brightness
+        lp += coeff * ((rng.nextFloat() * 2.f - 1.f) - lp);
+        const float s = (i % burst) < burst / 2 ? lp * level : 0.f;
+        audio.setSample(0, i, s);
+        audio.setSample(1, i, s);
+    }
+    return audio;
+}
+
+struct TempDir {
+    juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getChildFile("StitcherGoldenTest_" + juce::String(juce::Time::currentTimeMillis()));
+    TempDir()  { dir.createDirectory(); }
+    ~TempDir() { dir.deleteRecursively(); }
+};
+
+RenderOptions goldenOptions()
+{
+    RenderOptions options;
+    options.blockSize     = 512;
+    options.tailSeconds   = 0.5;
+    options.bitsPerSample = 32;
+    options.seed          = kSeed;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("Golden output: seeded renders are bit-identical and the seed picks the frames", "[golden]")
+{
+    JuceInit init;
+    TempDir tmp;
+    writeWav(tmp.dir.getChildFile("src.wav"),  makeSourceSignal());
+    writeWav(tmp.dir.getChildFile("ctrl.wav"), makeControlSignal());
+
+    std::vector<RenderJob> jobs(3);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].mainInput      = tmp.dir.getChildFile("src.wav");
+        jobs[i].sidechainInput = tmp.dir.getChildFile("ctrl.wav");
+        jobs[i].output         = tmp.dir.getChildFile("out" + juce::String(static_cast<int>(i)) + ".wav");
+        jobs[i].preset         = "Chaos Engine";   // rand near 1: the matcher pick is random
+    }
+
+    auto options = goldenOptions();
+    const auto first = OfflineRenderer::renderAll({ jobs[0], jobs[1] }, options, 2);
+    options.seed = kSeed + 1;
+    const auto other = OfflineRenderer::renderAll({ jobs[2] }, options, 1);
+    REQUIRE(first[0].result.wasOk());
+    REQUIRE(first[1].result.wasOk());
+    REQUIRE(other[0].result.wasOk());
+
+    const auto a = readWav(jobs[0].output);
+    const auto b = readWav(jobs[1].output);
+    const auto c = readWav(jobs[2].output);
+    REQUIRE(a.getNumSamples() > 0);
+
+    bool sameSeedIdentical = true, otherSeedDiffers = false;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < a.getNumSamples(); ++i) {
+            sameSeedIdentical = sameSeedIdentical && a.getSample(ch, i) == b.getSample(ch, i);
+            otherSeedDiffers  = otherSeedDiffers  || a.getSample(ch, i) != c.getSample(ch, i);
+        }
+    REQUIRE(sameSeedIdentical);
+    REQUIRE(otherSeedDiffers);
+}
+
+// Hidden until tests/golden/ is rendered on the reference build and committed; run with
+//   StitcherTests "[.golden]"
+TEST_CASE("Golden output: every factory preset matches its stored render", "[.golden]")
+{
+    JuceInit init;
+    TempDir tmp;
+    writeWav(tmp.dir.getChildFile("src.wav"),  makeSourceSignal());
+    writeWav(tmp.dir.getChildFile("ctrl.wav"), makeControlSignal());
+
+    const auto dir    = goldenDir();
+    const bool update = updatingGoldens();
+    if (update)
+        dir.createDirectory();
+
+    std::vector<RenderJob>  jobs;
+    std::vector<juce::File> goldens;
+    for (const auto& preset : getFactoryPresets()) {
+        const auto golden = dir.getChildFile(juce::File::createLegalFileName(preset.name) + ".wav");
+        // A new preset must come with its golden, or it would never be compared
+        if (!update && !golden.existsAsFile()) {
+            FAIL_CHECK("no golden file for preset \"" << preset.name << "\" in " << dir.getFullPathName()
+                       << " (run with STITCHER_GOLDEN_UPDATE=1 on a reference build and commit it)");
+            continue;
+        }
+        RenderJob job;
+        job.mainInput      = tmp.dir.getChildFile("src.wav");
+        job.sidechainInput = tmp.dir.getChildFile("ctrl.wav");
+        job.output         = update ? golden : tmp.dir.getChildFile(golden.getFileName());
+        job.preset         = preset.name;
+        jobs.push_back(job);
+        goldens.push_back(golden);
+    }
+    if (jobs.empty())
+        return;
+
+    const auto results = OfflineRenderer::renderAll(jobs, goldenOptions());
+    const float tolerance = goldenTolerance();
+
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        INFO("preset: " << jobs[j].preset);
+        INFO(results[j].result.getErrorMessage());
+        REQUIRE(results[j].result.wasOk());
+        if (update)
+            continue;
+
+        const auto rendered = readWav(jobs[j].output);
+        const auto expected = readWav(goldens[j]);
+        CHECK(rendered.getNumChannels() == expected.getNumChannels());
+        CHECK(rendered.getNumSamples()  == expected.getNumSamples());
+        if (rendered.getNumChannels() != expected.getNumChannels()
+            || rendered.getNumSamples() != expected.getNumSamples())
+            continue;
+
+        float maxErr = 0.f;
+        int   worstSample = 0, worstChannel = 0;
+        for (int c = 0; c < expected.getNumChannels(); ++c)
+            for (int i = 0; i < expected.getNumSamples(); ++i) {
+                const float err = std::abs(rendered.getSample(c, i) - expected.getSample(c, i));
+                if (err > maxErr) {
+                    maxErr       = err;
+                    worstSample  = i;
+                    worstChannel = c;
+                }
+            }
+        INFO("max error " << maxErr << " at sample " << worstSample << ", channel " << worstChannel
+             << " (tolerance " << tolerance << ")");
+        CHECK(maxErr <= tolerance);
+    }
+}
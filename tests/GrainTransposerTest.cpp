@@ -0,0 +1,101 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "GrainTransposer.h"
+#include <cmath>
+#include <vector>
+
+using Catch::Approx;
+
+namespace {
+constexpr int kFrame = 2048;
+
+std::vector<float> sine(float cyclesPerFrame)
+{
+    std::vector<float> v(kFrame);
+    for (int i = 0; i < kFrame; ++i)
+        v[static_cast<size_t>(i)] = std::sin(6.2831853f * cyclesPerFrame * static_cast<float>(i) / kFrame);
+    return v;
+}
+
+int zeroCrossings(const float* x, int n)
+{
+    int count = 0;
+    for (int i = 1; i < n; ++i)
+        if ((x[i - 1] < 0.f) != (x[i] < 0.f)) ++count;
+    return count;
+}
+
+CorpusFrame makeFrame(const std::vector<float>& audio, uint64_t serial)
+{
+    CorpusFrame f;
+    f.audioL = audio;
+    f.audioR = audio;
+    f.serial = serial;
+    return f;
+}
+} // namespace
+
+TEST_CASE("GrainTransposer: 0 semitones hands back the frame itself", "[GrainTransposer]")
+{
+    GrainTransposer t;
+    t.prepare(kFrame, 8);
+    const auto frame = makeFrame(sine(20.f), 0);
+    const float* l = nullptr, *r = nullptr;
+    t.transpose(frame, l, r);
+    REQUIRE(l == frame.audioL.data());
+    REQUIRE(r == frame.audioR.data());
+}
+
+TEST_CASE("GrainTransposer: an octave doubles or halves the frequency", "[GrainTransposer]")
+{
+    const auto src = sine(20.f);
+    std::vector<float> out(kFrame), scratch(kFrame);
+    const int base = zeroCrossings(src.data(), kFrame);
+
+    GrainTransposer::resample(src.data(), out.data(), kFrame, 2.0, scratch.data());
+    REQUIRE(zeroCrossings(out.data(), kFrame) == Approx(2 * base).epsilon(0.1));   // loop point adds a few
+
+    GrainTransposer::resample(src.data(), out.data(), kFrame, 0.5, scratch.data());
+    REQUIRE(zeroCrossings(out.data(), kFrame) == Approx(base / 2).margin(2));
+    REQUIRE(out[100] == Approx(src[50]).margin(1e-3));   // integer positions are exact
+}
+
+TEST_CASE("GrainTransposer: transposed-up grains loop without a click", "[GrainTransposer]")
+{
+    // 20.3 cycles: the frame end does not line up with its start, so a plain wrap would jump
+    const auto src = sine(20.3f);
+    std::vector<float> out(kFrame), scratch(kFrame);
+    GrainTransposer::resample(src.data(), out.data(), kFrame, std::pow(2.0, 7.0 / 12.0), scratch.data());
+
+    // A sine at 1.5× the rate moves at most ~2π·f·1.5/N per sample
+    const float maxSlope = 6.2831853f * 20.3f * 1.5f / kFrame;
+    float maxStep = 0.f;
+    for (int i = 1; i < kFrame; ++i)
+        maxStep = std::max(maxStep, std::abs(out[static_cast<size_t>(i)] - out[static_cast<size_t>(i - 1)]));
+    REQUIRE(maxStep < maxSlope * 1.5f);
+}
+
+TEST_CASE("GrainTransposer: cache is keyed by corpus slot contents and semitones", "[GrainTransposer]")
+{
+    GrainTransposer t;
+    t.prepare(kFrame, 4);
+    t.setSemitones(5.f);
+
+    const auto a = makeFrame(sine(10.f), 1);
+    const float* l = nullptr, *r = nullptr;
+    t.transpose(a, l, r);
+    t.transpose(a, l, r);
+    REQUIRE(t.getCacheMisses() == 1);
+    REQUIRE(t.getCacheHits() == 1);
+    REQUIRE(l != a.audioL.data());
+
+    const auto overwritten = makeFrame(sine(30.f), 5);   // same slot (5 % 4 == 1), new contents
+    t.transpose(overwritten, l, r);
+    REQUIRE(t.getCacheMisses() == 2);
+
+    t.setSemitones(-3.f);
+    t.transpose(overwritten, l, r);
+    REQUIRE(t.getCacheMisses() == 3);
+    t.transpose(overwritten, l, r);
+    REQUIRE(t.getCacheHits() == 2);
+}
@@ -0,0 +1,109 @@
+#include "catch2/catch_test_macros.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include "PitchShiftProcessor.h"
+#include "TruePeakLimiter.h"
+#include <vector>
+
+namespace {
+
+int streamPitchLatency()
+{
+    PitchShiftProcessor ps;
+    ps.prepare({ 44100.0, 512, 2 });
+    return ps.getLatencySamples();
+}
+
+int limiterLatency()
+{
+    TruePeakLimiter limiter;
+    limiter.setLookaheadMs(1.5);   // parameter default
+    limiter.prepare({ 44100.0, 512, 2 });
+    return limiter.getLatencySamples();
+}
+
+// Sends an impulse at `at` into the main input (and the sidechain too when asked) and
+// returns where the output peaks.
+int impulseOnset(StitcherProcessor& proc, int at, bool sidechain)
+{
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    int peakIndex = -1;
+    float peak = 0.f;
+    for (int b = 0; b * 512 < proc.getLatencySamples() + at + 1024; ++b) {
+        buffer.clear();
+        if (b == at / 512)
+            for (int c = 0; c < (sidechain ? 4 : 2); ++c)
+                buffer.setSample(c, at % 512, 0.5f);
+        proc.processBlock(buffer, midi);
+        for (int i = 0; i < 512; ++i) {
+            const float v = std::abs(buffer.getSample(0, i));
+            if (v > peak) { peak = v; peakIndex = b * 512 + i; }
+        }
+    }
+    return peak > 0.1f ? peakIndex : -1;
+}
+
+} // namespace
+
+TEST_CASE("StitcherProcessor: reported latency is the frame, pitch path and limiter", "[Latency]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    preparePlugin(proc);
+
+    constexpr int kFrame = 2048 - 1;   // 50 ms match length at 44.1 kHz; a grain starts on the frame's last sample
+    const int pitchLatency = streamPitchLatency();
+    const int limLatency   = limiterLatency();
+    REQUIRE(pitchLatency > 0);
+    REQUIRE(proc.getLatencySamples() == kFrame + pitchLatency + limLatency);
+    REQUIRE(proc.computeLatencySamples(false) == kFrame + pitchLatency + limLatency);
+    REQUIRE(proc.computeLatencySamples(true)  == kFrame + limLatency);
+
+    // Per-grain pitch drops the stretcher from the chain
+    setParam(proc, ParamIDs::pitchMode, 1.f);
+    preparePlugin(proc);
+    REQUIRE(proc.getLatencySamples() == kFrame + limLatency);
+
+    // Lookahead is load-time, like the match length
+    setParam(proc, ParamIDs::limiterLookahead, 5.f);
+    preparePlugin(proc);
+    REQUIRE(proc.getLatencySamples() == kFrame + juce::roundToInt(0.005 * 44100.0) + TruePeakLimiter::kFilterDelay);
+}
+
+TEST_CASE("StitcherProcessor: dry path is delayed by the reported latency", "[Latency]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    setParam(proc, ParamIDs::mix, 0.f);
+    setParam(proc, ParamIDs::reverbWet, 0.f);
+
+    for (float mode : { 0.f, 1.f }) {
+        setParam(proc, ParamIDs::pitchMode, mode);
+        preparePlugin(proc);
+        INFO("pitch mode " << mode);
+        REQUIRE(impulseOnset(proc, 0, false) == proc.getLatencySamples());   // main input only
+    }
+}
+
+TEST_CASE("StitcherProcessor: grain and dry paths line up", "[Latency]")
+{
+    // Main and sidechain carry the same impulse, so with no randomness the only corpus
+    // frame is its own match and the grain replays the input frame unchanged.
+    JuceInit init;
+    constexpr int kAt = 700;   // inside the first frame, clear of the grain's fade-in
+    int onset[2] {};
+    for (int wet = 0; wet < 2; ++wet) {
+        StitcherProcessor proc;
+        setParam(proc, ParamIDs::pitchMode, 1.f);   // per grain, at 0 st: no stretcher
+        setParam(proc, ParamIDs::rand_, 0.f);
+        setParam(proc, ParamIDs::reverbWet, 0.f);
+        setParam(proc, ParamIDs::mix, wet == 1 ? 100.f : 0.f);
+        preparePlugin(proc);
+        onset[wet] = impulseOnset(proc, kAt, true);
+        INFO("mix " << (wet == 1 ? "100 %" : "0 %"));
+        REQUIRE(onset[wet] == proc.getLatencySamples() + kAt);
+    }
+    REQUIRE(onset[1] == onset[0]);
+}
@@ -0,0 +1,123 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "../Source/MatchEventQueue.h"
+#include "../Source/MatchLogWriter.h"
+#include <atomic>
+#include <thread>
+
+using Catch::Approx;
+
+namespace {
+MatchEvent makeEvent(int64_t t, int index)
+{
+    MatchEvent e;
+    e.sampleTime   = t;
+    e.ctrl.rms     = static_cast<float>(index) * 0.01f;
+    e.matchedIndex = index;
+    e.distance     = 0.5f;
+    e.candidates   = 3;
+    return e;
+}
+} // namespace
+
+TEST_CASE("MatchEventQueue: events come out in push order", "[MatchEventQueue]")
+{
+    MatchEventQueue q(8);
+    for (int i = 0; i < 5; ++i)
+        REQUIRE(q.push(makeEvent(i * 64, i)));
+
+    MatchEvent out[8];
+    REQUIRE(q.pop(out, 8) == 5);
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(out[i].sampleTime == i * 64);
+        REQUIRE(out[i].matchedIndex == i);
+    }
+    REQUIRE(q.getNumReady() == 0);
+}
+
+TEST_CASE("MatchEventQueue: full queue drops and counts instead of overwriting", "[MatchEventQueue]")
+{
+    MatchEventQueue q(4);
+    REQUIRE(q.capacity() == 4);
+    for (int i = 0; i < 6; ++i)
+        q.push(makeEvent(i, i));
+
+    REQUIRE(q.getDropped() == 2);
+    MatchEvent out[8];
+    REQUIRE(q.pop(out, 8) == 4);
+    REQUIRE(out[0].matchedIndex == 0);   // oldest kept
+    REQUIRE(out[3].matchedIndex == 3);
+}
+
+TEST_CASE("MatchEventQueue: pop wraps around the ring", "[MatchEventQueue]")
+{
+    MatchEventQueue q(4);
+    MatchEvent out[4];
+    int next = 0, expected = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i, ++next)
+            REQUIRE(q.push(makeEvent(next, next)));
+        const int n = q.pop(out, 4);
+        REQUIRE(n == 3);
+        for (int i = 0; i < n; ++i)
+            REQUIRE(out[i].matchedIndex == expected++);
+    }
+}
+
+TEST_CASE("MatchEventQueue: concurrent producer and consumer lose nothing", "[MatchEventQueue]")
+{
+    constexpr int kEvents = 200000;
+    MatchEventQueue q(1024);
+    std::atomic<bool> done { false };
+
+    std::thread producer([&] {
+        for (int i = 0; i < kEvents;)
+            if (q.push(makeEvent(i, i))) ++i;
+            else std::this_thread::yield();
+        done = true;
+    });
+
+    MatchEvent out[128];
+    int expected = 0;
+    bool ordered = true;
+    while (!done.load() || q.getNumReady() > 0) {
+        const int n = q.pop(out, 128);
+        for (int i = 0; i < n; ++i)
+            ordered = ordered && out[i].matchedIndex == expected++;
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(expected == kEvents);
+}
+
+TEST_CASE("MatchLogWriter: binary log round-trips every event", "[MatchEventQueue]")
+{
+    const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getChildFile("stitcher_match_log_test.stml");
+
+    MatchLogWriter log(256);
+    log.push(makeEvent(1, 1));           // inactive: ignored
+    REQUIRE(log.start(file, 48000.0, 512));
+    REQUIRE(log.isActive());
+    for (int i = 0; i < 1000; ++i) {
+        log.push(makeEvent(i * 512, i % 100));
+        if (i % 100 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    }
+    log.stop();
+    REQUIRE_FALSE(log.isActive());
+
+    double sr = 0.0;
+    int frameSize = 0;
+    std::vector<MatchEvent> events;
+    REQUIRE(MatchLogWriter::read(file, sr, frameSize, events));
+    REQUIRE(sr == 48000.0);
+    REQUIRE(frameSize == 512);
+    REQUIRE(static_cast<uint32_t>(events.size()) + log.getDropped() == 1000u);
+    REQUIRE(events.front().sampleTime == 0);
+    REQUIRE(events.front().candidates == 3);
+    REQUIRE(events.front().distance == Approx(0.5f));
+    REQUIRE(events.back().ctrl.rms == Approx(static_cast<float>(events.back().matchedIndex) * 0.01f));
+
+    file.deleteFile();
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <JuceHeader.h>
 #include "MidiLearn.h"
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
 
 // ─── Stub parameter ───────────────────────────────────────────────────────────
 
@@ -9,7 +12,6 @@ struct StubParam : juce::RangedAudioParameter {
         : juce::RangedAudioParameter({id, 1}, id) {}
 
     float getValue() const override                           { return value_; }
-    void  setValue(float v) override                          { value_ = v; }
     float getDefaultValue() const override                    { return 0.f; }
     juce::String getText(float, int) const override           { return {}; }
     float getValueForText(const juce::String&) const override { return 0.f; }
@@ -23,9 +25,40 @@ struct StubParam : juce::RangedAudioParameter {
 
     // setValueNotifyingHost is NOT virtual in JUCE — we intercept dispatch via
     // setValue() which is called internally. For the tests we just read value_.
+    void  setValue(float v) override                          { value_ = v; ++hostUpdates_; }
     float value_ = 0.f;
+    int   hostUpdates_ = 0;
 };
 
+namespace {
+
+void bind(MidiLearn& ml, juce::RangedAudioParameter& param, int cc)
+{
+    ml.startLearning(&param);
+    ml.handleCC(cc, 0);
+    REQUIRE(ml.processCapture());
+}
+
+// Dry path only: DC in, peak out, with CC messages in the first block
+float outputLevel(StitcherProcessor& proc, int numBlocks, const juce::MidiBuffer& firstBlockMidi)
+{
+    juce::AudioBuffer<float> buffer(4, 512);
+    float peak = 0.f;
+    for (int b = 0; b < numBlocks; ++b) {
+        juce::MidiBuffer midi;
+        if (b == 0)
+            midi = firstBlockMidi;
+        buffer.clear();
+        for (int c = 0; c < 2; ++c)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(c), 0.1f, 512);
+        proc.processBlock(buffer, midi);
+        peak = buffer.getMagnitude(0, 0, 512);
+    }
+    return peak;
+}
+
+} // namespace
+
 // ─── Tests ────────────────────────────────────────────────────────────────────
 
 TEST_CASE("MidiLearn: bind and dispatch CC") {
@@ -37,8 +70,10 @@ TEST_CASE("MidiLearn: bind and dispatch CC") {
     ml.handleCC(7, 0);          // triggers capture
     REQUIRE(ml.processCapture()); // commits binding
 
-    // CC 7 with value 64 → param value should be 64/127
+    // CC 7 with value 64 → param value should be 64/127 once the host update is sent
     ml.handleCC(7, 64);
+    REQUIRE(param.value_ == 0.f);
+    REQUIRE(ml.dispatchPending() == 1);
     REQUIRE(param.value_ == Catch::Approx(64.f / 127.f).margin(1e-5f));
 }
 
@@ -60,6 +95,7 @@ TEST_CASE("MidiLearn: learning capture binds next CC") {
 
     // Now dispatch CC 10 → param should be updated
     ml.handleCC(10, 127);
+    ml.dispatchPending();
     REQUIRE(param.value_ == Catch::Approx(1.f).margin(1e-5f));
 }
 
@@ -83,6 +119,7 @@ TEST_CASE("MidiLearn: rebind overwrites previous binding") {
 
     // Dispatch CC 7 → only paramB updated
     ml.handleCC(7, 64);
+    ml.dispatchPending();
     REQUIRE(paramB.value_ == Catch::Approx(64.f / 127.f).margin(1e-5f));
     REQUIRE(paramA.value_ == 0.f); // unchanged
 }
@@ -113,5 +150,86 @@ TEST_CASE("MidiLearn: serialization round-trip") {
 
     // Dispatch to verify the binding is live
     dst.handleCC(5, 127);
+    dst.dispatchPending();
     REQUIRE(param2.value_ == Catch::Approx(1.f).margin(1e-5f));
 }
+
+TEST_CASE("MidiLearn: a dense CC stream reaches the sink per message and the host once") {
+    MidiLearn ml;
+    StubParam param("dense");
+    bind(ml, param, 1);
+
+    int   sinkCalls = 0;
+    float sinkLast  = -1.f;
+    ml.setAudioSink([&](juce::RangedAudioParameter& p, float normalised) {
+        REQUIRE(&p == &param);
+        ++sinkCalls;
+        sinkLast = normalised;
+    });
+
+    for (int i = 0; i < 1000; ++i)
+        ml.handleCC(1, i % 128);
+    REQUIRE(sinkCalls == 1000);
+    REQUIRE(sinkLast == Catch::Approx(999 % 128 / 127.f));
+    REQUIRE(param.hostUpdates_ == 0);   // nothing reaches the host from the audio thread
+
+    REQUIRE(ml.dispatchPending() == 1);
+    REQUIRE(param.hostUpdates_ == 1);
+    REQUIRE(param.value_ == Catch::Approx(999 % 128 / 127.f));
+    REQUIRE(ml.dispatchPending() == 0);
+}
+
+TEST_CASE("MidiLearn: each controller gets its own host update") {
+    MidiLearn ml;
+    StubParam a("a"), b("b");
+    bind(ml, a, 20);
+    bind(ml, b, 21);
+
+    for (int i = 0; i < 10; ++i) {
+        ml.handleCC(20, 10 + i);
+        ml.handleCC(21, 100 + i);
+    }
+    REQUIRE(ml.dispatchPending() == 2);
+    REQUIRE(a.value_ == Catch::Approx(19.f / 127.f));
+    REQUIRE(b.value_ == Catch::Approx(109.f / 127.f));
+}
+
+TEST_CASE("MidiLearn: values queued before a rebind go to the old parameter") {
+    MidiLearn ml;
+    StubParam oldParam("old"), newParam("new");
+    bind(ml, oldParam, 7);
+
+    ml.handleCC(7, 127);
+    bind(ml, newParam, 7);
+    REQUIRE(oldParam.value_ == Catch::Approx(1.f));
+    REQUIRE(newParam.hostUpdates_ == 0);
+}
+
+TEST_CASE("StitcherProcessor: a bound CC moves the audio before the host parameter") {
+    JuceInit init;
+    StitcherProcessor proc;
+    setParam(proc, ParamIDs::mix, 0.f);
+    preparePlugin(proc);
+
+    auto* gainOut = proc.getAPVTS().getParameter(ParamIDs::gainOut);
+    auto& ml = proc.getMidiLearn();
+    bind(ml, *gainOut, 7);
+
+    const float unity = outputLevel(proc, 20, {});
+    REQUIRE(unity == Catch::Approx(0.1f).epsilon(0.05));
+
+    juce::MidiBuffer cc;
+    cc.addEvent(juce::MidiMessage::controllerEvent(1, 7, 0), 0);   // bottom of the range, -36 dB
+    const float quiet = outputLevel(proc, 20, cc);
+    REQUIRE(quiet == Catch::Approx(unity * juce::Decibels::decibelsToGain(-36.f)).epsilon(0.05));
+    REQUIRE(paramValue(proc, ParamIDs::gainOut) == 0.f);
+
+    // The host update echoes back without moving the audio
+    REQUIRE(ml.dispatchPending() == 1);
+    REQUIRE(paramValue(proc, ParamIDs::gainOut) == Catch::Approx(-36.f));
+    REQUIRE(outputLevel(proc, 5, {}) == Catch::Approx(quiet).epsilon(0.05));
+
+    // A change from anywhere else takes over again
+    setParam(proc, ParamIDs::gainOut, 0.f);
+    REQUIRE(outputLevel(proc, 20, {}) == Catch::Approx(unity).epsilon(0.05));
+}
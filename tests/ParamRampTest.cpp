@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "ParamRamp.h"
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+using Catch::Approx;
+
+TEST_CASE("ParamRamp: settled values are flagged constant") {
+    ParamRamp ramp;
+    ramp.prepare(48000.0, 64);
+    ramp.snap(0.5f);
+    ramp.setTarget(0.5f);
+    ramp.advance(64);
+    REQUIRE(ramp.isConstant());
+    REQUIRE(ramp.getConstant() == 0.5f);
+
+    std::vector<float> data(64, 2.f);
+    ramp.applyGain(data.data(), 64);
+    for (float v : data) REQUIRE(v == 1.f);
+}
+
+TEST_CASE("ParamRamp: a target change glides continuously across blocks") {
+    constexpr int kBlock = 64;
+    ParamRamp ramp;
+    ramp.prepare(48000.0, kBlock);   // 20 ms = 960 samples
+    ramp.snap(0.f);
+    ramp.setTarget(1.f);
+
+    float prev = 0.f, maxStep = 0.f;
+    int blocks = 0;
+    for (; blocks < 100; ++blocks) {
+        ramp.advance(kBlock);
+        if (ramp.isConstant()) break;
+        for (int i = 0; i < kBlock; ++i) {
+            maxStep = std::max(maxStep, std::abs(ramp.getRamp()[i] - prev));
+            prev = ramp.getRamp()[i];
+        }
+    }
+    REQUIRE(blocks == 960 / kBlock);
+    REQUIRE(prev == 1.f);
+    REQUIRE(maxStep == Approx(1.f / 960.f).epsilon(0.01));
+    REQUIRE(ramp.getConstant() == 1.f);
+}
+
+TEST_CASE("ParamRamp: crossfade blends per sample and is exact at the ends") {
+    constexpr int kBlock = 32;
+    std::vector<float> a(kBlock), b(kBlock), out(kBlock);
+    for (int i = 0; i < kBlock; ++i) {
+        a[static_cast<size_t>(i)] = 0.3f + 0.01f * i;
+        b[static_cast<size_t>(i)] = -0.7f + 0.02f * i;
+    }
+
+    ParamRamp ramp;
+    ramp.prepare(1000.0, kBlock, 0.064);   // 64 samples
+    ramp.snap(1.f);
+    ramp.advance(kBlock);
+    ramp.crossfade(out.data(), a.data(), b.data(), kBlock);
+    REQUIRE(out == b);
+
+    ramp.setTarget(0.f);
+    ramp.advance(kBlock);
+    ramp.crossfade(out.data(), a.data(), b.data(), kBlock);
+    for (int i = 0; i < kBlock; ++i) {
+        const float w = ramp.getRamp()[i];
+        REQUIRE(out[static_cast<size_t>(i)] == Approx(a[static_cast<size_t>(i)] * (1.f - w) + b[static_cast<size_t>(i)] * w).margin(1e-6));
+    }
+
+    ramp.advance(kBlock);
+    ramp.advance(kBlock);
+    REQUIRE(ramp.isConstant());
+    ramp.crossfade(out.data(), a.data(), b.data(), kBlock);
+    REQUIRE(out == a);
+}
+
+TEST_CASE("ParamRamp benchmark: per-sample atomic gain vs block ramp", "[.benchmark]") {
+    constexpr int kBlock = 512;
+    std::vector<float> data(kBlock, 0.5f);
+    std::atomic<float> gain { 0.9f };
+
+    BENCHMARK("atomic load per sample") {
+        for (int i = 0; i < kBlock; ++i)
+            data[static_cast<size_t>(i)] *= gain.load();
+        return data[0];
+    };
+
+    ParamRamp ramp;
+    ramp.prepare(48000.0, kBlock);
+    ramp.snap(0.9f);
+    BENCHMARK("ParamRamp, settled") {
+        ramp.setTarget(gain.load());
+        ramp.advance(kBlock);
+        ramp.applyGain(data.data(), kBlock);
+        return data[0];
+    };
+
+    float target = 0.f;
+    BENCHMARK("ParamRamp, gliding every block") {
+        target = 1.f - target;
+        ramp.setTarget(target);
+        ramp.advance(kBlock);
+        ramp.applyGain(data.data(), kBlock);
+        return data[0];
+    };
+}
@@ -0,0 +1,183 @@
+#include "catch2/catch_test_macros.hpp"
+#include <JuceHeader.h>
+#include "PresetCatalogue.h"
+#include "PresetManager.h"
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+
+namespace {
+
+struct TempDir {
+    juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getChildFile("StitcherCatalogueTest_" + juce::String(juce::Time::currentTimeMillis()));
+    TempDir()  { dir.deleteRecursively(); dir.createDirectory(); }
+    ~TempDir() { dir.deleteRecursively(); }
+};
+
+juce::String presetXml(float rmsWeight)
+{
+    return "<PARAMETERS><PARAM id=\"rms_weight\" value=\"" + juce::String(rmsWeight) + "\"/></PARAMETERS>";
+}
+
+void writePreset(const juce::File& dir, const juce::String& name, float rmsWeight = 0.5f)
+{
+    REQUIRE(dir.getChildFile(name + ".xml").replaceWithText(presetXml(rmsWeight)));
+}
+
+std::vector<PresetManager::FactoryPreset> factoryList()
+{
+    return {
+        { "Aether Pad",   "Texture", presetXml(0.1f) },
+        { "Broken Tape",  "Lo-Fi",   presetXml(0.2f) },
+        { "Pad Machine",  "Texture", presetXml(0.3f) },
+    };
+}
+
+bool waitForName(PresetCatalogue& cat, const juce::String& name, bool present, int timeoutMs)
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+    while (juce::Time::getMillisecondCounter() < deadline) {
+        if ((PresetCatalogue::find(*cat.getIndex(), name) != nullptr) == present)
+            return true;
+        juce::Thread::sleep(20);
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("PresetCatalogue: fuzzy score prefers word starts and tight matches", "[PresetCatalogue]")
+{
+    REQUIRE(PresetCatalogue::fuzzyScore("xyz", "Aether Pad") == -1);
+    REQUIRE(PresetCatalogue::fuzzyScore("", "Aether Pad") == 0);
+    REQUIRE(PresetCatalogue::fuzzyScore("aeth pad", "Aether Pad") > 0);
+    REQUIRE(PresetCatalogue::fuzzyScore("AP", "Aether Pad") > 0);
+
+    // "pad" at a word start beats the same letters scattered through a name
+    REQUIRE(PresetCatalogue::fuzzyScore("pad", "Pad Machine") > PresetCatalogue::fuzzyScore("pad", "Sparkle Drone"));
+    // Same match, shorter name wins
+    REQUIRE(PresetCatalogue::fuzzyScore("tape", "Tape") > PresetCatalogue::fuzzyScore("tape", "Tape Stop Long"));
+}
+
+TEST_CASE("PresetCatalogue: search ranks factory and user presets", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    writePreset(temp.dir, "My Pad");
+    writePreset(temp.dir, "Kick Room");
+
+    PresetCatalogue cat(temp.dir, factoryList());
+    REQUIRE(cat.waitUntilIdle(5000));
+
+    const auto pads = cat.search("pad", 10);
+    REQUIRE(pads.size() == 3);
+    REQUIRE(pads.contains("My Pad"));
+    REQUIRE(pads.contains("Pad Machine"));
+    REQUIRE_FALSE(pads.contains("Kick Room"));
+
+    REQUIRE(cat.search("brkn", 10) == juce::StringArray { "Broken Tape" });
+    REQUIRE(cat.search("a", 2).size() == 2);
+}
+
+TEST_CASE("PresetCatalogue: index lists factory presets first, then user presets sorted", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    writePreset(temp.dir, "Zebra");
+    writePreset(temp.dir, "Alpha");
+    writePreset(temp.dir, "Broken Tape");   // shadowed by the factory preset
+
+    PresetCatalogue cat(temp.dir, factoryList());
+    REQUIRE(cat.waitUntilIdle(5000));
+
+    const auto index = cat.getIndex();
+    REQUIRE(index->size() == 5);
+    REQUIRE((*index)[0].name == "Aether Pad");
+    REQUIRE((*index)[0].category == "Texture");
+    REQUIRE_FALSE((*index)[1].isUser);
+    REQUIRE((*index)[3].name == "Alpha");
+    REQUIRE((*index)[3].isUser);
+    REQUIRE((*index)[4].name == "Zebra");
+}
+
+TEST_CASE("PresetCatalogue: files added or removed behind its back are picked up", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    PresetCatalogue cat(temp.dir, {});
+    REQUIRE(cat.waitUntilIdle(5000));
+    REQUIRE(cat.getIndex()->empty());
+
+    writePreset(temp.dir, "From Another Instance");
+    REQUIRE(waitForName(cat, "From Another Instance", true, 3 * PresetCatalogue::kPollIntervalMs));
+
+    temp.dir.getChildFile("From Another Instance.xml").deleteFile();
+    REQUIRE(waitForName(cat, "From Another Instance", false, 3 * PresetCatalogue::kPollIntervalMs));
+}
+
+TEST_CASE("PresetCatalogue: loading a preset prefetches its neighbours", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    for (const auto* name : { "U1", "U2", "U3", "U4", "U5", "U6", "U7", "U8" })
+        writePreset(temp.dir, name);
+
+    PresetCatalogue cat(temp.dir, {});
+    REQUIRE(cat.waitUntilIdle(5000));
+    REQUIRE_FALSE(cat.isCached("U4"));
+
+    cat.prefetchAround("U4");
+    REQUIRE(cat.waitUntilIdle(5000));
+    for (const auto* name : { "U2", "U3", "U4", "U5", "U6" })
+        REQUIRE(cat.isCached(name));
+    REQUIRE_FALSE(cat.isCached("U8"));
+
+    // Wraps around the ends like selectNext/selectPrev
+    cat.prefetchAround("U1");
+    REQUIRE(cat.waitUntilIdle(5000));
+    REQUIRE(cat.isCached("U8"));
+    REQUIRE(cat.isCached("U7"));
+
+    REQUIRE(cat.getUserState("U8").isValid());
+    REQUIRE_FALSE(cat.getUserState("Missing").isValid());
+}
+
+TEST_CASE("PresetManager: save and delete update the catalogue without waiting for a rescan", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    StitcherProcessor proc;
+    PresetManager pm(proc.getAPVTS(), temp.dir, factoryList());
+
+    pm.savePreset("Fresh");
+    REQUIRE(pm.getUserPresetNames() == juce::StringArray { "Fresh" });
+    REQUIRE(pm.isCurrentPresetUser());
+    REQUIRE(pm.getCatalogue().isCached("Fresh"));
+    REQUIRE(pm.searchPresets("frsh").contains("Fresh"));
+
+    REQUIRE(pm.getCatalogue().waitUntilIdle(5000));
+    REQUIRE(pm.getPresetNames().size() == 4);
+
+    pm.deletePreset("Fresh");
+    REQUIRE(pm.getUserPresetNames().isEmpty());
+    REQUIRE(pm.getCatalogue().waitUntilIdle(5000));
+    REQUIRE(pm.getUserPresetNames().isEmpty());
+}
+
+TEST_CASE("PresetManager: loading a preset does not start the catalogue", "[PresetCatalogue]")
+{
+    JuceInit init;
+    TempDir temp;
+    writePreset(temp.dir, "Solo", 0.25f);
+    StitcherProcessor proc;
+    PresetManager pm(proc.getAPVTS(), temp.dir, factoryList());
+
+    REQUIRE(pm.loadPreset("Solo"));
+    REQUIRE(pm.isCurrentPresetUser());
+    REQUIRE(pm.loadPreset("Broken Tape"));
+    REQUIRE_FALSE(pm.isCurrentPresetUser());
+    REQUIRE_FALSE(pm.hasCatalogue());
+
+    REQUIRE(pm.getPresetNames().contains("Aether Pad"));   // the first browse starts it
+    REQUIRE(pm.hasCatalogue());
+}
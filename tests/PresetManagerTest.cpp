@@ -2,11 +2,7 @@
 #include <catch2/catch_approx.hpp>
 #include "PresetManager.h"
 #include "Parameters.h"
-
-struct JuceInit {
-    JuceInit()  { juce::initialiseJuce_GUI(); }
-    ~JuceInit() { juce::shutdownJuce_GUI(); }
-};
+#include "TestHelpers.h"
 
 struct DummyProcessor : public juce::AudioProcessor {
     DummyProcessor() : juce::AudioProcessor(
@@ -199,6 +195,32 @@ TEST_CASE("PresetManager: loadPreset loads factory preset by name") {
     tempDir.deleteRecursively();
 }
 
+TEST_CASE("PresetManager: factory state is parsed once and never modified by a load") {
+    JuceInit init;
+    auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("StitcherPresetTest_" + juce::String(juce::Time::currentTimeMillis()));
+    tempDir.deleteRecursively();
+
+    DummyProcessor proc;
+    juce::AudioProcessorValueTreeState apvts{proc, nullptr, "P", createParameterLayout()};
+
+    std::vector<PresetManager::FactoryPreset> factory {
+        { "TestFactory", "Drums", makePresetXml(0.42f) },
+    };
+    factory[0].state = PresetManager::parseState(factory[0].xml);
+    const auto cached = factory[0].state;
+    factory[0].xml = {};   // a pre-parsed preset must not need its XML again
+    PresetManager pm{apvts, tempDir, factory};
+
+    REQUIRE(pm.loadPreset("TestFactory"));
+    apvts.getParameter(ParamIDs::rmsWeight)->setValueNotifyingHost(0.9f);
+    REQUIRE(pm.loadPreset("TestFactory"));
+    REQUIRE(apvts.getRawParameterValue(ParamIDs::rmsWeight)->load() == Catch::Approx(0.42f).margin(0.01f));
+    REQUIRE(cached.isEquivalentTo(PresetManager::parseState(makePresetXml(0.42f))));
+
+    tempDir.deleteRecursively();
+}
+
 TEST_CASE("PresetManager: selectNext cycles factory then user") {
     JuceInit init;
     auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
@@ -0,0 +1,186 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include "PresetMorpher.h"
+#include "SnapshotHandoff.h"
+#include <atomic>
+#include <thread>
+
+using Catch::Approx;
+
+namespace {
+
+// The current state with one parameter changed
+juce::ValueTree stateWith(StitcherProcessor& proc, const char* id, float plain)
+{
+    auto state = proc.getAPVTS().copyState();
+    state.getChildWithProperty("id", id).setProperty("value", plain, nullptr);
+    return state;
+}
+
+// Dry path only, so the output level follows Output gain: DC in, peak out
+float outputLevel(StitcherProcessor& proc, int numBlocks)
+{
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    float peak = 0.f;
+    for (int b = 0; b < numBlocks; ++b) {
+        buffer.clear();
+        for (int c = 0; c < 2; ++c)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(c), 0.1f, 512);
+        proc.processBlock(buffer, midi);
+        peak = buffer.getMagnitude(0, 0, 512);
+    }
+    return peak;
+}
+
+} // namespace
+
+TEST_CASE("SnapshotHandoff: the consumer gets the newest value once", "[PresetMorpher]")
+{
+    SnapshotHandoff<int> handoff;
+    int value = 0;
+    REQUIRE_FALSE(handoff.pull(value));
+
+    handoff.push(1);
+    handoff.push(2);
+    handoff.push(3);
+    REQUIRE(handoff.pull(value));
+    REQUIRE(value == 3);
+    REQUIRE_FALSE(handoff.pull(value));
+
+    for (int i = 4; i < 100; ++i) {
+        handoff.push(i);
+        REQUIRE(handoff.pull(value));
+        REQUIRE(value == i);
+    }
+}
+
+TEST_CASE("SnapshotHandoff: values survive a concurrent producer intact", "[PresetMorpher]")
+{
+    struct Pair { int a = 0, b = 0; };
+    SnapshotHandoff<Pair> handoff;
+    std::atomic<bool> done { false };
+
+    std::thread producer([&] {
+        for (int i = 1; i <= 200000; ++i)
+            handoff.push({ i, -i });
+        done = true;
+    });
+
+    Pair p;
+    int last = 0;
+    bool torn = false, backwards = false;
+    for (;;) {
+        const bool finished = done.load();
+        if (handoff.pull(p)) {
+            torn      |= p.a != -p.b;
+            backwards |= p.a <= last;
+            last = p.a;
+        } else if (finished) {
+            break;
+        }
+    }
+    producer.join();
+    REQUIRE_FALSE(torn);
+    REQUIRE_FALSE(backwards);
+    REQUIRE(last == 200000);
+}
+
+TEST_CASE("PresetMorpher: morphTo glides continuous parameters and switches at the end", "[PresetMorpher]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    auto& morpher = proc.getMorpher();
+
+    auto target = stateWith(proc, ParamIDs::rmsWeight, 0.f);
+    target.getChildWithProperty("id", ParamIDs::pitchMode).setProperty("value", 1.f, nullptr);
+
+    morpher.morphTo(target, 1.0);
+    REQUIRE(morpher.isMorphing());
+
+    morpher.advance(0.5);   // smoothstep(0.5) = 0.5, and past a host sync
+    REQUIRE(morpher.getProgress() == Approx(0.5));
+    REQUIRE(paramValue(proc, ParamIDs::rmsWeight) == Approx(0.5f).margin(0.01f));
+    REQUIRE(paramValue(proc, ParamIDs::pitchMode) == 0.f);
+
+    morpher.advance(0.6);
+    REQUIRE_FALSE(morpher.isMorphing());
+    REQUIRE(paramValue(proc, ParamIDs::rmsWeight) == Approx(0.f).margin(0.001f));
+    REQUIRE(paramValue(proc, ParamIDs::pitchMode) == 1.f);
+}
+
+TEST_CASE("PresetMorpher: the pad blends four corners bilinearly", "[PresetMorpher]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    auto& morpher = proc.getMorpher();
+
+    std::array<juce::ValueTree, 4> corners {
+        stateWith(proc, ParamIDs::rand_, 0.0f), stateWith(proc, ParamIDs::rand_, 0.2f),
+        stateWith(proc, ParamIDs::rand_, 0.4f), stateWith(proc, ParamIDs::rand_, 1.0f),
+    };
+    morpher.setCorners(corners);
+
+    morpher.setPosition(0.5f, 0.5f);
+    morpher.advance(1.0);
+    REQUIRE(paramValue(proc, ParamIDs::rand_) == Approx(0.4f).margin(0.01f));
+
+    morpher.setPosition(1.f, 0.f);
+    morpher.stop();
+    REQUIRE_FALSE(morpher.isMorphing());
+    REQUIRE(paramValue(proc, ParamIDs::rand_) == Approx(0.2f).margin(0.01f));
+}
+
+TEST_CASE("StitcherProcessor: the audio thread follows morph snapshots, not the host parameters", "[PresetMorpher]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    setParam(proc, ParamIDs::mix, 0.f);
+    preparePlugin(proc);
+
+    const float unity = outputLevel(proc, 40);
+    REQUIRE(unity == Approx(0.1f).epsilon(0.05));
+
+    auto& morpher = proc.getMorpher();
+    morpher.morphTo(stateWith(proc, ParamIDs::gainOut, -20.f), 1.0);
+    morpher.advance(0.5);   // -10 dB halfway
+
+    // A host write to a parameter the morph owns is ignored until the morph settles
+    setParam(proc, ParamIDs::gainOut, 6.f);
+    REQUIRE(outputLevel(proc, 10) == Approx(unity * juce::Decibels::decibelsToGain(-10.f)).epsilon(0.05));
+
+    morpher.advance(0.5);
+    REQUIRE_FALSE(morpher.isMorphing());
+    REQUIRE(paramValue(proc, ParamIDs::gainOut) == Approx(-20.f).margin(0.1f));
+    REQUIRE(outputLevel(proc, 10) == Approx(unity * 0.1f).epsilon(0.05));
+
+    // Settled: the parameters drive the audio again
+    setParam(proc, ParamIDs::gainOut, 0.f);
+    REQUIRE(outputLevel(proc, 10) == Approx(unity).epsilon(0.05));
+}
+
+TEST_CASE("StitcherProcessor: a change between the settle and the next block survives it", "[PresetMorpher]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    setParam(proc, ParamIDs::mix, 0.f);
+    preparePlugin(proc);
+    const float unity = outputLevel(proc, 40);
+
+    auto& morpher = proc.getMorpher();
+    morpher.morphTo(stateWith(proc, ParamIDs::gainOut, -20.f), 1.0);
+    morpher.advance(0.5);
+    outputLevel(proc, 1);
+    morpher.advance(0.5);                      // settled snapshot queued, not yet pulled
+    setParam(proc, ParamIDs::gainOut, 0.f);   // the user grabs the knob before the block
+    REQUIRE(outputLevel(proc, 10) == Approx(unity).epsilon(0.05));
+
+    // Same for a jump that never sent an intermediate step
+    morpher.morphTo(stateWith(proc, ParamIDs::gainOut, -20.f), 1.0);
+    morpher.stop();
+    setParam(proc, ParamIDs::gainOut, -6.f);
+    REQUIRE(outputLevel(proc, 10) == Approx(unity * juce::Decibels::decibelsToGain(-6.f)).epsilon(0.05));
+}
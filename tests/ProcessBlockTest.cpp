@@ -0,0 +1,83 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Main input and sidechain from independent noise, so matching has something to do
+juce::AudioBuffer<float> makeInput(int numSamples)
+{
+    juce::AudioBuffer<float> in(4, numSamples);
+    juce::Random rng(21);
+    for (int c = 0; c < 4; ++c)
+        for (int i = 0; i < numSamples; ++i)
+            in.setSample(c, i, (rng.nextFloat() - 0.5f) * (c < 2 ? 0.6f : 0.3f));
+    return in;
+}
+
+// Runs the whole input through proc in blocks cycling through blockSizes; returns the output
+juce::AudioBuffer<float> render(StitcherProcessor& proc, const juce::AudioBuffer<float>& in,
+                                std::initializer_list<int> blockSizes)
+{
+    juce::AudioBuffer<float> out(2, in.getNumSamples());
+    juce::MidiBuffer midi;
+    std::vector<int> sizes(blockSizes);
+    size_t next = 0;
+    for (int pos = 0; pos < in.getNumSamples();) {
+        const int n = juce::jmin(sizes[next++ % sizes.size()], in.getNumSamples() - pos);
+        juce::AudioBuffer<float> block(4, n);
+        for (int c = 0; c < 4; ++c)
+            block.copyFrom(c, 0, in, c, pos, n);
+        proc.processBlock(block, midi);
+        for (int c = 0; c < 2; ++c)
+            out.copyFrom(c, pos, block, c, 0, n);
+        pos += n;
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("StitcherProcessor: output does not depend on the host block size", "[ProcessBlock]")
+{
+    JuceInit init;
+    const auto input = makeInput(44100);
+
+    StitcherProcessor a, b;
+    preparePlugin(a);
+    preparePlugin(b);
+    const auto outA = render(a, input, { 512 });
+    const auto outB = render(b, input, { 64, 1, 333, 512, 17 });   // segments split everywhere
+
+    REQUIRE(outA.getMagnitude(0, 0, 44100) > 0.f);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 44100; ++i)
+            REQUIRE(outB.getSample(c, i) == Catch::Approx(outA.getSample(c, i)).margin(1e-6));
+}
+
+TEST_CASE("StitcherProcessor benchmark: processBlock at typical host buffer sizes", "[.benchmark]")
+{
+    JuceInit init;
+    for (int blockSize : { 64, 512 }) {
+        StitcherProcessor proc;
+        preparePlugin(proc, 44100.0, blockSize);
+        auto input = makeInput(blockSize);
+        juce::AudioBuffer<float> buffer(4, blockSize);
+        juce::MidiBuffer midi;
+        for (int i = 0; i < 200; ++i) {   // fill the corpus
+            buffer.makeCopyOf(input, true);
+            proc.processBlock(buffer, midi);
+        }
+
+        BENCHMARK("processBlock, " + std::to_string(blockSize) + " samples") {
+            buffer.makeCopyOf(input, true);
+            proc.processBlock(buffer, midi);
+            return buffer.getSample(0, 0);
+        };
+    }
+}
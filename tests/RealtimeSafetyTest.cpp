@@ -0,0 +1,184 @@
+#include "catch2/catch_test_macros.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include "RealtimeGuard.h"
+#include <string>
+#include <vector>
+
+// The call interposers (RealtimeGuardHooks.cpp) exist on Linux/glibc only; elsewhere the
+// guard still compiles but cannot observe anything, so these tests are skipped.
+#if defined(__linux__) && defined(__GLIBC__)
+ #define STITCHER_RT_HOOKS 1
+#else
+ #define STITCHER_RT_HOOKS 0
+#endif
+
+namespace {
+
+std::string describeViolations()
+{
+    std::string s;
+    RealtimeGuard::Violation v;
+    for (int i = 0; RealtimeGuard::getViolation(i, v); ++i)
+        s += RealtimeGuard::describe(v);
+    return s;
+}
+
+void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& rng, float level)
+{
+    for (int c = 0; c < buffer.getNumChannels(); ++c) {
+        float* d = buffer.getWritePointer(c);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            d[i] = (rng.nextFloat() * 2.f - 1.f) * level;
+    }
+}
+
+// Host automation arrives on the audio thread. JUCE's broadcast takes the parameter's own
+// (uncontended) listener lock, so it runs suspended; the processor's listener, which is
+// ours, then runs again under the guard with the same value.
+void applyAutomation(StitcherProcessor& proc, juce::RangedAudioParameter& param, float normalised)
+{
+    const RealtimeGuard guard;
+    {
+        const RealtimeGuard::ScopedSuspend suspend;
+        param.setValueNotifyingHost(normalised);
+    }
+    proc.parameterChanged(param.getParameterID(), param.convertFrom0to1(normalised));
+}
+
+} // namespace
+
+TEST_CASE("RealtimeGuard: flags allocation and locking inside a guarded scope", "[RealtimeGuard]")
+{
+#if ! STITCHER_RT_HOOKS
+    SKIP("call interposers are only available on Linux/glibc");
+#endif
+    RealtimeGuard::clearViolations();
+    volatile int n = 64;
+    {
+        const RealtimeGuard guard;
+        std::vector<float> v(static_cast<size_t>(n), 1.f);   // malloc + free
+        juce::CriticalSection cs;
+        const juce::ScopedLock sl(cs);                        // pthread_mutex_lock
+        n = static_cast<int>(v[0]);
+    }
+    REQUIRE(RealtimeGuard::getNumViolations() >= 3);
+
+    RealtimeGuard::Violation v;
+    REQUIRE(RealtimeGuard::getViolation(0, v));
+    REQUIRE(v.kind == RealtimeGuard::Kind::Allocation);
+    REQUIRE(v.numFrames > 0);
+    RealtimeGuard::clearViolations();
+}
+
+TEST_CASE("RealtimeGuard: calls outside a guard or under ScopedSuspend are not flagged", "[RealtimeGuard]")
+{
+    RealtimeGuard::clearViolations();
+    std::vector<float> outside(128);
+    {
+        const RealtimeGuard guard;
+        const RealtimeGuard::ScopedSuspend suspend;
+        std::vector<float> allowed(128);
+    }
+    REQUIRE(RealtimeGuard::getNumViolations() == 0);
+}
+
+TEST_CASE("StitcherProcessor: processBlock is real-time safe across parameter sweeps", "[RealtimeGuard]")
+{
+#if ! STITCHER_RT_HOOKS
+    SKIP("call interposers are only available on Linux/glibc");
+#endif
+    JuceInit init;
+    constexpr double kSampleRate = 44100.0;
+    constexpr int    kMaxBlock   = 512;
+
+    StitcherProcessor proc;
+    preparePlugin(proc, kSampleRate, kMaxBlock);
+
+    juce::AudioBuffer<float> buffer(4, kMaxBlock);
+    juce::MidiBuffer midi;
+    juce::Random rng(42);
+
+    auto runBlocks = [&](int numBlocks, int blockSize) {
+        for (int b = 0; b < numBlocks; ++b) {
+            buffer.setSize(4, blockSize, false, false, true);
+            fillNoise(buffer, rng, 0.5f);
+            proc.processBlock(buffer, midi);
+        }
+    };
+
+    // Fill the corpus so matching, the rand candidate list and every effect are live.
+    runBlocks(200, kMaxBlock);
+    RealtimeGuard::clearViolations();
+
+    const int blockSizes[] = { kMaxBlock, 64, 1, 333 };
+    const float sweep[]    = { 0.f, 0.25f, 0.5f, 0.75f, 1.f, 0.5f };
+
+    for (auto* p : proc.getParameters()) {
+        auto* param = dynamic_cast<juce::RangedAudioParameter*>(p);
+        if (param == nullptr) continue;
+        const float original = param->getValue();
+
+        for (float v : sweep) {
+            applyAutomation(proc, *param, v);
+            for (int bs : blockSizes)
+                runBlocks(2, bs);
+        }
+        param->setValueNotifyingHost(original);
+
+        INFO("parameter: " << param->getParameterID());
+        INFO(describeViolations());
+        REQUIRE(RealtimeGuard::getNumViolations() == 0);
+    }
+}
+
+TEST_CASE("StitcherProcessor: MIDI-learned CCs are real-time safe", "[RealtimeGuard]")
+{
+#if ! STITCHER_RT_HOOKS
+    SKIP("call interposers are only available on Linux/glibc");
+#endif
+    JuceInit init;
+    constexpr double kSampleRate = 44100.0;
+    constexpr int    kBlock      = 256;
+
+    StitcherProcessor proc;
+    preparePlugin(proc, kSampleRate, kBlock);
+
+    // A gain, a filter, a matcher weight, the pitch path and a switch
+    auto& ml = proc.getMidiLearn();
+    const char* ids[] = { ParamIDs::gainOut, ParamIDs::eqLow, ParamIDs::rmsWeight,
+                          ParamIDs::pitchShift, ParamIDs::freeze };
+    int cc = 20;
+    for (auto* id : ids) {
+        ml.startLearning(proc.getAPVTS().getParameter(id));
+        ml.handleCC(cc++, 0);
+        REQUIRE(ml.processCapture());
+    }
+
+    juce::AudioBuffer<float> buffer(4, kBlock);
+    juce::Random rng(7);
+    for (int b = 0; b < 200; ++b) {
+        juce::MidiBuffer none;
+        fillNoise(buffer, rng, 0.5f);
+        proc.processBlock(buffer, none);
+    }
+    RealtimeGuard::clearViolations();
+
+    // A dense controller stream: every bound CC, every few samples, for many blocks
+    juce::MidiBuffer midi;
+    for (int pos = 0; pos < kBlock; pos += 4)
+        for (int c = 20; c < cc; ++c)
+            midi.addEvent(juce::MidiMessage::controllerEvent(1, c, (pos + c * 13) % 128), pos);
+
+    for (int b = 0; b < 50; ++b) {
+        fillNoise(buffer, rng, 0.5f);
+        proc.processBlock(buffer, midi);
+        if (b % 10 == 5)
+            ml.dispatchPending();   // the message thread catching up now and then
+    }
+
+    INFO(describeViolations());
+    REQUIRE(RealtimeGuard::getNumViolations() == 0);
+    REQUIRE(ml.dispatchPending() == cc - 20);
+}
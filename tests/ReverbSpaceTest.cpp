@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include "ReverbProcessor.h"
+#include <algorithm>
+#include <cmath>
 
 TEST_CASE("setSpace(0) maps to small room with high damping") {
     // space=0 → roomSize=0.20, damping=0.90
@@ -62,3 +65,244 @@ TEST_CASE("setSpace produces audibly different reverb tails") {
     const float largeDecay = measureDecayEnergy(1.f);
     REQUIRE(largeDecay > smallDecay);
 }
+
+TEST_CASE("Larger space gives a longer decay time") {
+    ReverbProcessor rev;
+    rev.prepare({ 44100.0, 512, 2 });
+    rev.setSpace(0.f, 1.f);
+    const float small = rev.getDecaySeconds();
+    rev.setSpace(1.f, 1.f);
+    REQUIRE(rev.getDecaySeconds() > small * 4.f);
+}
+
+TEST_CASE("Wet = 0 fades the tail out, then passes the dry signal untouched") {
+    ReverbProcessor rev;
+    rev.prepare({ 44100.0, 512, 2 });
+    rev.setSpace(1.f, 1.f);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::Random rng(3);
+    auto fill = [&] {
+        for (int c = 0; c < 2; ++c)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample(c, i, rng.nextFloat() - 0.5f);
+    };
+    juce::dsp::AudioBlock<float> block(buffer);
+    for (int b = 0; b < 20; ++b) {
+        fill();
+        rev.process(block);
+    }
+    REQUIRE_FALSE(rev.isBypassed());
+
+    // Silence in: the tail is still ringing when wet drops to zero
+    rev.setSpace(1.f, 0.f);
+    buffer.clear();
+    rev.process(block);
+    REQUIRE(std::abs(buffer.getSample(0, 0)) > 0.f);   // faded, not cut at the block edge
+
+    for (int b = 0; b < 10; ++b) {
+        buffer.clear();
+        rev.process(block);
+    }
+    REQUIRE(rev.isBypassed());
+
+    fill();
+    juce::AudioBuffer<float> dry;
+    dry.makeCopyOf(buffer);
+    rev.process(block);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 512; ++i)
+            REQUIRE(buffer.getSample(c, i) == dry.getSample(c, i));
+}
+
+TEST_CASE("Tail decays to silence at the largest space") {
+    ReverbProcessor rev;
+    rev.prepare({ 44100.0, 512, 2 });
+    rev.setSpace(1.f, 1.f);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::dsp::AudioBlock<float> block(buffer);
+    buffer.clear();
+    buffer.setSample(0, 0, 1.f);
+    rev.process(block);
+
+    float peak = 0.f;
+    for (int b = 0; b < 600; ++b) {   // ~7 s, past the 4.2 s RT60
+        buffer.clear();
+        rev.process(block);
+        peak = b < 10 ? std::max(peak, buffer.getMagnitude(0, 512)) : peak;
+    }
+    REQUIRE(peak < 1.f);
+    REQUIRE(buffer.getMagnitude(0, 512) < 1e-3f);
+}
+
+namespace {
+// Writes a stereo 16-bit WAV impulse response to a temp file.
+juce::File writeImpulseResponse(const juce::String& name, const juce::AudioBuffer<float>& ir, double sampleRate)
+{
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    file.deleteFile();
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(new juce::FileOutputStream(file), sampleRate,
+                            static_cast<unsigned>(ir.getNumChannels()), 16, {}, 0));
+    writer->writeFromAudioSampleBuffer(ir, 0, ir.getNumSamples());
+    return file;
+}
+} // namespace
+
+TEST_CASE("Convolution mode delays an impulse by the loaded IR") {
+    constexpr int kDelay = 300;
+    juce::AudioBuffer<float> ir(2, 1024);
+    ir.clear();
+    ir.setSample(0, kDelay, 0.5f);
+    ir.setSample(1, kDelay, 0.5f);
+    const auto file = writeImpulseResponse("stitcher_test_ir.wav", ir, 44100.0);
+
+    ReverbProcessor rev;
+    rev.prepare({ 44100.0, 512, 2 });
+    rev.setSpace(0.5f, 1.f);
+    rev.setMode(ReverbProcessor::Mode::Convolution);
+    REQUIRE_FALSE(rev.loadImpulseResponse(file.getSiblingFile("missing.wav")));
+    REQUIRE(rev.loadImpulseResponse(file));
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::dsp::AudioBlock<float> block(buffer);
+    // Give the background loader time, and let the engine swap and wet fade-in finish
+    for (int b = 0; b < 100; ++b) {
+        buffer.clear();
+        rev.process(block);
+        juce::Thread::sleep(5);
+    }
+    REQUIRE(rev.getMode() == ReverbProcessor::Mode::Convolution);
+
+    buffer.clear();
+    buffer.setSample(0, 0, 1.f);
+    buffer.setSample(1, 0, 1.f);
+    rev.process(block);
+
+    int peakAt = 0;
+    for (int i = 1; i < 512; ++i)
+        if (std::abs(buffer.getSample(0, i)) > std::abs(buffer.getSample(0, peakAt)))
+            peakAt = i;
+    REQUIRE(peakAt == kDelay);   // wet = 1: the dry impulse at 0 is gone
+    file.deleteFile();
+}
+
+TEST_CASE("Convolution IR counts as loaded only once the engine runs it") {
+    juce::AudioBuffer<float> ir(2, 256);
+    ir.clear();
+    ir.setSample(0, 100, 0.5f);
+    ir.setSample(1, 100, 0.5f);
+    const auto file = writeImpulseResponse("stitcher_test_ir_ready.wav", ir, 44100.0);
+
+    ReverbProcessor rev;
+    rev.prepare({ 44100.0, 512, 2 });
+    rev.setSpace(0.5f, 1.f);
+    rev.setMode(ReverbProcessor::Mode::Convolution);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto runUntilLoaded = [&] {
+        for (int b = 0; b < 400 && !rev.hasImpulseResponse(); ++b) {
+            buffer.clear();
+            rev.process(block);
+            juce::Thread::sleep(5);
+        }
+        return rev.hasImpulseResponse();
+    };
+
+    REQUIRE(rev.loadImpulseResponse(file));
+    juce::Thread::sleep(200);                 // the background load has long finished...
+    REQUIRE_FALSE(rev.hasImpulseResponse());  // ...but the engine swaps only in process()
+    REQUIRE(runUntilLoaded());
+
+    // Reloading the same file after a clear is still seen, though the IR size is unchanged
+    rev.clearImpulseResponse();
+    REQUIRE_FALSE(rev.hasImpulseResponse());
+    for (int b = 0; b < 40; ++b) {
+        buffer.clear();
+        rev.process(block);
+        juce::Thread::sleep(5);
+    }
+    REQUIRE(rev.loadImpulseResponse(file));
+    REQUIRE(runUntilLoaded());
+    file.deleteFile();
+}
+
+TEST_CASE("FDN reverb vs juce::dsp::Reverb", "[.benchmark]") {
+    constexpr int kBlock = 512;
+    const juce::dsp::ProcessSpec spec { 48000.0, kBlock, 2 };
+
+    juce::AudioBuffer<float> noise(2, kBlock), buffer(2, kBlock);
+    juce::Random rng(5);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < kBlock; ++i)
+            noise.setSample(c, i, rng.nextFloat() - 0.5f);
+
+    juce::dsp::Reverb freeverb;
+    freeverb.prepare(spec);
+    juce::dsp::Reverb::Parameters p;
+    p.roomSize = 0.575f;
+    p.damping  = 0.55f;
+    p.wetLevel = 0.5f;
+    p.dryLevel = 0.5f;
+    freeverb.setParameters(p);
+
+    ReverbProcessor fdn;
+    fdn.prepare(spec);
+    fdn.setSpace(0.5f, 0.5f);
+
+    BENCHMARK("juce::dsp::Reverb, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> ctx(block);
+        freeverb.process(ctx);
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    BENCHMARK("FDN, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        fdn.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    // 3 s exponentially decaying noise IR
+    const int irLen = static_cast<int>(3.0 * spec.sampleRate);
+    juce::AudioBuffer<float> ir(2, irLen);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < irLen; ++i)
+            ir.setSample(c, i, (rng.nextFloat() - 0.5f) * std::exp(-6.9f * static_cast<float>(i) / static_cast<float>(irLen)));
+    const auto irFile = writeImpulseResponse("stitcher_bench_ir.wav", ir, spec.sampleRate);
+
+    ReverbProcessor conv;
+    conv.prepare(spec);
+    conv.setSpace(0.5f, 0.5f);
+    conv.setMode(ReverbProcessor::Mode::Convolution);
+    conv.loadImpulseResponse(irFile);
+    for (int b = 0; b < 200; ++b) {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        conv.process(block);
+        juce::Thread::sleep(2);
+    }
+
+    BENCHMARK("convolution, 3 s IR, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        conv.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+    irFile.deleteFile();
+
+    ReverbProcessor dryFdn;
+    dryFdn.prepare(spec);
+    dryFdn.setSpace(0.5f, 0.f);
+    BENCHMARK("FDN at wet = 0, stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        dryFdn.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+}
@@ -0,0 +1,181 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "TestHelpers.h"
+#include "StageProfiler.h"
+
+using Catch::Approx;
+
+namespace {
+
+double ticksForUs(double us) { return us * StageProfiler::getTicksPerSecond() / 1.0e6; }
+
+} // namespace
+
+TEST_CASE("StageProfiler: histogram bins are contiguous and about 19 % wide", "[StageProfiler]")
+{
+    for (uint64_t t = 0; t < 4; ++t)
+        REQUIRE(StageProfiler::binForTicks(t) == static_cast<int>(t));
+
+    for (int b = 0; b < StageProfiler::kNumBins - 2; ++b) {
+        const uint64_t upper = StageProfiler::binUpperTicks(b);
+        REQUIRE(StageProfiler::binForTicks(upper - 1) == b);
+        REQUIRE(StageProfiler::binForTicks(upper) == b + 1);
+        if (b >= 8)
+            REQUIRE(static_cast<double>(StageProfiler::binUpperTicks(b + 1)) / static_cast<double>(upper) < 1.26);
+    }
+    REQUIRE(StageProfiler::binForTicks(~uint64_t { 0 }) == StageProfiler::kNumBins - 1);
+}
+
+TEST_CASE("StageProfiler: mean, p99 and max per stage", "[StageProfiler]")
+{
+    StageProfiler prof;
+    prof.prepare(48000.0);
+    prof.beginBlock();   // applies the reset requested by prepare()
+
+    // 990 calls at 10 us and 10 at 100 us: p99 sits in the 10 us bin, max is the outlier
+    const auto fast = static_cast<uint64_t>(ticksForUs(10.0));
+    const auto slow = static_cast<uint64_t>(ticksForUs(100.0));
+    for (int i = 0; i < 990; ++i) prof.record(StageProfiler::Match, 1, fast);
+    for (int i = 0; i < 10; ++i)  prof.record(StageProfiler::Match, 1, slow);
+
+    const auto s  = prof.getStats();
+    const auto& m = s.stages[StageProfiler::Match];
+    REQUIRE(m.count == 1000);
+    REQUIRE(m.meanUs == Approx(10.9).epsilon(0.01));
+    REQUIRE(m.maxUs == Approx(100.0).epsilon(0.01));
+    REQUIRE(m.p99Us >= 10.0 * 0.99);
+    REQUIRE(m.p99Us <= 10.0 * 1.25);   // bins are at most 25 % wide
+
+    REQUIRE(s.stages[StageProfiler::Reverb].count == 0);
+    REQUIRE(s.blocks == 0);
+}
+
+TEST_CASE("StageProfiler: block load is measured against the block deadline", "[StageProfiler]")
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int    kBlock      = 480;   // 10 ms deadline
+    StageProfiler prof;
+    prof.prepare(kSampleRate);
+    prof.beginBlock();
+
+    for (int i = 0; i < 98; ++i) prof.recordLoad(static_cast<uint64_t>(ticksForUs(2500.0)), kBlock);   // 25 %
+    prof.recordLoad(static_cast<uint64_t>(ticksForUs(12000.0)), kBlock);                               // 120 %
+    prof.recordLoad(static_cast<uint64_t>(ticksForUs(50000.0)), kBlock);                               // 500 %
+
+    const auto s = prof.getStats();
+    REQUIRE(s.blocks == 100);
+    REQUIRE(s.overruns == 2);
+    REQUIRE(s.maxLoad == Approx(5.0).epsilon(0.01));
+    REQUIRE(s.p99Load >= 1.2);
+    REQUIRE(s.p99Load <= 1.22);
+    REQUIRE(s.meanLoad > 0.25);
+    REQUIRE(s.meanLoad < 0.35);   // the overflow bin caps the 500 % block at 400 %
+}
+
+TEST_CASE("StageProfiler: reset is applied at the start of the next block", "[StageProfiler]")
+{
+    StageProfiler prof;
+    prof.prepare(44100.0);
+    prof.beginBlock();
+    prof.record(StageProfiler::Eq, 1, 1000);
+    prof.recordLoad(1000, 64);
+
+    prof.reset();
+    REQUIRE(prof.getStats().stages[StageProfiler::Eq].count == 1);   // not yet
+
+    prof.beginBlock();
+    const auto s = prof.getStats();
+    REQUIRE(s.stages[StageProfiler::Eq].count == 0);
+    REQUIRE(s.blocks == 0);
+    REQUIRE(s.maxLoad == 0.0);
+}
+
+TEST_CASE("StageProfiler: disabled profiler records nothing", "[StageProfiler]")
+{
+    StageProfiler prof;
+    prof.prepare(44100.0);
+    prof.setEnabled(false);
+    const auto start = prof.beginBlock();
+    REQUIRE(start == 0);
+    { StageProfiler::Scope scope(prof, StageProfiler::Blend); }
+    prof.endBlock(start, 512);
+
+    const auto s = prof.getStats();
+    REQUIRE(s.stages[StageProfiler::Blend].count == 0);
+    REQUIRE(s.stages[StageProfiler::Block].count == 0);
+    REQUIRE(prof.getRecentEvents().empty());
+}
+
+TEST_CASE("StageProfiler: trace ring keeps the newest events in order", "[StageProfiler]")
+{
+    StageProfiler prof;
+    const int total = StageProfiler::kTraceCapacity + 100;
+    for (int i = 0; i < total; ++i)
+        prof.record(StageProfiler::Grain, static_cast<uint64_t>(1000 + i), 7);
+
+    const auto events = prof.getRecentEvents();
+    REQUIRE(static_cast<int>(events.size()) <= StageProfiler::kTraceCapacity);
+    REQUIRE(static_cast<int>(events.size()) >= StageProfiler::kTraceCapacity - 1);
+    REQUIRE(events.back().startTicks == static_cast<uint64_t>(1000 + total - 1));
+    for (size_t i = 1; i < events.size(); ++i)
+        REQUIRE(events[i].startTicks == events[i - 1].startTicks + 1);
+    REQUIRE(events.front().stage == StageProfiler::Grain);
+    REQUIRE(events.front().durationTicks == 7);
+}
+
+TEST_CASE("StageProfiler: JSON and Chrome trace exports parse", "[StageProfiler]")
+{
+    StageProfiler prof;
+    prof.prepare(44100.0);
+    prof.beginBlock();
+    prof.record(StageProfiler::Input, 100, 50);
+    prof.record(StageProfiler::Limiter, 200, 80);
+    prof.recordLoad(400, 512);
+
+    const auto stats = juce::JSON::parse(prof.toJson());
+    REQUIRE(stats.isObject());
+    REQUIRE(static_cast<double>(stats["sampleRate"]) == 44100.0);
+    const auto* stages = stats["stages"].getArray();
+    REQUIRE(stages != nullptr);
+    REQUIRE(stages->size() == StageProfiler::kNumStages);
+    REQUIRE((*stages)[StageProfiler::Input]["name"].toString() == "Input");
+    REQUIRE(static_cast<int>((*stages)[StageProfiler::Input]["count"]) == 1);
+    REQUIRE(static_cast<int>(stats["load"]["blocks"]) == 1);
+
+    const auto trace = juce::JSON::parse(prof.toChromeTrace());
+    const auto* events = trace["traceEvents"].getArray();
+    REQUIRE(events != nullptr);
+    REQUIRE(events->size() == 2);
+    REQUIRE((*events)[0]["name"].toString() == "Input");
+    REQUIRE((*events)[0]["ph"].toString() == "X");
+    REQUIRE(static_cast<double>((*events)[0]["ts"]) == 0.0);
+    REQUIRE(static_cast<double>((*events)[1]["ts"]) > 0.0);
+}
+
+TEST_CASE("StitcherProcessor: processBlock feeds the stage profiler", "[StageProfiler]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    preparePlugin(proc);
+
+    juce::AudioBuffer<float> buffer(4, 512);
+    juce::MidiBuffer midi;
+    juce::Random rng(7);
+    for (int b = 0; b < 100; ++b) {
+        for (int c = 0; c < 4; ++c)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample(c, i, (rng.nextFloat() * 2.f - 1.f) * 0.5f);
+        proc.processBlock(buffer, midi);
+    }
+
+    const auto s = proc.getProfiler().getStats();
+    REQUIRE(s.blocks == 100);
+    REQUIRE(s.stages[StageProfiler::Block].count == 100);
+    REQUIRE(s.stages[StageProfiler::Input].count == 100);
+    REQUIRE(s.stages[StageProfiler::Features].count > 0);
+    REQUIRE(s.stages[StageProfiler::Match].count > 0);
+    REQUIRE(s.stages[StageProfiler::Limiter].count > 0);
+    REQUIRE(s.stages[StageProfiler::Block].maxUs >= s.stages[StageProfiler::Input].maxUs);
+}
@@ -0,0 +1,164 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "Parameters.h"
+#include "TestHelpers.h"
+#include <memory>
+
+using Catch::Approx;
+
+namespace {
+
+// A processor with a few non-default parameters and one MIDI binding
+void customise(StitcherProcessor& proc)
+{
+    auto& apvts = proc.getAPVTS();
+    apvts.getParameter(ParamIDs::rmsWeight)->setValueNotifyingHost(0.25f);
+    apvts.getParameter(ParamIDs::rand_)->setValueNotifyingHost(0.75f);
+
+    auto& ml = proc.getMidiLearn();
+    ml.startLearning(apvts.getParameter(ParamIDs::rmsWeight));
+    ml.handleCC(21, 0);
+    ml.processCapture();
+}
+
+// The pre-binary session format: APVTS state + MIDI_LEARN child, via copyXmlToBinary
+juce::MemoryBlock legacyState(StitcherProcessor& proc)
+{
+    auto xml = proc.getAPVTS().copyState().createXml();
+    xml->addChildElement(proc.getMidiLearn().createBindingsXml());
+    juce::MemoryBlock mb;
+    juce::AudioProcessor::copyXmlToBinary(*xml, mb);
+    return mb;
+}
+
+// A one-tap stereo IR in the temp directory
+juce::File writeImpulseResponse(const juce::String& name)
+{
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    file.deleteFile();
+    juce::AudioBuffer<float> ir(2, 256);
+    ir.clear();
+    ir.setSample(0, 0, 0.5f);
+    ir.setSample(1, 0, 0.5f);
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(new juce::FileOutputStream(file), 44100.0, 2, 16, {}, 0));
+    writer->writeFromAudioSampleBuffer(ir, 0, ir.getNumSamples());
+    return file;
+}
+
+} // namespace
+
+TEST_CASE("State: binary round trip restores parameters and MIDI bindings", "[State]")
+{
+    JuceInit init;
+    StitcherProcessor src;
+    customise(src);
+
+    juce::MemoryBlock state;
+    src.getStateInformation(state);
+    REQUIRE(state.getSize() > 8);
+    REQUIRE(juce::ByteOrder::littleEndianInt(state.getData()) == 0x42435453u);   // "STCB"
+
+    StitcherProcessor dst;
+    dst.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    REQUIRE(paramValue(dst, ParamIDs::rmsWeight) == Approx(paramValue(src, ParamIDs::rmsWeight)));
+    REQUIRE(paramValue(dst, ParamIDs::rand_)     == Approx(paramValue(src, ParamIDs::rand_)));
+    REQUIRE(dst.getMidiLearn().getCCForParam(dst.getAPVTS().getParameter(ParamIDs::rmsWeight)) == 21);
+}
+
+TEST_CASE("State: sessions saved as XML still load", "[State]")
+{
+    JuceInit init;
+    StitcherProcessor src;
+    customise(src);
+    const auto state = legacyState(src);
+
+    StitcherProcessor dst;
+    dst.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    REQUIRE(paramValue(dst, ParamIDs::rmsWeight) == Approx(paramValue(src, ParamIDs::rmsWeight)));
+    REQUIRE(dst.getMidiLearn().getCCForParam(dst.getAPVTS().getParameter(ParamIDs::rmsWeight)) == 21);
+}
+
+TEST_CASE("State: repeated save and load does not duplicate the MIDI bindings", "[State]")
+{
+    JuceInit init;
+    StitcherProcessor proc;
+    customise(proc);
+
+    juce::MemoryBlock state;
+    for (int i = 0; i < 3; ++i) {
+        proc.getStateInformation(state);
+        proc.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    }
+    proc.getStateInformation(state);
+
+    const auto tree = juce::ValueTree::readFromData(static_cast<const char*>(state.getData()) + 8,
+                                                    state.getSize() - 8);
+    int numBindingTrees = 0;
+    for (const auto& child : tree)
+        numBindingTrees += child.hasType("MIDI_LEARN") ? 1 : 0;
+    REQUIRE(numBindingTrees == 1);
+}
+
+TEST_CASE("State: the IR survives preset loads and is saved with the session", "[State]")
+{
+    JuceInit init;
+    const auto ir = writeImpulseResponse("stitcher_state_ir.wav");
+    StitcherProcessor src;
+    REQUIRE(src.loadImpulseResponse(ir));
+
+    // A preset load replaces the whole parameter tree
+    StitcherProcessor other;
+    src.getAPVTS().replaceState(other.getAPVTS().copyState());
+    REQUIRE(src.getImpulseResponseFile() == ir);
+
+    juce::MemoryBlock state;
+    src.getStateInformation(state);
+    StitcherProcessor dst;
+    dst.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    REQUIRE(dst.getImpulseResponseFile() == ir);
+    REQUIRE_FALSE(dst.getAPVTS().state.hasProperty("irPath"));
+
+    // Sessions from before the SESSION child kept the path on the root
+    auto legacy = other.getAPVTS().copyState();
+    legacy.setProperty("irPath", ir.getFullPathName(), nullptr);
+    std::unique_ptr<juce::XmlElement> xml(legacy.createXml());
+    juce::MemoryBlock legacyBlob;
+    juce::AudioProcessor::copyXmlToBinary(*xml, legacyBlob);
+    StitcherProcessor old;
+    old.setStateInformation(legacyBlob.getData(), static_cast<int>(legacyBlob.getSize()));
+    REQUIRE(old.getImpulseResponseFile() == ir);
+
+    dst.clearImpulseResponse();
+    dst.getStateInformation(state);
+    StitcherProcessor cleared;
+    cleared.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    REQUIRE(cleared.getImpulseResponseFile() == juce::File());
+    ir.deleteFile();
+}
+
+TEST_CASE("State: unknown versions and garbage are ignored", "[State]")
+{
+    JuceInit init;
+    StitcherProcessor src;
+    customise(src);
+    juce::MemoryBlock state;
+    src.getStateInformation(state);
+
+    StitcherProcessor dst;
+    const float before = paramValue(dst, ParamIDs::rmsWeight);
+
+    auto newer = state;
+    const juce::uint32 futureVersion = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(99));
+    newer.copyFrom(&futureVersion, 4, 4);
+    dst.setStateInformation(newer.getData(), static_cast<int>(newer.getSize()));
+    REQUIRE(paramValue(dst, ParamIDs::rmsWeight) == before);
+
+    const char garbage[] = "not a plugin state";
+    dst.setStateInformation(garbage, static_cast<int>(sizeof(garbage)));
+    dst.setStateInformation(state.getData(), 6);   // truncated header
+    REQUIRE(paramValue(dst, ParamIDs::rmsWeight) == before);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// Brings up the JUCE message manager for the lifetime of a test case.
+struct JuceInit {
+    JuceInit()  { juce::initialiseJuce_GUI(); }
+    ~JuceInit() { juce::shutdownJuce_GUI(); }
+};
+
+// Gives the processor the bus layout a host would (main + sidechain in, stereo out)
+// and prepares it, the way every plug-in level test starts.
+inline void preparePlugin(StitcherProcessor& proc, double sampleRate = 44100.0, int maxBlock = 512)
+{
+    proc.setPlayConfigDetails(4, 2, sampleRate, maxBlock);
+    proc.prepareToPlay(sampleRate, maxBlock);
+}
+
+// Host-style parameter write and read, in the parameter's own units.
+inline void setParam(StitcherProcessor& proc, const char* id, float plainValue)
+{
+    auto* p = proc.getAPVTS().getParameter(id);
+    p->setValueNotifyingHost(p->convertTo0to1(plainValue));
+}
+
+inline float paramValue(StitcherProcessor& proc, const char* id)
+{
+    return proc.getAPVTS().getRawParameterValue(id)->load();
+}
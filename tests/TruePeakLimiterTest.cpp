@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "TruePeakLimiter.h"
+#include <cmath>
+
+namespace {
+
+constexpr double kSampleRate = 44100.0;
+constexpr int    kBlock      = 512;
+
+void processInBlocks(TruePeakLimiter& limiter, juce::AudioBuffer<float>& buffer)
+{
+    for (int pos = 0; pos < buffer.getNumSamples(); pos += kBlock) {
+        juce::dsp::AudioBlock<float> block(buffer);
+        auto sub = block.getSubBlock(static_cast<size_t>(pos),
+                                     static_cast<size_t>(juce::jmin(kBlock, buffer.getNumSamples() - pos)));
+        limiter.process(sub);
+    }
+}
+
+TruePeakLimiter makeLimiter(int numChannels)
+{
+    TruePeakLimiter limiter;
+    limiter.setLookaheadMs(1.5);
+    limiter.prepare({ kSampleRate, static_cast<juce::uint32>(kBlock), static_cast<juce::uint32>(numChannels) });
+    limiter.setCeilingDb(-1.f);
+    limiter.setReleaseMs(50.f);
+    return limiter;
+}
+
+} // namespace
+
+TEST_CASE("TruePeakLimiter: catches inter-sample peaks that sample peaks miss") {
+    // fs/4 at 45° phase: every sample sits at 0.707 of the true peak
+    juce::AudioBuffer<float> buffer(2, 44100);
+    for (int i = 0; i < buffer.getNumSamples(); ++i) {
+        const double ph = juce::MathConstants<double>::halfPi * i + juce::MathConstants<double>::pi / 4.0;
+        buffer.setSample(0, i, 1.2f * static_cast<float>(std::sin(ph)));
+        buffer.setSample(1, i, 0.f);
+    }
+    REQUIRE(buffer.getMagnitude(0, 0, 44100) < 0.891f);                                  // no sample over
+    REQUIRE(TruePeakLimiter::measureTruePeak(buffer.getReadPointer(0), 44100) > 1.1f);   // but a true-peak over
+
+    auto limiter = makeLimiter(2);
+    processInBlocks(limiter, buffer);
+
+    const float ceiling = juce::Decibels::decibelsToGain(-1.f);
+    REQUIRE(TruePeakLimiter::measureTruePeak(buffer.getReadPointer(0) + 2048, 44100 - 2048)
+            <= ceiling * 1.001f);
+}
+
+TEST_CASE("TruePeakLimiter: signals under the ceiling only pick up the latency") {
+    juce::AudioBuffer<float> buffer(2, 4096), ref(2, 4096);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 4096; ++i)
+            buffer.setSample(c, i, 0.5f * static_cast<float>(std::sin(0.01 * i * (c + 1))));
+    ref.makeCopyOf(buffer);
+
+    auto limiter = makeLimiter(2);
+    processInBlocks(limiter, buffer);
+
+    const int latency = limiter.getLatencySamples();
+    REQUIRE(latency == juce::roundToInt(0.0015 * kSampleRate) + TruePeakLimiter::kFilterDelay);
+    for (int c = 0; c < 2; ++c)
+        for (int i = latency; i < 4096; ++i)
+            REQUIRE(buffer.getSample(c, i) == ref.getSample(c, i - latency));
+    REQUIRE(limiter.getAndResetMinGain() == 1.f);
+}
+
+TEST_CASE("TruePeakLimiter: a transient after silence is caught by the lookahead") {
+    juce::AudioBuffer<float> buffer(2, 22050);
+    buffer.clear();
+    juce::Random rng(11);
+    for (int i = 10000; i < 22050; ++i) {
+        const float s = 3.f * (rng.nextFloat() * 2.f - 1.f);
+        buffer.setSample(0, i, s);
+        buffer.setSample(1, i, -0.5f * s);
+    }
+
+    auto limiter = makeLimiter(2);
+    processInBlocks(limiter, buffer);
+
+    const float ceiling = juce::Decibels::decibelsToGain(-1.f);
+    for (int c = 0; c < 2; ++c)
+        REQUIRE(TruePeakLimiter::measureTruePeak(buffer.getReadPointer(c), 22050) <= ceiling * 1.002f);
+    REQUIRE(limiter.getAndResetMinGain() < 0.4f);
+}
+
+TEST_CASE("TruePeakLimiter: gain recovers at the release rate") {
+    juce::AudioBuffer<float> buffer(1, 44100);
+    for (int i = 0; i < 44100; ++i)
+        buffer.setSample(0, i, i < 4410 ? 2.f : 0.1f);   // 100 ms over, then quiet
+
+    auto limiter = makeLimiter(1);
+    processInBlocks(limiter, buffer);
+
+    const int latency = limiter.getLatencySamples();
+    const float gainSoonAfter = buffer.getSample(0, 4410 + latency + 100) / 0.1f;
+    const float gainLater     = buffer.getSample(0, 4410 + latency + 22050) / 0.1f;
+    REQUIRE(gainSoonAfter < 0.6f);
+    REQUIRE(gainLater == Catch::Approx(1.f).margin(1e-3));
+}
+
+TEST_CASE("TruePeakLimiter benchmark: vs juce::dsp::Limiter", "[.benchmark]") {
+    juce::AudioBuffer<float> noise(2, kBlock), buffer(2, kBlock);
+    juce::Random rng(5);
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < kBlock; ++i)
+            noise.setSample(c, i, 1.5f * (rng.nextFloat() * 2.f - 1.f));
+
+    juce::dsp::Limiter<float> juceLimiter;
+    juceLimiter.prepare({ kSampleRate, static_cast<juce::uint32>(kBlock), 2 });
+    juceLimiter.setThreshold(-1.f);
+    juceLimiter.setRelease(50.f);
+    auto limiter = makeLimiter(2);
+
+    BENCHMARK("juce::dsp::Limiter (sample peak), stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        juceLimiter.process(juce::dsp::ProcessContextReplacing<float>(block));
+        return buffer.getSample(1, kBlock - 1);
+    };
+
+    BENCHMARK("TruePeakLimiter (4x true peak, 1.5 ms lookahead), stereo 512") {
+        buffer.makeCopyOf(noise, true);
+        juce::dsp::AudioBlock<float> block(buffer);
+        limiter.process(block);
+        return buffer.getSample(1, kBlock - 1);
+    };
+}